@@ -29,14 +29,19 @@
 
 #include "B1DetectorConstruction.hh"
 #include "B1ActionInitialization.hh"
+#include "B1AdjointActionInitialization.hh"
+#include "B1EmPhysicsList.hh"
+#include "B1Benchmark.hh"
 
 #ifdef G4MULTITHREADED
 #include "G4MTRunManager.hh"
-#else
-#include "G4RunManager.hh"
 #endif
+#include "G4RunManager.hh"
 
 #include "G4UImanager.hh"
+#include "G4PhysListFactory.hh"
+#include "G4GenericBiasingPhysics.hh"
+#include "G4AdjointSimManager.hh"
 #include "QBBC.hh"
 
 #include "G4VisExecutive.hh"
@@ -44,40 +49,151 @@
 
 #include "Randomize.hh"
 
+#include <sstream>
+
+namespace {
+  void PrintUsage() {
+    G4cerr << " Usage: " << G4endl;
+    G4cerr << " exampleB1 [-p physicsList] [-b] [-s] [-r reportFile] [macro]"
+           << G4endl;
+    G4cerr << " exampleB1 -c list1,list2,... macro" << G4endl;
+    G4cerr << " exampleB1 -a [macro]" << G4endl;
+    G4cerr << "   physicsList: QBBC (default), emminimal, emstandard,"
+           << " emlivermore, empenelope, emoption4," << G4endl;
+    G4cerr << "   or any reference list name such as QBBC_LIV" << G4endl;
+    G4cerr << "   -b: gamma biasing, for /B1/det/forceCollision" << G4endl;
+    G4cerr << "   -s: sequential run manager, for /B1/eff/compute" << G4endl;
+    G4cerr << "   -a: reverse Monte Carlo (emadjoint, sequential),"
+           << " runs started with /adjoint/start_run" << G4endl;
+  }
+
+  // EM-only lists are "em" + B1EmPhysicsList option, the rest are
+  // reference physics lists
+  G4VModularPhysicsList* CreatePhysicsList(const G4String& name)
+  {
+    if (name == "QBBC") return new QBBC;
+    if (name.size() > 2 && name.substr(0,2) == "em"
+        && B1EmPhysicsList::IsKnown(name.substr(2))) {
+      return new B1EmPhysicsList(name.substr(2));
+    }
+    G4PhysListFactory factory;
+    if (factory.IsReferencePhysList(name)) {
+      return factory.GetReferencePhysList(name);
+    }
+    return 0;
+  }
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 int main(int argc,char** argv)
 {
-  // Detect interactive mode (if no arguments) and define UI session
+  // Evaluate arguments
+  //
+  G4String macro;
+  G4String physicsListName = "QBBC";
+  G4String reportFile;
+  G4String compareLists;
+  G4bool gammaBiasing = false;
+  G4bool adjointMode = false;
+  G4bool sequential = false;
+  for ( G4int i=1; i<argc; ++i ) {
+    G4String arg = argv[i];
+    if ( arg == "-p" && i+1 < argc ) physicsListName = argv[++i];
+    else if ( arg == "-r" && i+1 < argc ) reportFile = argv[++i];
+    else if ( arg == "-c" && i+1 < argc ) compareLists = argv[++i];
+    else if ( arg == "-b" ) gammaBiasing = true;
+    else if ( arg == "-a" ) adjointMode = true;
+    else if ( arg == "-s" ) sequential = true;
+    else if ( arg[0] != '-' && macro.empty() ) macro = arg;
+    else {
+      PrintUsage();
+      return 1;
+    }
+  }
+
+  // Reverse Monte Carlo needs the adjoint processes
+  if ( adjointMode ) {
+    if ( ! compareLists.empty() || gammaBiasing ) {
+      PrintUsage();
+      return 1;
+    }
+    physicsListName = "emadjoint";
+  }
+
+  B1Benchmark::Start(physicsListName);
+  B1Benchmark::SetReportFile(reportFile);
+
+  // Comparison mode: run the macro once per physics list
+  //
+  if ( ! compareLists.empty() ) {
+    if ( macro.empty() ) {
+      PrintUsage();
+      return 1;
+    }
+    std::vector<G4String> lists;
+    std::istringstream input(compareLists);
+    std::string name;
+    while ( std::getline(input, name, ',') ) {
+      if ( ! name.empty() ) lists.push_back(name);
+    }
+    return B1Benchmark::Compare(argv[0], lists, macro);
+  }
+
+  // Physics list
+  G4VModularPhysicsList* physicsList = CreatePhysicsList(physicsListName);
+  if ( ! physicsList ) {
+    G4cerr << "Unknown physics list " << physicsListName << G4endl;
+    PrintUsage();
+    return 1;
+  }
+
+  // Gamma processes wrapped so that biasing operators can act on them
+  if ( gammaBiasing ) {
+    G4GenericBiasingPhysics* biasingPhysics = new G4GenericBiasingPhysics();
+    biasingPhysics->Bias("gamma");
+    physicsList->RegisterPhysics(biasingPhysics);
+  }
+
+  // Detect interactive mode (if no macro) and define UI session
   //
   G4UIExecutive* ui = 0;
-  if ( argc == 1 ) {
+  if ( macro.empty() ) {
     ui = new G4UIExecutive(argc, argv);
   }
 
   // Choose the Random engine
   G4Random::setTheEngine(new CLHEP::RanecuEngine);
   
-  // Construct the default run manager
+  // Construct the default run manager; the reverse Monte Carlo of
+  // Geant4 is sequential only
   //
+  G4RunManager* runManager = 0;
 #ifdef G4MULTITHREADED
-  G4MTRunManager* runManager = new G4MTRunManager;
-#else
-  G4RunManager* runManager = new G4RunManager;
+  if ( ! adjointMode && ! sequential ) runManager = new G4MTRunManager;
 #endif
+  if ( ! runManager ) runManager = new G4RunManager;
 
   // Set mandatory initialization classes
   //
   // Detector construction
-  runManager->SetUserInitialization(new B1DetectorConstruction());
+  B1DetectorConstruction* detector = new B1DetectorConstruction();
+  detector->SetGammaBiasing(gammaBiasing);
+  runManager->SetUserInitialization(detector);
 
   // Physics list
-  G4VModularPhysicsList* physicsList = new QBBC;
   physicsList->SetVerboseLevel(1);
   runManager->SetUserInitialization(physicsList);
     
   // User action initialization
-  runManager->SetUserInitialization(new B1ActionInitialization());
+  if ( adjointMode ) {
+    // creates the /adjoint/ commands
+    G4AdjointSimManager::GetInstance();
+    runManager->SetUserInitialization(new B1AdjointActionInitialization());
+  }
+  else {
+    runManager->SetUserInitialization(new B1ActionInitialization());
+  }
   
   // Initialize visualization
   //
@@ -94,8 +210,7 @@ int main(int argc,char** argv)
   if ( ! ui ) { 
     // batch mode
     G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    UImanager->ApplyCommand(command+fileName);
+    UImanager->ApplyCommand(command+macro);
   }
   else { 
     // interactive mode
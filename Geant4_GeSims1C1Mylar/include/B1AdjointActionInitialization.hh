@@ -0,0 +1,53 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointActionInitialization.hh
+/// \brief Definition of the B1AdjointActionInitialization class
+
+#ifndef B1AdjointActionInitialization_h
+#define B1AdjointActionInitialization_h 1
+
+#include "G4VUserActionInitialization.hh"
+
+/// Action initialization of the reverse Monte Carlo mode (exampleB1 -a).
+///
+/// The forward primary generator is kept, as the run manager requires
+/// one, but the runs are started with /adjoint/start_run and the
+/// primaries come from the G4AdjointSimManager. The run and event
+/// actions are also registered as its adjoint actions.
+
+class B1AdjointActionInitialization : public G4VUserActionInitialization
+{
+  public:
+    B1AdjointActionInitialization();
+    virtual ~B1AdjointActionInitialization();
+
+    virtual void Build() const;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
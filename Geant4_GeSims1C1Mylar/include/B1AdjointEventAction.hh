@@ -0,0 +1,65 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointEventAction.hh
+/// \brief Definition of the B1AdjointEventAction class
+
+#ifndef B1AdjointEventAction_h
+#define B1AdjointEventAction_h 1
+
+#include "G4UserEventAction.hh"
+#include "globals.hh"
+
+class B1AdjointRunAction;
+
+/// Event action of the reverse Monte Carlo mode.
+///
+/// An adjoint event is an adjoint gamma started outward from the Ge
+/// surface, tracked back to the external source, and the forward gamma
+/// started at the same point, inward, with the same energy. When the
+/// adjoint gamma reaches the source, the event passes the source energy
+/// (at the end of the adjoint track), the Ge deposit of the forward part
+/// and the adjoint weight to the run action.
+
+class B1AdjointEventAction : public G4UserEventAction
+{
+  public:
+    B1AdjointEventAction(B1AdjointRunAction* runAction);
+    virtual ~B1AdjointEventAction();
+
+    virtual void BeginOfEventAction(const G4Event* event);
+    virtual void EndOfEventAction(const G4Event* event);
+
+    void AddEdep1(G4double edep) { fEdep1 += edep; }
+
+  private:
+    B1AdjointRunAction* fRunAction;
+    G4double fEdep1;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
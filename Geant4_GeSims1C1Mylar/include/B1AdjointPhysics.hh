@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointPhysics.hh
+/// \brief Definition of the B1AdjointPhysics class
+
+#ifndef B1AdjointPhysics_h
+#define B1AdjointPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+/// Forward and adjoint EM physics of gammas and electrons for reverse
+/// Monte Carlo (exampleB1 -a), laid out as in the Geant4 ReverseMC01
+/// example.
+///
+/// The forward processes are the standard ones, without energy-loss
+/// fluctuations, and are registered with the G4AdjointCSManager, which
+/// builds the adjoint cross sections from them. Adjoint gammas undergo
+/// inverse Compton scattering and are produced by adjoint electrons
+/// through inverse photoelectric effect and Compton scattering; adjoint
+/// electrons gain energy continuously and undergo inverse ionisation
+/// and bremsstrahlung. Pair production and fluorescence have no adjoint
+/// counterpart and are left out, which limits the mode to sources below
+/// about 3 MeV.
+
+class B1AdjointPhysics : public G4VPhysicsConstructor
+{
+  public:
+    B1AdjointPhysics(G4int verbose = 1);
+    virtual ~B1AdjointPhysics();
+
+    virtual void ConstructParticle();
+    virtual void ConstructProcess();
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,106 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointRunAction.hh
+/// \brief Definition of the B1AdjointRunAction class
+
+#ifndef B1AdjointRunAction_h
+#define B1AdjointRunAction_h 1
+
+#include "G4UserRunAction.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class B1AdjointRunActionMessenger;
+
+/// Run action of the reverse Monte Carlo mode (exampleB1 -a).
+///
+/// The adjoint gammas start on the outer surface of the Ge crystal, with
+/// energies spread over the /adjoint/ energy range, and are tracked back
+/// to the external source surface. The weight w of an adjoint gamma
+/// reaching the source, over the number N of adjoint events, is the
+/// response of the Ge to a unit omnidirectional fluence of gammas of the
+/// source energy, per unit energy. Folding with any source spectrum and
+/// geometry on that surface therefore needs a single adjoint run:
+///  - "AdjointTotal" and "AdjointFullEnergy" histograms: response per unit
+///    line fluence versus source energy, for any deposit and for a full
+///    deposit of the source energy (full-energy peak);
+///  - "AdjointResponse" H2: w/N by source energy and Ge deposit, from
+///    which any pulse-height spectrum follows;
+///  - "Adjoint" ntuple: source energy, Ge deposit, w/N, position and
+///    direction on the source surface, for offline folding with a spatial
+///    or angular source distribution.
+/// For the lines given with /B1/adjoint/line it also prints the total
+/// and full-energy responses, and with /B1/adjoint/sourceRadius set the
+/// efficiencies per emitted gamma of a spherical source emitting
+/// isotropically inward (fluence 1/(pi R^2) per gamma).
+
+class B1AdjointRunAction : public G4UserRunAction
+{
+  public:
+    B1AdjointRunAction();
+    virtual ~B1AdjointRunAction();
+
+    virtual void BeginOfRunAction(const G4Run*);
+    virtual void   EndOfRunAction(const G4Run*);
+
+    void AddLine(G4double energy) { fLines.push_back(energy); }
+    void ClearLines() { fLines.clear(); }
+    void SetWindow(G4double window) { fWindow = window; }
+    void SetSourceRadius(G4double radius) { fSourceRadius = radius; }
+
+    // an adjoint gamma of the event reached the external source
+    void AddSourceHit(G4double sourceEnergy, G4double edep1, G4double weight,
+                      const G4ThreeVector& position,
+                      const G4ThreeVector& direction);
+
+  private:
+    void PrintLines() const;
+
+    std::vector<G4double> fLines;
+    G4double fWindow;        // of the source energy and of the full deposit
+    G4double fSourceRadius;  // or 0
+
+    G4double fNofEvents;     // adjoint events of the run
+    G4double fNofSourceHits;
+    // per line, sums of w and w^2, any deposit and full energy
+    std::vector<G4double> fTotal;
+    std::vector<G4double> fTotal2;
+    std::vector<G4double> fPeak;
+    std::vector<G4double> fPeak2;
+
+    G4int fH1;               // total, followed by the full energy
+    G4int fH2;
+    G4int fNtuple;
+
+    B1AdjointRunActionMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
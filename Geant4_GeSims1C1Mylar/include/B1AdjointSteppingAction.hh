@@ -0,0 +1,58 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointSteppingAction.hh
+/// \brief Definition of the B1AdjointSteppingAction class
+
+#ifndef B1AdjointSteppingAction_h
+#define B1AdjointSteppingAction_h 1
+
+#include "G4UserSteppingAction.hh"
+#include "globals.hh"
+
+class B1AdjointEventAction;
+class G4LogicalVolume;
+
+/// Stepping action of the reverse Monte Carlo mode: collects the energy
+/// deposited in the Ge crystal by the forward particles. The adjoint
+/// particles, whose steps gain energy, are ignored.
+
+class B1AdjointSteppingAction : public G4UserSteppingAction
+{
+  public:
+    B1AdjointSteppingAction(B1AdjointEventAction* eventAction);
+    virtual ~B1AdjointSteppingAction();
+
+    virtual void UserSteppingAction(const G4Step*);
+
+  private:
+    B1AdjointEventAction* fEventAction;
+    G4LogicalVolume* fScoringVolume1;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
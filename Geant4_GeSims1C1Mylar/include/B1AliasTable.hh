@@ -0,0 +1,66 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AliasTable.hh
+/// \brief Definition of the B1AliasTable class
+
+#ifndef B1AliasTable_h
+#define B1AliasTable_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Walker alias table for sampling a discrete distribution in O(1).
+///
+/// Build() takes non-negative weights (they need not be normalised)
+/// and Sample() returns an index with probability weight/sum, using a
+/// single uniform random number per call.
+
+class B1AliasTable
+{
+  public:
+    B1AliasTable();
+    ~B1AliasTable();
+
+    void   Build(const std::vector<G4double>& weights);
+    void   Clear();
+
+    G4int  Sample() const;
+    G4int  Sample(G4double rand) const;
+
+    size_t   GetSize() const { return fCut.size(); }
+    G4double GetProbability(G4int i) const { return fProb[i]; }
+
+  private:
+    std::vector<G4double> fCut;
+    std::vector<G4int>    fAlias;
+    std::vector<G4double> fProb;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AnalyticSource.hh
+/// \brief Definition of the B1AnalyticSource class
+
+#ifndef B1AnalyticSource_h
+#define B1AnalyticSource_h 1
+
+#include "G4VPrimaryGenerator.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class G4Event;
+class G4ParticleDefinition;
+class B1AnalyticSourceMessenger;
+
+/// Minimal primary generator for the source geometries used here.
+///
+/// Point, disk, cylinder and box volume sources with isotropic or cone
+/// emission and a mono energy. Every quantity is sampled directly
+/// (inverse transform), without rejection loops or volume confinement,
+/// so the cost per event is a handful of random numbers. The source frame
+/// has its z axis along /B1/gun/axis; disks lie in the local xy plane.
+/// Configured with the /B1/gun/ commands.
+
+class B1AnalyticSource : public G4VPrimaryGenerator
+{
+  public:
+    enum Shape   { kPoint, kDisk, kCylinder, kBox };
+    enum Angular { kIsotropic, kCone };
+
+    B1AnalyticSource();
+    virtual ~B1AnalyticSource();
+
+    virtual void GeneratePrimaryVertex(G4Event*);
+
+    void SetParticleDefinition(G4ParticleDefinition* particle)
+      { fParticle = particle; }
+    void SetEnergy(G4double energy)              { fEnergy = energy; }
+    void SetShape(const G4String& shape);
+    void SetCentre(const G4ThreeVector& centre)  { fCentre = centre; }
+    void SetAxis(const G4ThreeVector& axis)      { fAxis = axis.unit(); }
+    void SetRadius(G4double radius)              { fRadius = radius; }
+    void SetHalfX(G4double halfX)                { fHalfX = halfX; }
+    void SetHalfY(G4double halfY)                { fHalfY = halfY; }
+    void SetHalfZ(G4double halfZ)                { fHalfZ = halfZ; }
+    void SetAngular(const G4String& angular);
+    void SetDirection(const G4ThreeVector& dir)  { fDirection = dir.unit(); }
+    void SetConeAngle(G4double angle);
+
+    G4ParticleDefinition* GetParticleDefinition() const { return fParticle; }
+    G4double GetEnergy() const { return fEnergy; }
+    Angular  GetAngular() const { return fAngular; }
+
+    G4ThreeVector SamplePosition() const;
+    G4ThreeVector SampleDirection() const;
+    // path length from a point of the source volume to its surface along
+    // a direction, 0 for point and disk sources
+    G4double DistanceToOut(const G4ThreeVector& position,
+                           const G4ThreeVector& direction) const;
+    // longest path across the source volume
+    G4double GetMaxPathLength() const;
+
+  private:
+
+    G4ParticleDefinition* fParticle;
+    G4double      fEnergy;
+    Shape         fShape;
+    G4ThreeVector fCentre;
+    G4ThreeVector fAxis;
+    G4double      fRadius;
+    G4double      fHalfX;
+    G4double      fHalfY;
+    G4double      fHalfZ;
+    Angular       fAngular;
+    G4ThreeVector fDirection;
+    G4double      fCosCone;
+
+    B1AnalyticSourceMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
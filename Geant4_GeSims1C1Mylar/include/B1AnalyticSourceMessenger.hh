@@ -0,0 +1,73 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AnalyticSourceMessenger.hh
+/// \brief Definition of the B1AnalyticSourceMessenger class
+
+#ifndef B1AnalyticSourceMessenger_h
+#define B1AnalyticSourceMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1AnalyticSource;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWith3Vector;
+class G4UIcmdWith3VectorAndUnit;
+
+/// Messenger for the B1AnalyticSource, commands in /B1/gun/.
+
+class B1AnalyticSourceMessenger : public G4UImessenger
+{
+  public:
+    B1AnalyticSourceMessenger(B1AnalyticSource* source);
+    virtual ~B1AnalyticSourceMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1AnalyticSource* fSource;
+
+    G4UIdirectory*             fGunDir;
+    G4UIcmdWithAString*        fParticleCmd;
+    G4UIcmdWithADoubleAndUnit* fEnergyCmd;
+    G4UIcmdWithAString*        fShapeCmd;
+    G4UIcmdWith3VectorAndUnit* fCentreCmd;
+    G4UIcmdWith3Vector*        fAxisCmd;
+    G4UIcmdWithADoubleAndUnit* fRadiusCmd;
+    G4UIcmdWithADoubleAndUnit* fHalfXCmd;
+    G4UIcmdWithADoubleAndUnit* fHalfYCmd;
+    G4UIcmdWithADoubleAndUnit* fHalfZCmd;
+    G4UIcmdWithAString*        fAngularCmd;
+    G4UIcmdWith3Vector*        fDirectionCmd;
+    G4UIcmdWithADoubleAndUnit* fConeAngleCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
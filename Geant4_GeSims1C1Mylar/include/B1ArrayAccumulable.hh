@@ -0,0 +1,66 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ArrayAccumulable.hh
+/// \brief Definition of the B1ArrayAccumulable class
+
+#ifndef B1ArrayAccumulable_h
+#define B1ArrayAccumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Accumulable holding a growable array of sums.
+///
+/// Used for counters whose length is only known once the source or
+/// geometry has been configured (e.g. one bin per gamma line). Workers
+/// may end up with arrays of different length; Merge() grows to the
+/// longest one.
+
+class B1ArrayAccumulable : public G4VAccumulable
+{
+  public:
+    B1ArrayAccumulable(const G4String& name = "");
+    virtual ~B1ArrayAccumulable();
+
+    virtual void Merge(const G4VAccumulable& other);
+    virtual void Reset();
+
+    void Add(G4int i, G4double value);
+
+    size_t   GetSize() const { return fValues.size(); }
+    G4double GetValue(G4int i) const
+      { return (i < G4int(fValues.size())) ? fValues[i] : 0.; }
+
+  private:
+    std::vector<G4double> fValues;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1Benchmark.hh
+/// \brief Definition of the B1Benchmark class
+
+#ifndef B1Benchmark_h
+#define B1Benchmark_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Throughput and accuracy report used to compare physics lists.
+///
+/// With exampleB1 -r <file>, the master appends one line per run:
+///   physicsList initTime(s) events runTime(s) events/s maxRSS(MB)
+///   fepEfficiency error
+/// where the initialisation time runs from the start of the program to
+/// the start of the first run (so it includes building the physics
+/// tables), and the full-energy-peak efficiency is the fraction of
+/// events depositing all the primary energy in Ge.
+///
+/// With exampleB1 -c list1,list2,... macro, Compare() runs the macro
+/// once per physics list in a child process and prints the reports side
+/// by side, with the efficiency difference to the first list.
+
+class B1Benchmark
+{
+  public:
+    // to be called first in main()
+    static void Start(const G4String& physicsListName);
+    static void SetReportFile(const G4String& fileName);
+    static const G4String& GetReportFile();
+
+    // called from the master run action
+    static void BeginOfRun();
+    static void EndOfRun(G4int nofEvents, G4double nofFullEnergyEvents);
+    // wall-clock time of the last run, in s
+    static G4double GetRunTime();
+
+    static G4int Compare(const G4String& program,
+                         const std::vector<G4String>& physicsLists,
+                         const G4String& macro);
+
+  private:
+    static G4double GetMaxResidentMemory();   // in MB
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,109 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ChargeCollectionMap.hh
+/// \brief Definition of the B1ChargeCollectionMap class
+
+#ifndef B1ChargeCollectionMap_h
+#define B1ChargeCollectionMap_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <algorithm>
+#include <vector>
+
+class G4Step;
+class B1ChargeCollectionMapMessenger;
+
+/// Charge collection efficiency of the Ge crystal on an (r, z) grid.
+///
+/// There is one instance per thread, like the analysis manager. The map
+/// is read from a text file and interpolated bilinearly at the midpoint
+/// of each Ge step, in the crystal frame; the crystal being a cylinder,
+/// r and z are enough. Outside the grid the nearest edge value is used.
+///
+/// File format, '#' starting a comment:
+///   nr rmin rmax nz zmin zmax      (lengths in mm)
+///   followed by nr*nz efficiencies, z varying fastest.
+
+class B1ChargeCollectionMap
+{
+  public:
+    static B1ChargeCollectionMap* Instance();
+    ~B1ChargeCollectionMap();
+
+    G4bool Load(const G4String& fileName);
+    void SetActive(G4bool active);
+
+    G4bool IsActive() const { return fActive; }
+
+    // efficiency at the midpoint of a Ge step
+    G4double GetEfficiency(const G4Step* step) const;
+    // efficiency at a point in the crystal frame
+    inline G4double GetEfficiency(const G4ThreeVector& local) const;
+
+  private:
+    B1ChargeCollectionMap();
+
+    static G4ThreadLocal B1ChargeCollectionMap* fInstance;
+
+    G4bool   fActive;
+    G4String fFileName;
+
+    G4int    fNofR, fNofZ;
+    G4double fRMin, fZMin;
+    G4double fInvDR, fInvDZ;   // inverse grid spacings
+    // row-major in r, so the four corners of a cell are two pairs of
+    // neighbouring values
+    std::vector<G4double> fValues;
+
+    B1ChargeCollectionMapMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4double
+B1ChargeCollectionMap::GetEfficiency(const G4ThreeVector& local) const
+{
+  // fractional cell coordinates, clamped to the grid
+  G4double u = (local.perp() - fRMin)*fInvDR;
+  G4double v = (local.z() - fZMin)*fInvDZ;
+  u = std::min(std::max(u, 0.), G4double(fNofR-1));
+  v = std::min(std::max(v, 0.), G4double(fNofZ-1));
+
+  G4int ir = std::min(G4int(u), fNofR-2);
+  G4int iz = std::min(G4int(v), fNofZ-2);
+  u -= ir;
+  v -= iz;
+
+  const G4double* cell = &fValues[ir*fNofZ + iz];
+  G4double low  = cell[0] + v*(cell[1] - cell[0]);
+  G4double high = cell[fNofZ] + v*(cell[fNofZ+1] - cell[fNofZ]);
+  return low + u*(high - low);
+}
+
+#endif
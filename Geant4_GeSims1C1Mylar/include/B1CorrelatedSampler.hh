@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1CorrelatedSampler.hh
+/// \brief Definition of the B1CorrelatedSampler class
+
+#ifndef B1CorrelatedSampler_h
+#define B1CorrelatedSampler_h 1
+
+#include "globals.hh"
+
+#include <atomic>
+#include <vector>
+
+class B1CorrelatedSamplerMessenger;
+
+/// Correlated sampling of two geometry variants, e.g. two carbon window
+/// thicknesses (/B1/det/windowThickness).
+///
+/// A single instance per process. When active, the random engine of the
+/// thread is reseeded before the primaries of every event from the base
+/// seed and the event number only, so the same event of two runs has the
+/// same source vertex and the same random stream, whatever the thread.
+/// A reference run stores, per event, whether it deposited energy in Ge
+/// and whether it was a full-energy-peak event. A variant run of the
+/// same number of events compares event by event with the reference:
+/// at the end of the run the master prints both efficiencies, their
+/// difference with the error of the paired differences, and the error
+/// of the same difference from independent runs. The two runs only
+/// differ where the geometry change altered the history, so the paired
+/// error is much smaller. Commands are handled by the master only.
+
+class B1CorrelatedSampler
+{
+  public:
+    enum Mode { kOff, kReference, kVariant };
+
+    static B1CorrelatedSampler* Instance();
+    ~B1CorrelatedSampler();
+
+    void SetMode(Mode mode)                 { fMode = mode; }
+    void SetSeed(G4long seed)               { fSeed = seed; }
+
+    G4bool IsActive() const                 { return fMode != kOff; }
+
+    // master or sequential, before the event loop
+    void BeginOfRun();
+    // event loop threads, before generating the primaries
+    void SeedEvent(G4int eventID) const;
+    // event loop threads, with the event outcome
+    void EndOfEvent(G4int eventID, G4bool geEvent, G4bool fullEnergy);
+    // master or sequential
+    void Print() const;
+
+  private:
+    enum { kGe, kFullEnergy, kNofScores };
+
+    B1CorrelatedSampler();
+
+    static B1CorrelatedSampler* fInstance;
+
+    Mode   fMode;
+    G4long fSeed;
+
+    // outcome bits of the reference events, by event number; each event
+    // is written by one thread only
+    std::vector<unsigned char> fReference;
+
+    // paired events: reference, variant and both, per score
+    std::atomic<G4long> fNofPairs;
+    std::atomic<G4long> fNofUnpaired;
+    std::atomic<G4long> fCounts[kNofScores][3];
+
+    B1CorrelatedSamplerMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
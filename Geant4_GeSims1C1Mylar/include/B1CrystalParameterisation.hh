@@ -0,0 +1,60 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1CrystalParameterisation.hh
+/// \brief Definition of the B1CrystalParameterisation class
+
+#ifndef B1CrystalParameterisation_h
+#define B1CrystalParameterisation_h 1
+
+#include "G4VPVParameterisation.hh"
+#include "globals.hh"
+
+class G4VPhysicalVolume;
+
+/// Places identical Ge crystals on a rectangular grid in the x-y plane,
+/// centred on the mother volume and filled row by row; the copy number
+/// is the crystal index.
+
+class B1CrystalParameterisation : public G4VPVParameterisation
+{
+  public:
+    B1CrystalParameterisation(G4int nofCrystals, G4int nofColumns,
+                              G4double pitch);
+    virtual ~B1CrystalParameterisation();
+
+    virtual void ComputeTransformation(const G4int copyNo,
+                                       G4VPhysicalVolume* physVol) const;
+
+  private:
+    G4int    fNofColumns;
+    G4int    fNofRows;
+    G4double fPitch;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -33,10 +33,33 @@
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
 
+#include <vector>
+
 class G4VPhysicalVolume;
 class G4LogicalVolume;
+class G4Tubs;
+class B1DetectorMessenger;
 
 /// Detector construction class to define materials and geometry.
+///
+/// By default a single Ge crystal (Shape1) is built. With
+/// /B1/det/nofCrystals N > 1, N identical crystals are placed on a grid
+/// by a parameterisation, the copy number being the crystal index.
+///
+/// Volumes named with /B1/det/forceCollision get a forced-collision
+/// biasing operator for gammas, one per volume and per thread: every
+/// gamma entering the volume is split into a copy crossing it without
+/// interacting and a copy forced to interact inside it, their weights
+/// being the probabilities of both outcomes. It requires the gamma
+/// processes to be wrapped by the generic biasing physics (exampleB1 -b).
+/// The two copies are the outcomes of a split of the event history,
+/// scored as weighted histories (see B1EventAction).
+///
+/// The carbon window thickness (/B1/det/windowThickness) can also change
+/// between runs: its solid is resized in place, keeping the face toward
+/// the source at z = 0, so that geometry variants can be compared run
+/// after run. The change is announced with /run/geometryModified, which
+/// is broadcast to the worker threads before their next run.
 
 class B1DetectorConstruction : public G4VUserDetectorConstruction
 {
@@ -45,15 +68,45 @@ class B1DetectorConstruction : public G4VUserDetectorConstruction
     virtual ~B1DetectorConstruction();
 
     virtual G4VPhysicalVolume* Construct();
+    virtual void ConstructSDandField();
     
     G4LogicalVolume* GetScoringVolume() const { return fScoringVolume; }
     G4LogicalVolume* GetScoringVolume1() const { return fScoringVolume1; }
     G4LogicalVolume* GetScoringVolume2() const { return fScoringVolume2; }
 
+    void SetNumberOfCrystals(G4int nofCrystals);
+    void SetNumberOfColumns(G4int nofColumns) { fNofColumns = nofColumns; }
+    void SetCrystalPitch(G4double pitch)      { fCrystalPitch = pitch; }
+    void SetGammaBiasing(G4bool value)        { fGammaBiasing = value; }
+    void SetWindowThickness(G4double thickness);
+    void AddForcedCollisionVolume(const G4String& name)
+           { fForcedVolumes.push_back(name); }
+
+    G4int GetNumberOfCrystals() const { return fNofCrystals; }
+    G4bool IsForcingCollisions() const
+             { return fGammaBiasing && !fForcedVolumes.empty(); }
+    G4double GetWindowThickness() const { return fWindowThickness; }
+
+    static const G4int kMaxCrystals = 50;
+    static const G4double kMaxWindowThickness;
+
   protected:
     G4LogicalVolume*  fScoringVolume;
     G4LogicalVolume*  fScoringVolume1;
     G4LogicalVolume*  fScoringVolume2;
+
+    G4int    fNofCrystals;
+    G4int    fNofColumns;
+    G4double fCrystalPitch;
+
+    G4double fWindowThickness;
+    G4Tubs*  fWindowSolid;
+    G4VPhysicalVolume* fWindowPlacement;
+
+    G4bool   fGammaBiasing;     // gamma processes wrapped for biasing
+    std::vector<G4String> fForcedVolumes;
+
+    B1DetectorMessenger* fMessenger;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,161 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EfficiencyEngine.hh
+/// \brief Definition of the B1EfficiencyEngine class
+
+#ifndef B1EfficiencyEngine_h
+#define B1EfficiencyEngine_h 1
+
+#include "G4AffineTransform.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class B1EfficiencyEngineMessenger;
+class B1AnalyticSource;
+class G4VSolid;
+class G4Material;
+class G4LogicalVolume;
+
+/// Semi-analytic Ge efficiency of the analytic source, in seconds
+/// instead of a Monte Carlo run.
+///
+/// The geometry is taken as built by B1DetectorConstruction: the placed
+/// daughters of the envelope (Ge crystal, carbon window, Mylar) and the
+/// envelope air, each with the gamma attenuation coefficient of its
+/// material (photoelectric, Compton, Rayleigh and pair cross sections of
+/// the physics list models). For each source point, drawn like the
+/// /B1/gun/ primaries, rays are cast uniformly in the cone around the
+/// crystal and summed as
+///   eps_total = < Omega_cone/4pi * exp(-mu.l before Ge) * (1 - exp(-mu_Ge L)) >
+/// the probability of a first interaction in Ge, optionally attenuated
+/// by a sample matrix filling the source volume. The full-energy-peak
+/// efficiency is eps_total times a peak-to-total ratio: the photoelectric
+/// fraction of the Ge attenuation by default (no escape, no Compton
+/// absorption, a lower bound), or the ratio printed by the cross-check
+/// of a Monte Carlo run with the same source.
+///
+/// The source points are shared among threads of their own, which only
+/// call thread-safe solid methods. There is one instance per process,
+/// driven by the master; the source comes from the primary generator
+/// action, so it needs a sequential run manager (exampleB1 -s).
+/// Commands are in /B1/eff/.
+
+class B1EfficiencyEngine
+{
+  public:
+    static B1EfficiencyEngine* Instance();
+    ~B1EfficiencyEngine();
+
+    void AddEnergy(G4double energy)         { fEnergies.push_back(energy); }
+    void ClearEnergies()                    { fEnergies.clear(); }
+    void SetNumberOfPoints(G4int value)     { fNofPoints = value; }
+    void SetNumberOfRays(G4int value)       { fNofRays = value; }
+    void SetNumberOfThreads(G4int value)    { fNofThreads = value; }
+    void SetSampleMaterial(const G4String& name);
+    void SetPeakToTotal(G4double value)     { fPeakToTotal = value; }
+
+    // computes and prints the efficiencies at each energy
+    void Compute();
+    // compares a Monte Carlo run of the analytic source (master or
+    // sequential) to the last estimate at its energy
+    void CrossCheck(G4double energy, G4int nofEvents,
+                    G4double nofGeEvents, G4double nofFullEnergyEvents) const;
+
+  private:
+    // a placed volume, crossed by the rays
+    struct Volume
+    {
+      const G4VSolid*   solid;
+      G4AffineTransform toLocal;
+      const G4Material* material;
+      G4bool            ge;
+      G4double          mu;      // at the current energy
+    };
+    // part of a ray inside a volume
+    struct Segment
+    {
+      G4double start;
+      G4double end;
+      const Volume* volume;
+    };
+    // estimate at one energy, with standard errors over the points
+    struct Result
+    {
+      G4double energy;
+      G4double solidAngle;
+      G4double total;
+      G4double totalError;
+      G4double peakToTotal;
+    };
+
+    B1EfficiencyEngine();
+
+    G4bool BuildVolumes();
+    G4double Attenuation(const G4Material* material, G4double energy,
+                         G4double* photoFraction = 0) const;
+    // sums over the points first, first+step, ...: solid angle,
+    // efficiency and its square
+    void Trace(size_t first, size_t step, G4long seed,
+               G4double* sums) const;
+    // probability of a first interaction in Ge along one ray,
+    // and whether it hits the Ge
+    G4double CastRay(const G4ThreeVector& point,
+                     const G4ThreeVector& direction, G4bool& hit,
+                     std::vector<Segment>& segments) const;
+
+    static B1EfficiencyEngine* fInstance;
+
+    std::vector<G4double> fEnergies;
+    G4int    fNofPoints;
+    G4int    fNofRays;
+    G4int    fNofThreads;
+    G4String fSampleMaterialName;
+    G4double fPeakToTotal;    // 0 for the photoelectric fraction
+
+    // geometry and source of the current computation
+    std::vector<Volume>        fVolumes;
+    const G4VSolid*            fEnvelope;
+    G4AffineTransform          fEnvelopeToLocal;
+    const G4Material*          fAir;
+    G4double                   fMuAir;
+    const G4Material*          fSampleMaterial;
+    G4double                   fMuSample;
+    G4ThreeVector              fGeCentre;   // bounding sphere of the Ge
+    G4double                   fGeRadius;
+    const B1AnalyticSource*    fSource;
+    std::vector<G4ThreeVector> fPoints;
+
+    std::vector<Result> fResults;
+
+    B1EfficiencyEngineMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,70 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EfficiencyEngineMessenger.hh
+/// \brief Definition of the B1EfficiencyEngineMessenger class
+
+#ifndef B1EfficiencyEngineMessenger_h
+#define B1EfficiencyEngineMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1EfficiencyEngine;
+class G4UIdirectory;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIcmdWithoutParameter;
+
+/// Messenger for the B1EfficiencyEngine, commands in /B1/eff/.
+
+class B1EfficiencyEngineMessenger : public G4UImessenger
+{
+  public:
+    B1EfficiencyEngineMessenger(B1EfficiencyEngine* engine);
+    virtual ~B1EfficiencyEngineMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1EfficiencyEngine* fEngine;
+
+    G4UIdirectory*             fEffDir;
+    G4UIcmdWithADoubleAndUnit* fEnergyCmd;
+    G4UIcmdWithoutParameter*   fClearEnergiesCmd;
+    G4UIcmdWithAnInteger*      fPointsCmd;
+    G4UIcmdWithAnInteger*      fRaysCmd;
+    G4UIcmdWithAnInteger*      fThreadsCmd;
+    G4UIcmdWithAString*        fSampleMaterialCmd;
+    G4UIcmdWithADouble*        fPeakToTotalCmd;
+    G4UIcmdWithoutParameter*   fComputeCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,59 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EmPhysicsList.hh
+/// \brief Definition of the B1EmPhysicsList class
+
+#ifndef B1EmPhysicsList_h
+#define B1EmPhysicsList_h 1
+
+#include "G4VModularPhysicsList.hh"
+#include "globals.hh"
+
+/// Electromagnetic-only physics list.
+///
+/// Our sources are gammas below a few MeV, for which the hadronic and
+/// neutron physics of QBBC only cost initialisation time and memory.
+/// This list registers a single EM constructor, chosen by name:
+/// "standard" (G4EmStandardPhysics), "livermore", "penelope",
+/// "option4" or "minimal" (B1GammaElectronPhysics: gammas, electrons and
+/// positrons only, the lightest choice for our photon sources).
+/// "adjoint" (B1AdjointPhysics) adds the adjoint particles and processes
+/// of the reverse Monte Carlo mode.
+
+class B1EmPhysicsList : public G4VModularPhysicsList
+{
+  public:
+    B1EmPhysicsList(const G4String& emName = "standard");
+    virtual ~B1EmPhysicsList();
+
+    // true if the name is one of the EM options above
+    static G4bool IsKnown(const G4String& emName);
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
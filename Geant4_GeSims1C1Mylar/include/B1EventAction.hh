@@ -30,13 +30,53 @@
 #ifndef B1EventAction_h
 #define B1EventAction_h 1
 
+#include "B1RunAction.hh"
+
 #include "G4UserEventAction.hh"
+#include "G4TrackVector.hh"
 #include "globals.hh"
 
-class B1RunAction;
+#include <vector>
+
+class B1EventInformation;
+class G4Track;
 
 /// Event action class
 ///
+/// The Ge deposit is the collected one when a charge collection map is
+/// loaded (B1ChargeCollectionMap), and so are the full-energy-peak and
+/// line scores: a deposit losing charge in the dead or transition layer
+/// falls out of the collected-charge peak, as in a measured spectrum.
+///
+/// When the event carries a B1EventInformation (line or cascade source),
+/// the Ge deposit is also split by primary gamma so that full-energy
+/// absorption, summing-out and summing-in can be counted per line.
+///
+/// With a crystal array, the Ge deposit is also kept per crystal in a
+/// flat array indexed by copy number, and with the virtual segmentation
+/// on, per segment.
+///
+/// With importance sampling, forced collision (B1DetectorConstruction)
+/// or weighted primaries (phase-space replay), the event history is kept
+/// as a tree of branches. The primaries open the root, owned by the
+/// first one. When a gamma is split (importance sampling copies, or the
+/// free-flight and forced-interaction copies of a forced collision), a
+/// split of its branch is opened, with one branch for its continuation
+/// and one per copy, each owned by that gamma. The deposit of the
+/// splitting step and the secondaries made before the split stay in the
+/// split branch, later ones follow their parent. Deposits are summed per
+/// branch and volume.
+///
+/// A history takes one outcome of every split on its way: its deposits
+/// are those of the branches taken, its weight the one of the root times
+/// the ratio of the weight of each outcome to the one of the gamma
+/// before its split. The weight of a branch is the final one of its
+/// owner (0 when killed by roulette), or the one before it split. Each
+/// history fills the Edep histograms once with its weight, and enters
+/// the run statistics and the full-energy-peak counts weighted; the
+/// other per-event scores are not filled. Importance sampling only plays
+/// for the branch owners of events with a single primary; the primaries
+/// of an event share the weight of the first one.
 
 class B1EventAction : public G4UserEventAction
 {
@@ -50,12 +90,90 @@ class B1EventAction : public G4UserEventAction
     void AddEdep(G4double edep) { fEdep += edep; }
     void AddEdep1(G4double edep1) { fEdep1 += edep1; }
     void AddEdep4(G4double edep4) { fEdep4 += edep4; }
+    G4bool IsForcingCollisions() const { return fForcing; }
+    G4bool IsSampling() const { return fSampling; }
+
+    // history tree: importance sampling, forced collision or weighted
+    // primary; volume is a B1RunAction volume index
+    G4bool IsBranching() const { return fBranching; }
+    G4bool OwnsBranch(G4int trackID) const;
+    void AddBranchEdep(G4int volume, G4int trackID, G4double edep)
+           {
+             fBranchEdep[fTrackBranch[trackID]*fNofVolumes + volume] += edep;
+           }
+    // the secondaries from firstCopy on are copies of the split track,
+    // whose weight before the split was weight
+    void SplitBranch(const G4Track* track, G4double weight,
+                     G4TrackVector* secondaries, size_t firstCopy);
+    void BeginOfTrack(const G4Track* track);
+    void EndOfTrack(const G4Track* track);
+    void AddCrystalEdep(G4int copyNo, G4double edep)
+           { fCrystalEdep[copyNo] += edep; }
+    void AddSegmentEdep(G4int segment, G4double edep)
+           {
+             if (fSegmentEdep[segment] == 0.) fSegmentsHit.push_back(segment);
+             fSegmentEdep[segment] += edep;
+           }
+
+    // attribution of Ge deposits to primaries (cascade sources)
+    G4bool IsSplittingByPrimary() const { return fNofPrimaries > 1; }
+    void   RecordTrack(G4int trackID, G4int parentID);
+    void   AddPrimaryEdep1(G4int trackID, G4double edep1)
+             { fPrimaryEdep1[fTrackPrimary[trackID]] += edep1; }
 
   private:
+    struct Branch
+    {
+      G4int    split;     // the one it is an outcome of, -1 for the root
+      G4int    owner;     // track ID, 0 for a copy not yet tracked
+      G4double weight;
+    };
+    struct Split
+    {
+      G4int    branch;    // of the split gamma
+      G4double weight;    // of the gamma before the split
+    };
+    struct History
+    {
+      G4double edep[B1RunAction::kNofVolumes];
+      G4double weight;
+    };
+
+    G4int OpenBranch(G4int split, G4int owner, G4double weight);
+    void AddHistories(G4int branch, std::vector<History>& histories) const;
+    void ScoreBranches(const G4Event* event);
+    void ScoreLines(const B1EventInformation* eventInfo);
+    void ScoreCrystals();
+    void ScoreSegments();
+
     B1RunAction* fRunAction;
     G4double     fEdep;
     G4double     fEdep1;
     G4double     fEdep4;
+
+    G4bool                fForcing;
+    G4bool                fSampling;
+
+    G4bool                fBranching;
+    G4int                 fNofVolumes;
+    std::vector<Branch>   fBranches;
+    std::vector<Split>    fSplits;
+    std::vector<G4double> fBranchEdep;    // per branch and volume
+    std::vector<G4int>    fTrackBranch;   // track ID -> current branch
+    G4bool                fSplitWarned;   // once per thread
+    G4bool                fWeightWarned;
+
+    G4int                 fNofPrimaries;
+    std::vector<G4int>    fTrackPrimary;  // track ID -> primary index
+    std::vector<G4double> fPrimaryEdep1;  // Ge deposit per primary
+
+    std::vector<G4double> fCrystalEdep;   // Ge deposit per crystal
+
+    // only the segments hit are reset, there may be thousands
+    std::vector<G4double> fSegmentEdep;   // Ge deposit per segment
+    std::vector<G4int>    fSegmentsHit;
+    std::vector<G4int>    fSegmentsFired;
+    std::vector<G4double> fFiredEdep;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,70 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventInformation.hh
+/// \brief Definition of the B1EventInformation class
+
+#ifndef B1EventInformation_h
+#define B1EventInformation_h 1
+
+#include "G4VUserEventInformation.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Event information attached by the primary generator.
+///
+/// It records which gamma lines of a nuclide source were emitted, one
+/// entry per primary particle in the order they were added to the vertex,
+/// so that the event action can score per-line full-energy-peak
+/// efficiencies and true-coincidence summing. It also points to the
+/// generator's table of line energies, needed to recognise summing-in.
+
+class B1EventInformation : public G4VUserEventInformation
+{
+  public:
+    B1EventInformation(const std::vector<G4double>* lineTable = 0);
+    virtual ~B1EventInformation();
+
+    virtual void Print() const;
+
+    void AddGamma(G4int line, G4double energy)
+      { fLineIndex.push_back(line); fLineEnergy.push_back(energy); }
+
+    G4int    GetNumberOfGammas() const  { return fLineIndex.size(); }
+    G4int    GetLineIndex(G4int k) const  { return fLineIndex[k]; }
+    G4double GetLineEnergy(G4int k) const { return fLineEnergy[k]; }
+    const std::vector<G4double>* GetLineTable() const { return fLineTable; }
+
+  private:
+    const std::vector<G4double>* fLineTable;
+    std::vector<G4int>    fLineIndex;
+    std::vector<G4double> fLineEnergy;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,106 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventWatchdog.hh
+/// \brief Definition of the B1EventWatchdog class
+
+#ifndef B1EventWatchdog_h
+#define B1EventWatchdog_h 1
+
+#include "G4Accumulable.hh"
+#include "G4Timer.hh"
+#include "globals.hh"
+
+#include <mutex>
+#include <vector>
+
+class B1EventWatchdogMessenger;
+class G4Event;
+
+/// Per-event limits on wall time and steps, so that one pathological
+/// event cannot hold up a thread. There is one instance per thread.
+///
+/// The steps of the event are counted in the stepping action, and the
+/// wall time is checked every kTimeCheckInterval steps. An event over
+/// a limit is aborted through the run manager: its tracks and stacks
+/// are dropped and the event action does not score it, but it is still
+/// counted in the run. The efficiencies are then low by at most the
+/// fraction of aborted events, which the run summary prints with the
+/// number of aborts per limit, the Ge deposit they had made and, on the
+/// master, their event numbers. Aborted events over the slow event
+/// thresholds are saved for /B1/slow/replay like the others.
+
+class B1EventWatchdog
+{
+  public:
+    static B1EventWatchdog* Instance();
+    ~B1EventWatchdog();
+
+    void SetMaxTime(G4double time)          { fMaxTime = time; }
+    void SetMaxSteps(G4int steps)           { fMaxSteps = steps; }
+
+    G4bool IsActive() const { return fMaxTime > 0. || fMaxSteps > 0; }
+
+    // master or sequential, before the event loop
+    void BeginOfRun();
+    void BeginOfEvent();
+    // aborts the event once over a limit
+    void ProcessStep();
+    // the event was aborted, with this Ge deposit so far
+    void RecordAbort(const G4Event* event, G4double edep1);
+    // prints the merged counters (master or sequential)
+    void Print() const;
+
+  private:
+    B1EventWatchdog();
+
+    void Abort(const char* limit);
+
+    static G4ThreadLocal B1EventWatchdog* fInstance;
+
+    G4double fMaxTime;      // 0 for no limit
+    G4int    fMaxSteps;     // 0 for no limit
+
+    G4Timer  fTimer;
+    G4int    fNofSteps;
+    G4bool   fAborted;      // by this watchdog, in this event
+    G4bool   fOverTime;
+
+    // event numbers of the aborted events of all threads
+    static std::vector<G4int> fAbortedEvents;
+    static std::mutex fMutex;
+
+    G4Accumulable<G4double> fNofEvents;
+    G4Accumulable<G4double> fNofTimeAborts;
+    G4Accumulable<G4double> fNofStepAborts;
+    G4Accumulable<G4double> fLostEdep1;
+
+    B1EventWatchdogMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,58 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1GammaElectronPhysics.hh
+/// \brief Definition of the B1GammaElectronPhysics class
+
+#ifndef B1GammaElectronPhysics_h
+#define B1GammaElectronPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+/// Minimal EM physics for photon sources: only gammas, electrons and
+/// positrons are defined and given processes, with no decay.
+///
+/// Photoelectric effect, Compton and Rayleigh scattering use the
+/// Livermore models, which follow the Ge K and L edges. Fluorescence is
+/// produced regardless of the production cuts, so the ~10 keV Ge K X-rays
+/// escaping the crystal are simulated. Electrons and positrons get
+/// multiple scattering, ionisation and bremsstrahlung with the standard
+/// models, positrons also annihilation.
+
+class B1GammaElectronPhysics : public G4VPhysicsConstructor
+{
+  public:
+    B1GammaElectronPhysics(G4int verbose = 1);
+    virtual ~B1GammaElectronPhysics();
+
+    virtual void ConstructParticle();
+    virtual void ConstructProcess();
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HitFile.hh
+/// \brief Binary layout of the Ge hit files
+
+#ifndef B1HitFile_h
+#define B1HitFile_h 1
+
+#include <cstdint>
+
+/// A hit file is one B1HitFileHeader followed by nofEvents blocks, each
+/// a B1HitEventHeader and nofHits B1HitRecord entries, in native byte
+/// order. Hit positions are at the step midpoint in the frame of the Ge
+/// crystal they are in (Shape1, a cylinder along z with its front face
+/// at +halfZ), in mm; energies in MeV. The hits of an event are grouped
+/// by crystal copy number, in increasing order, each crystal of an
+/// array being a detector of its own. Only events with a Ge deposit are
+/// stored; nofHistories counts all simulated events, for normalisation.
+///
+/// This header is shared by the simulation and the stand-alone tools,
+/// so it must not depend on Geant4.
+
+struct B1HitFileHeader
+{
+  char     magic[8];      // "B1HITS02"
+  uint64_t nofEvents;
+  uint64_t nofHistories;
+  double   radius;        // crystal radius
+  double   halfZ;         // crystal half length
+  uint32_t recordSize;    // sizeof(B1HitRecord)
+  uint32_t reserved;
+};
+
+struct B1HitEventHeader
+{
+  int32_t  eventID;
+  uint32_t nofHits;
+};
+
+struct B1HitRecord
+{
+  float   x, y, z;
+  float   edep;
+  int32_t copyNo;         // crystal
+};
+
+static const char kB1HitFileMagic[8] = { 'B','1','H','I','T','S','0','2' };
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HitRecorder.hh
+/// \brief Definition of the B1HitRecorder class
+
+#ifndef B1HitRecorder_h
+#define B1HitRecorder_h 1
+
+#include "B1WorkerFile.hh"
+#include "B1HitFile.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4Step;
+class B1HitRecorderMessenger;
+
+/// Recording of the individual Ge energy deposits of each event.
+///
+/// There is one instance per thread, like the analysis manager. When
+/// enabled, every Ge step with a deposit is stored with its position in
+/// the crystal frame, so that quantities depending on where the energy
+/// was deposited (dead layer, charge collection, segmentation) can be
+/// re-scored afterwards by the tools in tools/ without new transport.
+/// Workers write <name>_t<N>.hits, merged by the master into <name>.hits
+/// (B1WorkerFile).
+
+class B1HitRecorder : public B1WorkerFile
+{
+  public:
+    static B1HitRecorder* Instance();
+    ~B1HitRecorder();
+
+    void SetActive(G4bool active)          { fActive = active; }
+    void SetFileName(const G4String& name) { fFileName = name; }
+
+    G4bool IsActive() const { return fActive; }
+    const G4String& GetFileName() const { return fFileName; }
+
+    void BeginOfRun();
+    void EndOfRun(G4int nofEvents);
+
+    // called from the stepping action for Ge steps while active
+    void AddHit(const G4Step* step, G4double edep);
+    // called from the event action while active
+    void EndOfEvent(G4int eventID);
+
+  private:
+    B1HitRecorder();
+
+    void Flush();
+    virtual void   WriteHeader(std::ostream& file, uint64_t nofEvents,
+                               uint64_t nofHistories) const;
+    virtual G4bool ReadHeader(std::istream& file, uint64_t& nofEvents,
+                              uint64_t& nofHistories) const;
+
+    static G4ThreadLocal B1HitRecorder* fInstance;
+
+    G4bool   fActive;
+    G4String fFileName;
+    G4double fRadius;
+    G4double fHalfZ;
+
+    std::vector<B1HitRecord> fEventHits;
+    std::vector<char>        fBuffer;
+    uint64_t fNofEvents;
+
+    B1HitRecorderMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
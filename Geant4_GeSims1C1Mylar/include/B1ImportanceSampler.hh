@@ -0,0 +1,121 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ImportanceSampler.hh
+/// \brief Definition of the B1ImportanceSampler class
+
+#ifndef B1ImportanceSampler_h
+#define B1ImportanceSampler_h 1
+
+#include "G4Accumulable.hh"
+#include "G4ThreeVector.hh"
+#include "G4TrackVector.hh"
+#include "globals.hh"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class B1ImportanceSamplerMessenger;
+class G4LogicalVolume;
+class G4Step;
+class G4Track;
+
+/// Importance sampling of the gammas for shielded and extended sources,
+/// from the stepping action. There is one instance per thread.
+///
+/// The importance of a point is the one of its logical volume, when set
+/// with /B1/imp/volume, else the one of the spherical shell around the
+/// mesh centre it falls in (/B1/imp/shell), the outermost shell
+/// extending to infinity. Importances growing towards the detector make
+/// the gammas split when moving towards it and play Russian roulette
+/// when moving away:
+///  - geometric mode: at the end of each step the ratio r of the
+///    importances after and before it gives r copies (rounded at
+///    random) of weight w/r, or a survival probability r and a
+///    survivor weight w/r;
+///  - weight-window mode (/B1/imp/weightWindow w0): the weight is kept
+///    in [w0/I, 5 w0/I], splitting above and playing roulette below,
+///    survivors getting 3 w0/I.
+/// Copies start at the end of the step as secondaries of the split
+/// track, so that each one opens its own branch of the event history
+/// in B1EventAction; only the gammas owning a branch play, and a gamma
+/// killed by roulette gets a weight of 0 to close its branch. Splitting
+/// is capped per step.
+
+class B1ImportanceSampler
+{
+  public:
+    static B1ImportanceSampler* Instance();
+    ~B1ImportanceSampler();
+
+    void SetActive(G4bool active)         { fActive = active; }
+    void SetCentre(const G4ThreeVector& centre) { fCentre = centre; }
+    void SetShell(G4double radius, G4double importance);
+    void SetVolume(const G4String& name, G4double importance);
+    void Clear();
+    void SetWeightWindow(G4double weight) { fWindowWeight = weight; }
+    void SetMaxSplit(G4int nofCopies)     { fMaxSplit = nofCopies; }
+
+    G4bool IsActive() const { return fActive; }
+
+    void BeginOfRun();
+    // splits or kills the gamma of this step; copies go to secondaries
+    void ProcessStep(const G4Step* step, G4TrackVector* secondaries);
+    // prints the merged counters (master or sequential)
+    void Print() const;
+
+  private:
+    B1ImportanceSampler();
+
+    G4double GetImportance(const G4ThreeVector& point,
+                           const G4LogicalVolume* volume) const;
+    void Split(const G4Step* step, G4double ratio,
+               G4TrackVector* secondaries);
+    void Roulette(const G4Step* step, G4double survival);
+
+    static G4ThreadLocal B1ImportanceSampler* fInstance;
+
+    G4bool   fActive;
+    G4ThreeVector fCentre;
+    std::map<G4double, G4double> fShells;      // outer radius -> importance
+    std::map<G4String, G4double> fVolumeNames;
+    G4double fWindowWeight;                    // 0: geometric mode
+    G4int    fMaxSplit;
+
+    std::unordered_map<const G4LogicalVolume*, G4double> fVolumes;
+
+    G4Accumulable<G4double> fNofSplit;
+    G4Accumulable<G4double> fNofCopies;
+    G4Accumulable<G4double> fNofRoulette;
+    G4Accumulable<G4double> fNofKilled;
+
+    B1ImportanceSamplerMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
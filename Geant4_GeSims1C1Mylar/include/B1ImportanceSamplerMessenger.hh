@@ -0,0 +1,70 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ImportanceSamplerMessenger.hh
+/// \brief Definition of the B1ImportanceSamplerMessenger class
+
+#ifndef B1ImportanceSamplerMessenger_h
+#define B1ImportanceSamplerMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1ImportanceSampler;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWith3VectorAndUnit;
+class G4UIcmdWithoutParameter;
+
+/// Messenger for the B1ImportanceSampler, commands in /B1/imp/.
+
+class B1ImportanceSamplerMessenger : public G4UImessenger
+{
+  public:
+    B1ImportanceSamplerMessenger(B1ImportanceSampler* sampler);
+    virtual ~B1ImportanceSamplerMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1ImportanceSampler* fSampler;
+
+    G4UIdirectory*             fImpDir;
+    G4UIcmdWithABool*          fActiveCmd;
+    G4UIcmdWith3VectorAndUnit* fCentreCmd;
+    G4UIcommand*               fShellCmd;
+    G4UIcommand*               fVolumeCmd;
+    G4UIcmdWithoutParameter*   fClearCmd;
+    G4UIcmdWithADouble*        fWeightWindowCmd;
+    G4UIcmdWithAnInteger*      fMaxSplitCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
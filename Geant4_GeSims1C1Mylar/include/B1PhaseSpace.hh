@@ -0,0 +1,64 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PhaseSpace.hh
+/// \brief Binary layout of the phase-space files
+
+#ifndef B1PhaseSpace_h
+#define B1PhaseSpace_h 1
+
+#include <cstdint>
+
+/// A phase-space file is one B1PhaseSpaceHeader followed by nofRecords
+/// B1PhaseSpaceRecord entries, in native byte order. Energies are in MeV
+/// and positions in mm. nofHistories is the number of source events that
+/// produced the file, needed to normalise any result obtained by replay.
+
+struct B1PhaseSpaceHeader
+{
+  char     magic[8];      // "B1PHSP01"
+  uint64_t nofRecords;
+  uint64_t nofHistories;
+  double   planeZ;        // scoring plane, or 0 when scored on a volume
+  uint32_t recordSize;    // sizeof(B1PhaseSpaceRecord)
+  uint32_t reserved;
+};
+
+struct B1PhaseSpaceRecord
+{
+  float   energy;
+  float   x, y, z;
+  float   u, v, w;
+  float   weight;
+  int32_t eventID;
+  int32_t pdg;
+};
+
+static const char kB1PhaseSpaceMagic[8] = { 'B','1','P','H','S','P','0','1' };
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
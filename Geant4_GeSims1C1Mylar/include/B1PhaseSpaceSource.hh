@@ -0,0 +1,98 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PhaseSpaceSource.hh
+/// \brief Definition of the B1PhaseSpaceSource class
+
+#ifndef B1PhaseSpaceSource_h
+#define B1PhaseSpaceSource_h 1
+
+#include "G4VPrimaryGenerator.hh"
+#include "B1PhaseSpace.hh"
+#include "globals.hh"
+
+class G4Event;
+class G4ParticleDefinition;
+
+/// Primary generator replaying a phase-space file written by
+/// B1PhaseSpaceWriter, one recorded source history per event: the
+/// consecutive records with the same event ID (cascade gammas, an
+/// annihilation pair) are replayed together, one vertex per record, so
+/// that coincidence summing is kept.
+///
+/// The file is memory mapped read-only. Each worker maps it itself (the
+/// pages are shared by the OS) and replays its own contiguous slice of
+/// the records, its bounds moved forward to the start of a history, so
+/// no locking is needed. With recycling > 1 every history is used that
+/// many times; on request each use is rotated by a random angle about
+/// the z axis (the detector axis), which is only valid for a geometry
+/// symmetric about it. When a slice is exhausted it starts over, with a
+/// warning. Records of unknown particles are skipped, with a warning.
+
+class B1PhaseSpaceSource : public G4VPrimaryGenerator
+{
+  public:
+    B1PhaseSpaceSource();
+    virtual ~B1PhaseSpaceSource();
+
+    virtual void GeneratePrimaryVertex(G4Event*);
+
+    G4bool Open(const G4String& fileName);
+    void   Close();
+    void   SetRecycle(G4int recycle) { fRecycle = (recycle > 1) ? recycle : 1; }
+    void   SetRotation(G4bool rotate) { fRotate = rotate; }
+
+    G4bool IsOpen() const { return fRecords != 0; }
+    const G4String& GetFileName() const { return fFileName; }
+
+  private:
+    const G4ParticleDefinition* FindParticle(G4int pdg);
+    // first record of the history at or after record
+    uint64_t HistoryStart(uint64_t record) const;
+
+    G4String  fFileName;
+    void*     fMap;
+    size_t    fMapSize;
+    const B1PhaseSpaceRecord* fRecords;
+    uint64_t  fNofRecords;
+    uint64_t  fNofHistories;
+
+    uint64_t  fFirst;
+    uint64_t  fLast;
+    uint64_t  fNext;
+    G4int     fRecycle;
+    G4bool    fRotate;      // recycled records about the z axis
+    G4int     fUse;
+    G4bool    fWrapped;
+    G4bool    fSkipWarned;
+
+    G4int     fPdg;
+    const G4ParticleDefinition* fParticle;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PhaseSpaceWriter.hh
+/// \brief Definition of the B1PhaseSpaceWriter class
+
+#ifndef B1PhaseSpaceWriter_h
+#define B1PhaseSpaceWriter_h 1
+
+#include "B1WorkerFile.hh"
+#include "B1PhaseSpace.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4Step;
+class G4LogicalVolume;
+class B1PhaseSpaceWriterMessenger;
+
+/// Phase-space recording at a scoring plane or volume surface.
+///
+/// There is one instance per thread, like the analysis manager. When
+/// enabled, every particle crossing the plane z = planeZ towards -z (the
+/// detector side), or entering the selected logical volume, is written
+/// with its energy, position, direction, weight and event ID. Workers
+/// write their own file (<name>_t<N>.phsp), which the master concatenates
+/// into <name>.phsp at the end of the run (B1WorkerFile). Optionally the
+/// recorded
+/// particles are killed so the detector side is not transported at all.
+
+class B1PhaseSpaceWriter : public B1WorkerFile
+{
+  public:
+    static B1PhaseSpaceWriter* Instance();
+    ~B1PhaseSpaceWriter();
+
+    void SetActive(G4bool active)            { fActive = active; }
+    void SetFileName(const G4String& name)   { fFileName = name; }
+    void SetPlaneZ(G4double z)               { fPlaneZ = z; fVolumeName = ""; }
+    void SetVolume(const G4String& name)     { fVolumeName = name; fVolume = 0; }
+    void SetKill(G4bool kill)                { fKill = kill; }
+
+    G4bool IsActive() const { return fActive; }
+    const G4String& GetFileName() const { return fFileName; }
+
+    void BeginOfRun();
+    void EndOfRun(G4int nofEvents);
+
+    // called from the stepping action for every step while active
+    void ProcessStep(const G4Step* step);
+
+  private:
+    B1PhaseSpaceWriter();
+
+    void   Flush();
+    virtual void   WriteHeader(std::ostream& file, uint64_t nofRecords,
+                               uint64_t nofHistories) const;
+    virtual G4bool ReadHeader(std::istream& file, uint64_t& nofRecords,
+                              uint64_t& nofHistories) const;
+
+    static G4ThreadLocal B1PhaseSpaceWriter* fInstance;
+
+    G4bool   fActive;
+    G4String fFileName;
+    G4double fPlaneZ;
+    G4String fVolumeName;
+    G4LogicalVolume* fVolume;
+    G4bool   fKill;
+
+    std::vector<B1PhaseSpaceRecord> fBuffer;
+    uint64_t fNofRecords;
+
+    B1PhaseSpaceWriterMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PileupDigitizer.hh
+/// \brief Definition of the B1PileupDigitizer class
+
+#ifndef B1PileupDigitizer_h
+#define B1PileupDigitizer_h 1
+
+#include "G4Accumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class B1PileupDigitizerMessenger;
+
+/// Count-rate effects on the Ge spectrum: pile-up and dead time.
+///
+/// There is one instance per thread, like the analysis manager. Each
+/// event is one decay of a source of the given activity and gets a
+/// Poisson (exponentially spaced) timestamp; events being independent,
+/// every worker can run its own time line at the full activity. Events
+/// with a Ge deposit are pulses, held in a fixed-size ring buffer until
+/// the shaping time after them has passed:
+///  - pulses starting within the shaping time of a recorded pulse pile
+///    up on it, their energies adding;
+///  - pulses arriving later but before the end of the dead time are
+///    lost, and with a paralyzable dead time extend it.
+/// The recorded pulses fill the "Edep1_pileup" histogram, to compare
+/// with the ideal Edep1 spectrum. Memory does not grow with the number
+/// of events.
+
+class B1PileupDigitizer
+{
+  public:
+    static B1PileupDigitizer* Instance();
+    ~B1PileupDigitizer();
+
+    void SetActive(G4bool active)          { fActive = active; }
+    void SetActivity(G4double activity)    { fActivity = activity; }
+    void SetShapingTime(G4double time)     { fShapingTime = time; }
+    void SetDeadTime(G4double time)        { fDeadTime = time; }
+    void SetParalyzable(G4bool value)      { fParalyzable = value; }
+    void SetThreshold(G4double energy)     { fThreshold = energy; }
+
+    G4bool IsActive() const { return fActive; }
+
+    void BeginOfRun();
+    // called at the end of each event with its Ge deposit
+    void ProcessEvent(G4double edep);
+    // processes the pulses left in the buffer, before the merging
+    void EndOfRun();
+    // prints the merged counters (master or sequential)
+    void Print() const;
+
+  private:
+    struct Pulse
+    {
+      G4double time;
+      G4double energy;
+    };
+
+    B1PileupDigitizer();
+
+    void Push(const Pulse& pulse);
+    // resolves the oldest pulses whose shaping window has closed,
+    // or all of them when flushing
+    void Process(G4bool flush);
+    void ResolveOldest();
+    void Record(G4double energy);
+
+    static G4ThreadLocal B1PileupDigitizer* fInstance;
+
+    G4bool   fActive;
+    G4double fActivity;
+    G4double fShapingTime;
+    G4double fDeadTime;
+    G4bool   fParalyzable;
+    G4double fThreshold;
+
+    G4double fTime;        // timestamp of the last event
+    G4double fDeadUntil;
+
+    // ring buffer of pending pulses, in time order
+    std::vector<Pulse> fBuffer;
+    size_t fHead;
+    size_t fSize;
+
+    G4int fH1;
+
+    G4Accumulable<G4double> fRealTime;
+    G4Accumulable<G4double> fNofPulses;
+    G4Accumulable<G4double> fNofRecorded;
+    G4Accumulable<G4double> fNofPiledUp;
+    G4Accumulable<G4double> fNofLost;
+
+    B1PileupDigitizerMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
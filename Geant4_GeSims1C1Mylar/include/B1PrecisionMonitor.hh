@@ -0,0 +1,91 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PrecisionMonitor.hh
+/// \brief Definition of the B1PrecisionMonitor class
+
+#ifndef B1PrecisionMonitor_h
+#define B1PrecisionMonitor_h 1
+
+#include "B1StatAccumulable.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <mutex>
+
+class B1PrecisionMonitorMessenger;
+
+/// Early stopping of a run once the energy deposit in one scoring
+/// volume is known precisely enough.
+///
+/// A single instance per process: every thread reports the batch means
+/// of the monitored volume as they complete, and once there are enough
+/// batches and the relative standard error of their mean is below the
+/// requested precision, the event loops are asked to stop after the
+/// current event. The batch size also sets the batches of the run
+/// statistics. Commands are handled by the master only.
+
+class B1PrecisionMonitor
+{
+  public:
+    static B1PrecisionMonitor* Instance();
+    ~B1PrecisionMonitor();
+
+    void SetPrecision(G4double value)       { fPrecision = value; }
+    void SetVolume(const G4String& name)    { fVolume = name; }
+    void SetBatchSize(G4int value)          { fBatchSize = value; }
+    void SetMinBatches(G4int value)         { fMinBatches = value; }
+
+    G4bool IsActive() const                 { return fPrecision > 0.; }
+    const G4String& GetVolume() const       { return fVolume; }
+    G4int GetBatchSize() const              { return fBatchSize; }
+
+    // master or sequential, before the event loop
+    void BeginOfRun();
+    // event loop threads
+    void AddBatch(G4double mean);
+    G4bool IsReached() const                { return fReached; }
+
+  private:
+    B1PrecisionMonitor();
+
+    static B1PrecisionMonitor* fInstance;
+
+    G4double fPrecision;     // relative, 0 for no early stopping
+    G4String fVolume;
+    G4int    fBatchSize;
+    G4int    fMinBatches;
+
+    std::mutex fMutex;
+    B1StatAccumulable fBatchMeans;
+    std::atomic<bool> fReached;
+
+    B1PrecisionMonitorMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -33,17 +33,35 @@
 #include "G4VUserPrimaryGeneratorAction.hh"
 //#include "G4ParticleGun.hh"
 #include "G4GeneralParticleSource.hh"
+#include "B1AliasTable.hh"
 #include "globals.hh"
 
+#include <vector>
+
 //class G4ParticleGun;
 class G4GeneralParticleSource;
 class G4Event;
 class G4Box;
+class B1PrimaryGeneratorMessenger;
+class B1AnalyticSource;
+class B1PhaseSpaceSource;
+class G4ParticleDefinition;
+class G4PrimaryParticle;
 
 /// The primary generator action class with particle gun.
 ///
 /// The default kinematic is a 6 MeV gamma, randomly distribued 
 /// in front of the phantom across 80% of the (X,Y) phantom size.
+///
+/// With /B1/source/energyMode lines the energy set by GPS is replaced by
+/// a gamma line drawn from a radionuclide line table through an alias
+/// table; the line index is attached to the event as B1EventInformation.
+/// A cascade table instead draws a whole decay branch, and all of its
+/// gammas are emitted from the same vertex.
+///
+/// /B1/source/generator analytic replaces GPS by the lightweight
+/// B1AnalyticSource (configured in /B1/gun/); GPS stays the default.
+/// /B1/source/generator phsp replays a phase-space file instead.
 
 class B1PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -57,11 +75,55 @@ class B1PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
     // method to access particle gun
     // const G4ParticleGun* GetParticleGun() const { return fParticleGun; }
     const G4GeneralParticleSource* GetParticleSource() const { return fParticleSource; }
+
+    // generator selection
+    enum Generator { kGPS, kAnalytic, kPhaseSpace };
+    void SetGenerator(const G4String& generator);
+    Generator GetGenerator() const { return fGenerator; }
+    const G4ParticleDefinition* GetParticleDefinition() const;
+    G4double GetParticleEnergy() const;
+
+    // phase-space replay
+    void OpenPhaseSpace(const G4String& fileName);
+    void SetPhaseSpaceRecycle(G4int recycle);
+    void SetPhaseSpaceRotation(G4bool rotate);
+    const B1PhaseSpaceSource* GetPhaseSpaceSource() const { return fPhaseSpaceSource; }
+
+    const B1AnalyticSource* GetAnalyticSource() const { return fAnalyticSource; }
+
+    // radionuclide line source
+    void LoadLineFile(const G4String& fileName);
+    void LoadCascadeFile(const G4String& fileName);
+    void SetEnergyMode(const G4String& mode);
+    G4bool UseLines() const { return fUseLines; }
+    const G4String& GetLineFile() const { return fLineFile; }
+    const std::vector<G4double>& GetLineEnergies() const { return fLineEnergies; }
   
   private:
     //G4ParticleGun*  fParticleGun; // pointer a to G4 gun class
     G4GeneralParticleSource*  fParticleSource;
+    B1AnalyticSource*         fAnalyticSource;
+    B1PhaseSpaceSource*       fPhaseSpaceSource;
+    Generator                 fGenerator;
     G4Box* fEnvelopeBox;
+
+    B1PrimaryGeneratorMessenger* fMessenger;
+
+    G4bool                fUseLines;
+    G4bool                fAngularWarned;
+    G4String              fLineFile;
+    std::vector<G4double> fLineEnergies;          // distinct gamma lines
+    std::vector< std::vector<G4int> > fBranches;  // lines emitted together
+    B1AliasTable          fBranchTable;
+
+    G4bool IsIsotropic(const G4PrimaryParticle* primary) const;
+    G4bool ReadTable(const G4String& fileName, G4bool cascade,
+                     std::vector< std::vector<G4double> >& branches,
+                     std::vector<G4double>& weights) const;
+    void   SetEmissionTable(const G4String& fileName,
+                     const std::vector< std::vector<G4double> >& branches,
+                     const std::vector<G4double>& weights);
+    G4ThreeVector IsotropicDirection() const;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,77 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PrimaryGeneratorMessenger.hh
+/// \brief Definition of the B1PrimaryGeneratorMessenger class
+
+#ifndef B1PrimaryGeneratorMessenger_h
+#define B1PrimaryGeneratorMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1PrimaryGeneratorAction;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
+
+/// Messenger for the B1PrimaryGeneratorAction.
+///
+/// It defines the commands in the /B1/source/ directory:
+/// - /B1/source/lineFile    file with gamma energies (keV) and intensities
+/// - /B1/source/cascadeFile file with decay branches emitted in cascade
+/// - /B1/source/energyMode  gps | lines
+/// - /B1/source/generator   gps | analytic | phsp
+/// - /B1/source/phspFile    phase-space file to replay
+/// - /B1/source/phspRecycle number of uses of each phase-space particle
+/// - /B1/source/phspRotate  rotate the recycled particles about z
+
+class B1PrimaryGeneratorMessenger : public G4UImessenger
+{
+  public:
+    B1PrimaryGeneratorMessenger(B1PrimaryGeneratorAction* action);
+    virtual ~B1PrimaryGeneratorMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1PrimaryGeneratorAction* fAction;
+
+    G4UIdirectory*      fB1Dir;
+    G4UIdirectory*      fSourceDir;
+    G4UIcmdWithAString* fLineFileCmd;
+    G4UIcmdWithAString* fCascadeFileCmd;
+    G4UIcmdWithAString* fEnergyModeCmd;
+    G4UIcmdWithAString* fGeneratorCmd;
+    G4UIcmdWithAString* fPhspFileCmd;
+    G4UIcmdWithAnInteger* fPhspRecycleCmd;
+    G4UIcmdWithABool*   fPhspRotateCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
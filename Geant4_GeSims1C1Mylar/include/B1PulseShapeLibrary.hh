@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PulseShapeLibrary.hh
+/// \brief Definition of the B1PulseShapeLibrary class
+
+#ifndef B1PulseShapeLibrary_h
+#define B1PulseShapeLibrary_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Library of the charge signals induced by one unit of charge created
+/// at each node of an (r, z) grid of the Ge crystal.
+///
+/// The weighting potential of the readout contact and the electron and
+/// hole drift velocities are read on (r, z) grids from two text files,
+/// with the layout of the charge collection map:
+///   nr rmin rmax nz zmin zmax      (lengths in mm)
+///   then per node, z varying fastest:
+///     weighting potential file: phi (1 on the readout contact)
+///     drift velocity file:      ve_r ve_z vh_r vh_z (mm/ns)
+/// Build() drifts both carriers from every node and stores the sampled
+/// signal WP(hole) - WP(electron), which rises to 1 for full collection.
+/// A hit then costs a bilinear blend of the four neighbouring signals,
+/// a loop over samples with no branches that compilers vectorise.
+/// Read-only once built, so shared by all threads.
+
+class B1PulseShapeLibrary
+{
+  public:
+    B1PulseShapeLibrary();
+    ~B1PulseShapeLibrary();
+
+    G4bool LoadWeightingPotential(const G4String& fileName);
+    G4bool LoadDriftVelocity(const G4String& fileName);
+    G4bool Build(G4int nofSamples, G4double samplingPeriod);
+
+    G4bool IsBuilt() const         { return !fSignals.empty(); }
+    G4int  GetNofSamples() const   { return fNofSamples; }
+
+    // adds weight times the signal of a unit charge at (r, z)
+    void Accumulate(G4double r, G4double z, G4double weight,
+                    float* waveform) const;
+
+  private:
+    struct Grid
+    {
+      G4int nofR = 0, nofZ = 0;
+      G4double rMin = 0., rMax = 0., zMin = 0., zMax = 0.;
+      G4double invDR = 0., invDZ = 0.;  // inverse grid spacings
+      // nofValues per node, nodes row-major in r
+      std::vector<G4double> values;
+    };
+
+    G4bool ReadGrid(const G4String& fileName, G4int nofValues,
+                    Grid& grid) const;
+    // bilinear interpolation of value k of the grid
+    G4double Interpolate(const Grid& grid, G4int nofValues, G4int k,
+                         G4double r, G4double z) const;
+    G4bool IsInside(G4double r, G4double z) const;
+    // cell of (r, z) and fractional coordinates in it, clamped
+    void Locate(const Grid& grid, G4double r, G4double z,
+                G4int& ir, G4int& iz, G4double& u, G4double& v) const;
+
+    Grid fPotential;
+    Grid fVelocity;
+
+    G4int    fNofSamples;
+    G4double fSamplingPeriod;
+    // fNofSamples floats per node, nodes row-major in r
+    std::vector<float> fSignals;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,138 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PulseShapeSimulator.hh
+/// \brief Definition of the B1PulseShapeSimulator class
+
+#ifndef B1PulseShapeSimulator_h
+#define B1PulseShapeSimulator_h 1
+
+#include "B1PulseShapeLibrary.hh"
+#include "globals.hh"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class B1PulseShapeSimulatorMessenger;
+class G4Step;
+
+/// Ge pulse shapes: turns the hits of each event into sampled waveforms
+/// of the induced charge, written to <fileName>.wave (see
+/// B1WaveformFile.hh).
+///
+/// Unlike the other stages there is a single instance per process:
+/// the event loop threads only collect their hits (crystal-local r, z
+/// and the raw deposit) and queue them at the end of the event; a pool
+/// of synthesis threads of its own blends the signals of the
+/// B1PulseShapeLibrary and writes the records. The queue is bounded, so
+/// a pool that cannot keep up slows transport down instead of filling
+/// the memory; the number of such waits is reported at the end of run.
+/// Commands are handled by the master only.
+
+class B1PulseShapeSimulator
+{
+  public:
+    static B1PulseShapeSimulator* Instance();
+    ~B1PulseShapeSimulator();
+
+    void SetActive(G4bool active)               { fActive = active; }
+    void SetNofSamples(G4int value)             { fNofSamples = value; }
+    void SetSamplingPeriod(G4double value)      { fSamplingPeriod = value; }
+    void SetGain(G4double value)                { fGain = value; }
+    void SetNofThreads(G4int value)             { fNofThreads = value; }
+    void SetFileName(const G4String& name)      { fFileName = name; }
+    G4bool LoadWeightingPotential(const G4String& fileName);
+    G4bool LoadDriftVelocity(const G4String& fileName);
+
+    G4bool IsActive() const { return fActive; }
+    const G4String& GetFileName() const { return fFileName; }
+
+    // master or sequential: builds the library and starts the pool
+    void BeginOfRun();
+    // event loop threads
+    void AddHit(const G4Step* step, G4double edep);
+    void EndOfEvent(G4int eventID);
+    // every thread, at the end of its run: frees its hit buffer
+    void EndOfThreadRun();
+    // master or sequential, once the event loop is over: drains the
+    // queue and closes the file
+    void EndOfRun();
+
+  private:
+    struct Hit
+    {
+      G4int crystal;
+      float r, z;
+      float energy;
+    };
+    struct Job
+    {
+      G4int eventID;
+      std::vector<Hit> hits;
+    };
+
+    B1PulseShapeSimulator();
+
+    void Synthesize();   // body of the pool threads
+    void Write(G4int eventID, G4int crystal, G4double energy,
+               const std::vector<float>& waveform);
+
+    static B1PulseShapeSimulator* fInstance;
+    static G4ThreadLocal std::vector<Hit>* fEventHits;
+
+    G4bool   fActive;
+    G4int    fNofSamples;
+    G4double fSamplingPeriod;
+    G4double fGain;
+    G4int    fNofThreads;
+    G4String fFileName;
+
+    B1PulseShapeLibrary fLibrary;
+
+    // job queue
+    std::mutex fQueueMutex;
+    std::condition_variable fNotEmpty;
+    std::condition_variable fNotFull;
+    std::deque<Job> fQueue;
+    G4bool fRunning;
+    std::vector<std::thread> fThreads;
+    G4long fNofWaits;
+
+    // output
+    std::mutex fFileMutex;
+    std::ofstream fFile;
+    G4long fNofWaveforms;
+
+    B1PulseShapeSimulatorMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -32,19 +32,42 @@
 
 #include "G4UserRunAction.hh"
 #include "G4Accumulable.hh"
+#include "B1ArrayAccumulable.hh"
+#include "B1StatAccumulable.hh"
 #include "globals.hh"
 
+#include <vector>
+
 class G4Run;
 
 /// Run action class
 ///
-/// In EndOfRunAction(), it calculates the dose in the selected volume 
+/// In EndOfRunAction(), it calculates the dose in the scoring volumes
 /// from the energy deposit accumulated via stepping and event actions.
-/// The computed dose is then printed on the screen.
+/// The computed dose is then printed on the screen, with the standard
+/// errors from the event-by-event spread and from batch means.
+/// For radionuclide line sources it also prints, per gamma line, the
+/// number of emissions and the full-energy-peak efficiency in Ge; for
+/// cascade sources also the true-coincidence-summing correction factors.
+/// For a crystal array it books one spectrum per crystal and a crystal
+/// multiplicity histogram, and prints the counts per crystal. With the
+/// virtual segmentation on, the fired segments of each event go to the
+/// "Segments" ntuple, with segment and cluster multiplicity histograms.
+/// With importance sampling on, the master prints the figure of merit
+/// 1/(R^2 T) of the mean deposit per event in each volume, R being its
+/// relative error and T the run time, and its gain over the last run
+/// without importance sampling. For a run of the analytic source, the
+/// master compares the total and full-energy-peak efficiencies to the
+/// last semi-analytic estimate (B1EfficiencyEngine) at its energy. In
+/// correlated sampling, the master prints the variant run against the
+/// reference run (B1CorrelatedSampler).
 
 class B1RunAction : public G4UserRunAction
 {
   public:
+    // scoring volumes, in the order of the statistics and the printout
+    enum { kCWindow, kGe, kSourceWindow, kNofVolumes };
+
     B1RunAction();
     virtual ~B1RunAction();
 
@@ -52,18 +75,56 @@ class B1RunAction : public G4UserRunAction
     virtual void BeginOfRunAction(const G4Run*);
     virtual void   EndOfRunAction(const G4Run*);
 
-    void AddEdep (G4double edep);
-    void AddEdep1 (G4double edep1);
-    void AddEdep4 (G4double edep4);
+    // energy deposit of one event in a scoring volume
+    void AddEdep(G4int volume, G4double edep);
+    // weighted for branched event histories
+    void AddFullEnergyEvent(G4double weight = 1.) { fFullEnergy += weight; }
+    void AddGeEvent(G4double weight = 1.) { fGeEvents += weight; }
+    void AddLineEvent(G4int line, G4double energy,
+                      G4bool fullAbsorbed, G4bool summedOut);
+    void AddLineSumIn(G4int line);
+    void AddCrystalEdep(G4int copyNo, G4double edep);
+    void AddMultiplicity(G4int multiplicity);
+    void AddSegmentEvent(const std::vector<G4int>& segments,
+                         const std::vector<G4double>& energies,
+                         G4int nofClusters);
+
+    // first of the per-crystal histograms, followed by the multiplicity
+    G4int GetFirstCrystalH1() const { return fFirstCrystalH1; }
 
   private:
-    G4Accumulable<G4double> fEdep;
-    G4Accumulable<G4double> fEdep1;
-    G4Accumulable<G4double> fEdep2;
-    G4Accumulable<G4double> fEdep3;
-    G4Accumulable<G4double> fEdep4;
-    G4Accumulable<G4double> fEdep5;
-    
+    std::vector<B1StatAccumulable*> fVolumeEdep;
+    G4int fMonitoredVolume;   // for early stopping, or -1
+    G4double fAnalogFOM[kNofVolumes];   // of the last unbiased run
+    G4Accumulable<G4double> fFullEnergy;  // events with all primary energy in Ge
+    G4Accumulable<G4double> fGeEvents;    // events with a Ge deposit
+
+    B1ArrayAccumulable fLineEmitted;
+    B1ArrayAccumulable fLinePeak;
+    B1ArrayAccumulable fLineEnergy;
+    B1ArrayAccumulable fLineSumOut;
+    B1ArrayAccumulable fLineSumIn;
+
+    B1ArrayAccumulable fCrystalCounts;
+    B1ArrayAccumulable fCrystalEdep;
+    B1ArrayAccumulable fMultiplicity;
+    G4int fFirstCrystalH1;
+
+    B1ArrayAccumulable fSegmentMultiplicity;
+    B1ArrayAccumulable fClusterMultiplicity;
+    G4int fSegmentH1;                   // followed by the cluster histogram
+    G4int fSegmentNtuple;
+    std::vector<G4int>    fSegmentIds;  // ntuple columns
+    std::vector<G4double> fSegmentEnergies;
+
+    void BookCrystalHistograms();
+    void BookSegmentation();
+    void PrintVolumes(G4int nofEvents, const G4String& runCondition) const;
+    void PrintLineEfficiencies() const;
+    void PrintCrystals() const;
+    void PrintSegmentation() const;
+    void PrintFigureOfMerit();
+
 };
 
 #endif
@@ -0,0 +1,103 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1Segmentation.hh
+/// \brief Definition of the B1Segmentation class
+
+#ifndef B1Segmentation_h
+#define B1Segmentation_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4Step;
+class B1SegmentationMessenger;
+
+/// Virtual phi x z segmentation of the Ge crystal, for scoring only.
+///
+/// There is one instance per thread, like the analysis manager. The
+/// geometry is not subdivided: the segment of a Ge step is computed
+/// from its midpoint in the crystal frame by arithmetic binning, so the
+/// navigation cost does not depend on the number of segments. Segment
+/// IDs are copyNo*nofPhi*nofZ + iPhi*nofZ + iZ, so that each crystal of
+/// an array has its own segments. The numbers of segments are set in
+/// PreInit only, as the run action books the segment histograms and
+/// ntuple once.
+
+class B1Segmentation
+{
+  public:
+    static B1Segmentation* Instance();
+    ~B1Segmentation();
+
+    void SetActive(G4bool active)        { fActive = active; }
+    void SetNumberOfPhi(G4int nofPhi)    { fNofPhi = nofPhi; }
+    void SetNumberOfZ(G4int nofZ)        { fNofZ = nofZ; }
+    void SetThreshold(G4double energy)   { fThreshold = energy; }
+
+    G4bool   IsActive() const             { return fActive; }
+    G4int    GetNumberOfPhi() const       { return fNofPhi; }
+    G4int    GetNumberOfZ() const         { return fNofZ; }
+    G4int    GetNumberOfSegments() const  { return fNofCrystals*fNofPhi*fNofZ; }
+    G4double GetThreshold() const         { return fThreshold; }
+
+    // takes the crystal size and count from the geometry
+    void BeginOfRun();
+
+    // segment of the midpoint of a Ge step
+    G4int GetSegment(const G4Step* step) const;
+
+    // number of groups of fired segments connected through a face,
+    // neighbours in phi wrapping around
+    G4int CountClusters(const std::vector<G4int>& fired) const;
+
+  private:
+    B1Segmentation();
+
+    G4bool AreNeighbours(G4int first, G4int second) const;
+
+    static G4ThreadLocal B1Segmentation* fInstance;
+
+    G4bool   fActive;
+    G4int    fNofPhi;
+    G4int    fNofZ;
+    G4double fThreshold;
+
+    G4int    fNofCrystals;
+    G4double fHalfZ;
+    G4double fPhiScale;   // nofPhi/2pi
+    G4double fZScale;     // nofZ/(2 halfZ)
+
+    mutable std::vector<G4int> fClusterOf;
+
+    B1SegmentationMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
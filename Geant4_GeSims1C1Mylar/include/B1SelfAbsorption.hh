@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1SelfAbsorption.hh
+/// \brief Definition of the B1SelfAbsorption class
+
+#ifndef B1SelfAbsorption_h
+#define B1SelfAbsorption_h 1
+
+#include "B1ArrayAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class B1SelfAbsorptionMessenger;
+class B1AnalyticSource;
+class G4Event;
+
+/// Self-absorption corrections of sample matrices, without new transport.
+///
+/// There is one instance per thread, like the analysis manager. The
+/// analytic source volume is the sample, simulated empty (air). For every
+/// primary gamma, the path length from its vertex to the source surface
+/// along its direction is taken; for the gammas fully absorbed in Ge,
+/// it fills a path length histogram per line (per energy for a mono
+/// source). A gamma reaching the full-energy peak has crossed the sample
+/// unscattered, so with a matrix of attenuation coefficient mu its
+/// efficiency is reweighted by exp(-mu*l):
+///   C(E, matrix, density) = < exp(-mu/rho(E) * density * l) >_FEP
+/// At the end of the run the master prints these corrections for every
+/// matrix given with /B1/selfabs/material and every density given with
+/// /B1/selfabs/density (the nominal one without any), and writes them to
+/// a text file if one is named. The histograms stay until the next run,
+/// so /B1/selfabs/print recomputes the tables for other matrices and
+/// densities. Coherent scattering in the matrix, which keeps the energy,
+/// is counted as a loss.
+
+class B1SelfAbsorption
+{
+  public:
+    static B1SelfAbsorption* Instance();
+    ~B1SelfAbsorption();
+
+    void SetActive(G4bool active)            { fActive = active; }
+    void AddMaterial(const G4String& name)   { fMaterials.push_back(name); }
+    void ClearMaterials()                    { fMaterials.clear(); }
+    void AddDensity(G4double density)        { fDensities.push_back(density); }
+    void ClearDensities()                    { fDensities.clear(); }
+    void SetFileName(const G4String& name)   { fFileName = name; }
+    void SetBinWidth(G4double width)         { fBinWidth = width; }
+
+    G4bool IsActive() const { return fActive && fSource; }
+    const G4String& GetFileName() const { return fFileName; }
+
+    void BeginOfRun();
+    // path lengths of the primaries, once generated
+    void BeginOfEvent(const G4Event* event);
+    // primary gamma k of the event fully absorbed in Ge
+    void AddFullEnergy(G4int line, G4double energy, G4int primary);
+    // prints and writes the correction tables (master or sequential)
+    void Print() const;
+
+  private:
+    B1SelfAbsorption();
+
+    static G4ThreadLocal B1SelfAbsorption* fInstance;
+
+    G4bool   fActive;
+    std::vector<G4String> fMaterials;
+    std::vector<G4double> fDensities;   // or the nominal ones
+    G4String fFileName;
+
+    const B1AnalyticSource* fSource;
+    G4double fBinWidth;                 // of the path length histograms
+    std::vector<G4double> fPaths;       // of the primaries of the event
+
+    // per line: path length histogram, energy sum and count
+    B1ArrayAccumulable fPathCounts;
+    B1ArrayAccumulable fEnergySum;
+    B1ArrayAccumulable fNofFull;
+
+    B1SelfAbsorptionMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
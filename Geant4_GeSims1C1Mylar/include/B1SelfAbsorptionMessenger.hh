@@ -0,0 +1,69 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1SelfAbsorptionMessenger.hh
+/// \brief Definition of the B1SelfAbsorptionMessenger class
+
+#ifndef B1SelfAbsorptionMessenger_h
+#define B1SelfAbsorptionMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1SelfAbsorption;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+/// Messenger for the B1SelfAbsorption, commands in /B1/selfabs/.
+
+class B1SelfAbsorptionMessenger : public G4UImessenger
+{
+  public:
+    B1SelfAbsorptionMessenger(B1SelfAbsorption* selfAbsorption);
+    virtual ~B1SelfAbsorptionMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1SelfAbsorption* fSelfAbsorption;
+
+    G4UIdirectory*             fSelfAbsDir;
+    G4UIcmdWithABool*          fActiveCmd;
+    G4UIcmdWithAString*        fMaterialCmd;
+    G4UIcmdWithoutParameter*   fClearMaterialsCmd;
+    G4UIcmdWithADoubleAndUnit* fDensityCmd;
+    G4UIcmdWithoutParameter*   fClearDensitiesCmd;
+    G4UIcmdWithADoubleAndUnit* fBinWidthCmd;
+    G4UIcmdWithAString*        fFileCmd;
+    G4UIcmdWithoutParameter*   fPrintCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
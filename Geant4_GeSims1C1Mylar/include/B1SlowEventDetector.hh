@@ -0,0 +1,118 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1SlowEventDetector.hh
+/// \brief Definition of the B1SlowEventDetector class
+
+#ifndef B1SlowEventDetector_h
+#define B1SlowEventDetector_h 1
+
+#include "G4Accumulable.hh"
+#include "G4Timer.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+class B1SlowEventDetectorMessenger;
+class G4Event;
+
+/// Finds the events that take much longer than the others and replays
+/// them. There is one instance per thread.
+///
+/// The random engine status is taken before the primaries of every
+/// event, and the event is timed (wall clock) and its steps counted.
+/// An event over the time or the step threshold gets a block in the
+/// side file: run and event number, time, steps, the engine status and
+/// the primary vertices. The blocks of all threads and runs are
+/// appended to the same file. /B1/slow/replay restores the engine
+/// status of the last block of an event and runs that one event again
+/// with verbose tracking; with the same macro settings, it is the same
+/// event. The replay run writes its analysis, phase-space, hit, pulse,
+/// self-absorption and benchmark files to <name>_replay ones, so that
+/// the outputs of the production runs are kept. The number of slow events and the mean event time are
+/// printed at the end of the run.
+
+class B1SlowEventDetector
+{
+  public:
+    static B1SlowEventDetector* Instance();
+    ~B1SlowEventDetector();
+
+    void SetActive(G4bool active)            { fActive = active; }
+    void SetTimeThreshold(G4double time)     { fTimeThreshold = time; }
+    void SetStepThreshold(G4int steps)       { fStepThreshold = steps; }
+    void SetFileName(const G4String& name)   { fFileName = name; }
+    void SetReplayVerbose(G4int level)       { fReplayVerbose = level; }
+
+    // the current event is timed
+    G4bool IsTiming() const { return fActive || fReplaying; }
+
+    // before generating the primaries
+    void StartEvent();
+    void AddStep() { ++fNofSteps; }
+    void EndOfEvent(const G4Event* event);
+    // master or sequential: runs again an event of the side file
+    void Replay(G4int eventID);
+    // prints the merged counters (master or sequential)
+    void Print() const;
+
+  private:
+    B1SlowEventDetector();
+
+    void Write(const G4Event* event, G4double time) const;
+    // engine status of the last block of the event in the side file
+    G4bool Read(G4int eventID, std::vector<unsigned long>& status) const;
+
+    static G4ThreadLocal B1SlowEventDetector* fInstance;
+
+    G4bool   fActive;
+    G4double fTimeThreshold;
+    G4int    fStepThreshold;    // 0 for none
+    G4String fFileName;
+    G4int    fReplayVerbose;    // tracking verbose level of a replay
+
+    G4Timer  fTimer;
+    G4long   fNofSteps;
+    std::vector<unsigned long> fEngineStatus;
+    G4bool   fReplaying;
+
+    // the replayed event goes to any thread
+    static std::vector<unsigned long> fReplayStatus;
+    static std::atomic<bool> fReplayPending;
+    static std::mutex fFileMutex;
+
+    G4Accumulable<G4double> fNofEvents;
+    G4Accumulable<G4double> fEventTime;
+    G4Accumulable<G4double> fNofSlow;
+
+    B1SlowEventDetectorMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
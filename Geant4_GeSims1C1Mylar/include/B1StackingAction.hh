@@ -0,0 +1,57 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StackingAction.hh
+/// \brief Definition of the B1StackingAction class
+
+#ifndef B1StackingAction_h
+#define B1StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+class B1TrackKiller;
+
+/// Stacking action class
+///
+/// New tracks that cannot contribute to the scores are killed before
+/// being tracked, as decided by the B1TrackKiller.
+
+class B1StackingAction : public G4UserStackingAction
+{
+  public:
+    B1StackingAction();
+    virtual ~B1StackingAction();
+
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+
+  private:
+    B1TrackKiller* fTrackKiller;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,111 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StatAccumulable.hh
+/// \brief Definition of the B1StatAccumulable class
+
+#ifndef B1StatAccumulable_h
+#define B1StatAccumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <map>
+
+/// Accumulable of the per-event values of one quantity (e.g. the energy
+/// deposit in a scoring volume), with its mean and uncertainty.
+///
+/// Values are accumulated with Welford's update, which unlike sums of
+/// squares does not lose precision when the mean is large against the
+/// spread. Events are also grouped in batches of fixed size: the spread
+/// of the batch means gives a second estimate of the uncertainty, valid
+/// even if successive events are correlated. Merge() keeps the
+/// contribution of each worker by thread ID and combines them in
+/// increasing ID order, so the merged results do not depend on the
+/// order in which the workers finish.
+
+class B1StatAccumulable : public G4VAccumulable
+{
+  public:
+    B1StatAccumulable(const G4String& name = "");
+    virtual ~B1StatAccumulable();
+
+    virtual void Merge(const G4VAccumulable& other);
+    virtual void Reset();
+
+    void SetBatchSize(G4int size) { fBatchSize = size; }
+
+    // adds the value of one event; returns true when this completes a
+    // batch, whose mean is then GetLastBatchMean()
+    G4bool Fill(G4double value);
+    G4double GetLastBatchMean() const { return fLastBatchMean; }
+
+    G4double GetEntries() const  { return GetTotal().events.n; }
+    G4double GetMean() const     { return GetTotal().events.mean; }
+    G4double GetSum() const
+      { return GetTotal().events.n*GetTotal().events.mean; }
+    G4double GetStdDev() const;
+    // standard error of the mean, from the events and from the batches
+    G4double GetError() const;
+    G4double GetBatchError() const;
+    G4double GetNofBatches() const { return GetTotal().batches.n; }
+
+  private:
+    // running count, mean and sum of squared deviations
+    struct Moments
+    {
+      G4double n = 0.;
+      G4double mean = 0.;
+      G4double m2 = 0.;
+
+      void Add(G4double value);
+      void Add(const Moments& other);
+    };
+    struct State
+    {
+      Moments events;
+      Moments batches;    // of the completed batch means
+    };
+
+    void Combine();
+    // this thread's values, or all of them once merged
+    const State& GetTotal() const
+      { return fWorkers.empty() ? fLocal : fTotal; }
+
+    G4int    fThreadId;
+    G4int    fBatchSize;
+    State    fLocal;
+    G4double fBatchSum;
+    G4int    fBatchCount;
+    G4double fLastBatchMean;
+
+    std::map<G4int, State> fWorkers;   // master only
+    State    fTotal;                   // fLocal and fWorkers combined
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
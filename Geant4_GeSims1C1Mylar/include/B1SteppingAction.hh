@@ -34,8 +34,18 @@
 #include "globals.hh"
 
 class B1EventAction;
+class B1PhaseSpaceWriter;
+class B1HitRecorder;
+class B1ChargeCollectionMap;
+class B1Segmentation;
+class B1PulseShapeSimulator;
+class B1TrackKiller;
+class B1ImportanceSampler;
+class B1SlowEventDetector;
+class B1EventWatchdog;
 
 class G4LogicalVolume;
+class G4Step;
 
 /// Stepping action class
 /// 
@@ -50,7 +60,19 @@ class B1SteppingAction : public G4UserSteppingAction
     virtual void UserSteppingAction(const G4Step*);
 
   private:
+    // deposit of the step in the scoring volumes
+    void ScoreStep(const G4Step* step);
+
     B1EventAction*  fEventAction;
+    B1PhaseSpaceWriter* fPhaseSpaceWriter;
+    B1HitRecorder*  fHitRecorder;
+    B1ChargeCollectionMap* fChargeCollectionMap;
+    B1Segmentation* fSegmentation;
+    B1PulseShapeSimulator* fPulseShapeSimulator;
+    B1TrackKiller*  fTrackKiller;
+    B1ImportanceSampler* fImportanceSampler;
+    B1SlowEventDetector* fSlowEventDetector;
+    B1EventWatchdog* fEventWatchdog;
     G4LogicalVolume* fScoringVolume;
     G4LogicalVolume* fScoringVolume1;
     G4LogicalVolume* fScoringVolume2;
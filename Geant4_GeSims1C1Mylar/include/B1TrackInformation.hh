@@ -0,0 +1,57 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackInformation.hh
+/// \brief Definition of the B1TrackInformation class
+
+#ifndef B1TrackInformation_h
+#define B1TrackInformation_h 1
+
+#include "G4VUserTrackInformation.hh"
+#include "globals.hh"
+
+/// Track information attached by the event action to a track whose
+/// branch of the event history is known when it is created: the copies
+/// made by importance sampling, and the secondaries made by a gamma
+/// before it was split. Other tracks take the branch of their parent.
+
+class B1TrackInformation : public G4VUserTrackInformation
+{
+  public:
+    B1TrackInformation(G4int branch);
+    virtual ~B1TrackInformation();
+
+    virtual void Print() const;
+
+    G4int GetBranch() const { return fBranch; }
+
+  private:
+    G4int fBranch;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
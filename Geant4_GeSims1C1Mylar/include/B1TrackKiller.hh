@@ -0,0 +1,177 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackKiller.hh
+/// \brief Definition of the B1TrackKiller class
+
+#ifndef B1TrackKiller_h
+#define B1TrackKiller_h 1
+
+#include "G4Accumulable.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <unordered_set>
+#include <vector>
+
+class B1TrackKillerMessenger;
+class G4AffineTransform;
+class G4LogicalVolume;
+class G4Material;
+class G4VSolid;
+class G4Track;
+class G4Step;
+
+/// Kills tracks that cannot contribute to the scores, from the stacking
+/// and stepping actions. There is one instance per thread.
+///
+/// Electrons are killed when their range is shorter than the distance
+/// from their vertex to the nearest scoring volume (Shape1, Shape2,
+/// Shape3). Both sides are bounded conservatively at the start of each
+/// run:
+///  - the range is the one from the restricted stopping power, longer
+///    than the CSDA range, in the least dense material of the
+///    non-scoring volumes, tabulated in energy and read at the upper
+///    edge of each bin;
+///  - the distance is to the world-frame bounding boxes of the scoring
+///    volumes; for a crystal array the box of the whole array.
+/// Electrons inside a scoring volume and primaries are never killed.
+/// Optionally, secondary photons below an energy cut are killed outside
+/// the scoring volumes. The number and energy of the killed tracks are
+/// reported at the end of run; their bremsstrahlung and fluorescence
+/// are the only losses, to be checked against runs without killing.
+///
+/// Photons, primaries included, are also killed as soon as their
+/// straight line misses a z-aligned cylinder bounding all the scoring
+/// volumes, at creation and after every step. Once a photon heads away
+/// it could only come back by scattering in the air, as there is no
+/// other matter outside the scoring volumes; a warning is given if the
+/// geometry has denser non-scoring volumes. In validation mode nothing
+/// is killed: those photons and their descendants are tagged instead,
+/// and the "Edep1_terminated" spectrum is filled with the Ge deposit
+/// of each event without their contribution, i.e. what killing would
+/// have given, to compare with Edep1 from the same events.
+
+class B1TrackKiller
+{
+  public:
+    static B1TrackKiller* Instance();
+    ~B1TrackKiller();
+
+    void SetKillElectrons(G4bool value)   { fKillElectrons = value; }
+    void SetPhotonCut(G4double energy)    { fPhotonCut = energy; }
+    void SetKillEscapingPhotons(G4bool value) { fEscapingPhotons = value; }
+    void SetValidate(G4bool value)        { fValidate = value; }
+
+    G4bool IsActive() const
+      { return fKillElectrons || fPhotonCut > 0. || fEscapingPhotons; }
+    G4bool IsKillingEscapingPhotons() const { return fEscapingPhotons; }
+    G4bool IsValidating() const { return fEscapingPhotons && fValidate; }
+
+    void BeginOfRun();
+    void BeginOfEvent();
+    // true if the new track is to be killed
+    G4bool KillNewTrack(const G4Track* track);
+    // kills the photons scattered away from the scoring volumes
+    void ProcessStep(const G4Step* step);
+    // validation: Ge deposit of a step, after charge collection, and
+    // of the whole event
+    void AddEdep1(const G4Track* track, G4double edep);
+    void EndOfEvent(G4double edep1);
+    // prints the merged counters (master or sequential)
+    void Print() const;
+
+  private:
+    struct Box
+    {
+      G4ThreeVector min;
+      G4ThreeVector max;
+      // reach in x, y from its z axis through centre
+      G4ThreeVector centre;
+      G4double radius;
+    };
+
+    B1TrackKiller();
+
+    void FindScoringBoxes(const G4LogicalVolume* volume,
+                          const G4AffineTransform& toWorld);
+    void AddBox(const G4VSolid* solid, const G4AffineTransform& toWorld);
+    G4bool IsScoring(const G4LogicalVolume* volume) const;
+    G4bool ContainsScoring(const G4LogicalVolume* volume) const;
+    void BuildRangeTable();
+    void BuildBoundingCylinder();
+    void CheckOtherMaterials() const;
+
+    G4bool CanReachScoring(const G4ThreeVector& point,
+                           const G4ThreeVector& direction) const;
+    // kills (true) or, when validating, tags a photon heading away
+    G4bool TerminatePhoton(const G4Track* track,
+                           const G4ThreeVector& point,
+                           const G4ThreeVector& direction);
+
+    // upper bound of the electron range at this energy
+    G4double GetMaxRange(G4double energy) const;
+    G4double GetDistanceToScoring(const G4ThreeVector& point) const;
+
+    static G4ThreadLocal B1TrackKiller* fInstance;
+
+    G4bool   fKillElectrons;
+    G4double fPhotonCut;
+    G4bool   fEscapingPhotons;
+    G4bool   fValidate;
+
+    std::vector<const G4LogicalVolume*> fScoringVolumes;
+    std::vector<Box> fScoringBoxes;
+
+    const G4Material* fRangeMaterial;
+    std::vector<G4double> fRanges;   // log-spaced energies
+
+    // cylinder around all scoring volumes, along z
+    G4double fCylinderX, fCylinderY, fCylinderRadius;
+    G4double fCylinderZMin, fCylinderZMax;
+
+    // validation: tagged tracks of the event and their Ge deposit
+    std::unordered_set<G4int> fTagged;
+    G4double fTaggedEdep1;
+    G4int    fH1;
+
+    G4Accumulable<G4double> fNofElectrons;
+    G4Accumulable<G4double> fElectronEnergy;
+    G4Accumulable<G4double> fNofKilledElectrons;
+    G4Accumulable<G4double> fKilledElectronEnergy;
+    G4Accumulable<G4double> fNofKilledPhotons;
+    G4Accumulable<G4double> fKilledPhotonEnergy;
+    G4Accumulable<G4double> fNofEscaping;
+    G4Accumulable<G4double> fEscapingEnergy;
+    G4Accumulable<G4double> fNofChangedEvents;
+    G4Accumulable<G4double> fTaggedEdep1Sum;
+
+    B1TrackKillerMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
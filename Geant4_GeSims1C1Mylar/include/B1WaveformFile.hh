@@ -0,0 +1,67 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1WaveformFile.hh
+/// \brief Binary layout of the Ge waveform files
+
+#ifndef B1WaveformFile_h
+#define B1WaveformFile_h 1
+
+#include <cstdint>
+
+/// A waveform file is one B1WaveformFileHeader followed by nofWaveforms
+/// records, each a B1WaveformHeader and nofSamples int16_t samples, in
+/// native byte order. Samples are the induced charge on the readout
+/// contact in ADC units (gain per keV of deposited energy), taken every
+/// samplingPeriod ns from the time of the event. An event with deposits
+/// in several crystals of an array has one record per crystal. Records
+/// are in the order they were synthesised, not by event ID.
+///
+/// This header is shared with stand-alone readers, so it must not
+/// depend on Geant4.
+
+struct B1WaveformFileHeader
+{
+  char     magic[8];       // "B1WAVE01"
+  uint64_t nofWaveforms;
+  double   samplingPeriod; // ns
+  double   gain;           // ADC units per keV
+  uint32_t nofSamples;
+  uint32_t reserved;
+};
+
+struct B1WaveformHeader
+{
+  int32_t eventID;
+  int32_t crystal;         // copy number
+  float   energy;          // deposit in the crystal, keV
+};
+
+static const char kB1WaveformMagic[8] = { 'B','1','W','A','V','E','0','1' };
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
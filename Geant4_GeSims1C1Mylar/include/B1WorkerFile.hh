@@ -0,0 +1,88 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1WorkerFile.hh
+/// \brief Definition of the B1WorkerFile class
+
+#ifndef B1WorkerFile_h
+#define B1WorkerFile_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+
+/// Base class of the binary outputs written by every thread and merged
+/// at the end of the run (B1PhaseSpaceWriter, B1HitRecorder).
+///
+/// Workers write <name>_t<N><ext>, the sequential run manager writes
+/// <name><ext> directly. A file starts with the header of the derived
+/// class, written without counts when the file is opened and rewritten
+/// with the number of entries and of histories when it is closed. At
+/// the end of the run the master concatenates the worker files into
+/// <name><ext>, under one header with the summed counts, and removes
+/// them; an unreadable worker file is skipped with a warning.
+
+class B1WorkerFile
+{
+  public:
+    // kind names the file in the messages, code is the exception code
+    B1WorkerFile(const G4String& kind, const G4String& extension,
+                 const G4String& code);
+    virtual ~B1WorkerFile();
+
+    // the master of an MT run, which only merges the worker files
+    static G4bool IsMasterOfWorkers();
+
+  protected:
+    // worker or sequential; false with a warning when it cannot be opened
+    G4bool OpenFile(const G4String& name);
+    G4bool IsFileOpen() const { return fFile.is_open(); }
+    void   WriteToFile(const void* data, size_t size);
+    void   CloseFile(uint64_t nofEntries, uint64_t nofHistories);
+    // master: the merged counts are returned
+    void   MergeFiles(const G4String& name, uint64_t& nofEntries,
+                      uint64_t& nofHistories) const;
+
+    virtual void   WriteHeader(std::ostream& file, uint64_t nofEntries,
+                               uint64_t nofHistories) const = 0;
+    // false if not a header of the derived class
+    virtual G4bool ReadHeader(std::istream& file, uint64_t& nofEntries,
+                              uint64_t& nofHistories) const = 0;
+
+  private:
+    G4String GetThreadFileName(const G4String& name, G4int threadID) const;
+
+    G4String fKind;
+    G4String fExtension;
+    G4String fCode;
+    std::ofstream fFile;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -32,6 +32,8 @@
 #include "B1RunAction.hh"
 #include "B1EventAction.hh"
 #include "B1SteppingAction.hh"
+#include "B1TrackingAction.hh"
+#include "B1StackingAction.hh"
 #include "B1DetectorConstruction.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -65,6 +67,8 @@ void B1ActionInitialization::Build() const
   B1EventAction* eventAction = new B1EventAction(runAction);
   SetUserAction(eventAction);
   
+  SetUserAction(new B1StackingAction);
+  SetUserAction(new B1TrackingAction(eventAction));
   SetUserAction(new B1SteppingAction(eventAction));
 }  
 
@@ -0,0 +1,68 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointActionInitialization.cc
+/// \brief Implementation of the B1AdjointActionInitialization class
+
+#include "B1AdjointActionInitialization.hh"
+#include "B1PrimaryGeneratorAction.hh"
+#include "B1AdjointRunAction.hh"
+#include "B1AdjointEventAction.hh"
+#include "B1AdjointSteppingAction.hh"
+
+#include "G4AdjointSimManager.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointActionInitialization::B1AdjointActionInitialization()
+ : G4VUserActionInitialization()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointActionInitialization::~B1AdjointActionInitialization()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointActionInitialization::Build() const
+{
+  G4AdjointSimManager* adjointSimManager = G4AdjointSimManager::GetInstance();
+
+  SetUserAction(new B1PrimaryGeneratorAction);
+
+  B1AdjointRunAction* runAction = new B1AdjointRunAction;
+  SetUserAction(runAction);
+  adjointSimManager->SetAdjointRunAction(runAction);
+
+  B1AdjointEventAction* eventAction = new B1AdjointEventAction(runAction);
+  SetUserAction(eventAction);
+  adjointSimManager->SetAdjointEventAction(eventAction);
+
+  SetUserAction(new B1AdjointSteppingAction(eventAction));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
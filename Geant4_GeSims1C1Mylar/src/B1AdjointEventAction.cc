@@ -0,0 +1,76 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointEventAction.cc
+/// \brief Implementation of the B1AdjointEventAction class
+
+#include "B1AdjointEventAction.hh"
+#include "B1AdjointRunAction.hh"
+
+#include "G4AdjointSimManager.hh"
+#include "G4Event.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointEventAction::B1AdjointEventAction(B1AdjointRunAction* runAction)
+: G4UserEventAction(),
+  fRunAction(runAction),
+  fEdep1(0.)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointEventAction::~B1AdjointEventAction()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointEventAction::BeginOfEventAction(const G4Event*)
+{
+  fEdep1 = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointEventAction::EndOfEventAction(const G4Event*)
+{
+  G4AdjointSimManager* adjointSimManager = G4AdjointSimManager::GetInstance();
+  if (!adjointSimManager->GetAdjointSimMode()
+      || !adjointSimManager->GetDidAdjParticleReachTheExtSource()) return;
+
+  // gamma sources only; the electrons are tracked as secondaries
+  if (adjointSimManager->GetFwdParticlePDGEncodingAtEndOfLastAdjointTrack()
+      != 22) return;
+
+  fRunAction->AddSourceHit(
+    adjointSimManager->GetEkinAtEndOfLastAdjointTrack(),
+    fEdep1,
+    adjointSimManager->GetWeightAtEndOfLastAdjointTrack(),
+    adjointSimManager->GetPositionAtEndOfLastAdjointTrack(),
+    adjointSimManager->GetDirectionAtEndOfLastAdjointTrack());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
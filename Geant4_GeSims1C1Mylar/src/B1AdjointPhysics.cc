@@ -0,0 +1,190 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointPhysics.cc
+/// \brief Implementation of the B1AdjointPhysics class
+
+#include "B1AdjointPhysics.hh"
+
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4AdjointGamma.hh"
+#include "G4AdjointElectron.hh"
+#include "G4Geantino.hh"
+#include "G4ChargedGeantino.hh"
+
+#include "G4ProcessManager.hh"
+#include "G4EmParameters.hh"
+#include "G4AdjointCSManager.hh"
+
+#include "G4PhotoElectricEffect.hh"
+#include "G4ComptonScattering.hh"
+#include "G4GammaConversion.hh"
+#include "G4eMultipleScattering.hh"
+#include "G4eIonisation.hh"
+#include "G4eBremsstrahlung.hh"
+#include "G4eplusAnnihilation.hh"
+
+#include "G4AdjointComptonModel.hh"
+#include "G4AdjointPhotoElectricModel.hh"
+#include "G4AdjointBremsstrahlungModel.hh"
+#include "G4AdjointeIonisationModel.hh"
+#include "G4eInverseCompton.hh"
+#include "G4InversePEEffect.hh"
+#include "G4eInverseBremsstrahlung.hh"
+#include "G4eInverseIonisation.hh"
+#include "G4ContinuousGainOfEnergy.hh"
+#include "G4AdjointAlongStepWeightCorrection.hh"
+#include "G4AdjointProcessEquivalentToDirectProcess.hh"
+
+#include "G4SystemOfUnits.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointPhysics::B1AdjointPhysics(G4int verbose)
+: G4VPhysicsConstructor("B1Adjoint")
+{
+  verboseLevel = verbose;
+
+  // the adjoint models have no fluctuations nor deexcitation
+  G4EmParameters* parameters = G4EmParameters::Instance();
+  parameters->SetDefaults();
+  parameters->SetVerbose(verbose);
+  parameters->SetLossFluctuations(false);
+  parameters->SetFluo(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointPhysics::~B1AdjointPhysics()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointPhysics::ConstructParticle()
+{
+  G4Gamma::Gamma();
+  G4Electron::Electron();
+  G4Positron::Positron();
+  G4AdjointGamma::AdjointGamma();
+  G4AdjointElectron::AdjointElectron();
+
+  // default particles of the general particle source
+  G4Geantino::GeantinoDefinition();
+  G4ChargedGeantino::ChargedGeantinoDefinition();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointPhysics::ConstructProcess()
+{
+  G4AdjointCSManager* csManager = G4AdjointCSManager::GetAdjointCSManager();
+
+  // forward processes, the adjoint ones being built from them
+  G4PhotoElectricEffect* photoElectric = new G4PhotoElectricEffect();
+  G4ComptonScattering* compton = new G4ComptonScattering();
+  G4eIonisation* eIonisation = new G4eIonisation();
+  G4eBremsstrahlung* eBremsstrahlung = new G4eBremsstrahlung();
+
+  G4ParticleDefinition* gamma = G4Gamma::Gamma();
+  G4ProcessManager* manager = gamma->GetProcessManager();
+  manager->AddDiscreteProcess(photoElectric);
+  manager->AddDiscreteProcess(compton);
+  manager->AddDiscreteProcess(new G4GammaConversion());
+  csManager->RegisterEmProcess(photoElectric, gamma);
+  csManager->RegisterEmProcess(compton, gamma);
+
+  G4ParticleDefinition* electron = G4Electron::Electron();
+  manager = electron->GetProcessManager();
+  manager->AddProcess(new G4eMultipleScattering(), -1, 1, 1);
+  manager->AddProcess(eIonisation, -1, 2, 2);
+  manager->AddProcess(eBremsstrahlung, -1, -1, 3);
+  csManager->RegisterEnergyLossProcess(eIonisation, electron);
+  csManager->RegisterEnergyLossProcess(eBremsstrahlung, electron);
+
+  G4ParticleDefinition* positron = G4Positron::Positron();
+  manager = positron->GetProcessManager();
+  manager->AddProcess(new G4eMultipleScattering(), -1, 1, 1);
+  manager->AddProcess(new G4eIonisation(), -1, 2, 2);
+  manager->AddProcess(new G4eBremsstrahlung(), -1, -1, 3);
+  manager->AddProcess(new G4eplusAnnihilation(), 0, -1, 4);
+
+  // adjoint processes: "ProjToProj" when the adjoint particle keeps its
+  // type, "ProdToProj" when it is the adjoint of a secondary
+  G4AdjointComptonModel* comptonModel = new G4AdjointComptonModel();
+  comptonModel->SetDirectProcess(compton);
+  comptonModel->SetUseMatrix(false);
+  G4eInverseCompton* inverseComptonProjToProj
+    = new G4eInverseCompton(true, "Inv_Compt", comptonModel);
+  G4eInverseCompton* inverseComptonProdToProj
+    = new G4eInverseCompton(false, "Inv_Compt1", comptonModel);
+
+  G4AdjointPhotoElectricModel* photoElectricModel
+    = new G4AdjointPhotoElectricModel();
+  G4InversePEEffect* inversePhotoElectric
+    = new G4InversePEEffect("Inv_PEEffect", photoElectricModel);
+
+  G4AdjointeIonisationModel* ionisationModel = new G4AdjointeIonisationModel();
+  G4eInverseIonisation* inverseIonisationProjToProj
+    = new G4eInverseIonisation(true, "Inv_eIon", ionisationModel);
+  G4eInverseIonisation* inverseIonisationProdToProj
+    = new G4eInverseIonisation(false, "Inv_eIon1", ionisationModel);
+
+  G4AdjointBremsstrahlungModel* bremsstrahlungModel
+    = new G4AdjointBremsstrahlungModel();
+  G4eInverseBremsstrahlung* inverseBremsstrahlungProjToProj
+    = new G4eInverseBremsstrahlung(true, "Inv_eBrem", bremsstrahlungModel);
+  G4eInverseBremsstrahlung* inverseBremsstrahlungProdToProj
+    = new G4eInverseBremsstrahlung(false, "Inv_eBrem1", bremsstrahlungModel);
+
+  G4ContinuousGainOfEnergy* gainOfEnergy = new G4ContinuousGainOfEnergy();
+  gainOfEnergy->SetLossFluctuations(false);
+  gainOfEnergy->SetDirectEnergyLossProcess(eIonisation);
+  gainOfEnergy->SetDirectParticle(electron);
+
+  G4ParticleDefinition* adjointElectron = G4AdjointElectron::AdjointElectron();
+  manager = adjointElectron->GetProcessManager();
+  manager->AddProcess(gainOfEnergy, -1, 1, 1);
+  manager->AddProcess(
+    new G4AdjointProcessEquivalentToDirectProcess("msc",
+          new G4eMultipleScattering(), electron), -1, 2, -1);
+  manager->AddProcess(new G4AdjointAlongStepWeightCorrection(), -1, 3, -1);
+  manager->AddDiscreteProcess(inverseIonisationProjToProj);
+  manager->AddDiscreteProcess(inverseIonisationProdToProj);
+  manager->AddDiscreteProcess(inverseBremsstrahlungProjToProj);
+  manager->AddDiscreteProcess(inverseComptonProdToProj);
+  manager->AddDiscreteProcess(inversePhotoElectric);
+  csManager->RegisterAdjointParticle(adjointElectron);
+
+  G4ParticleDefinition* adjointGamma = G4AdjointGamma::AdjointGamma();
+  manager = adjointGamma->GetProcessManager();
+  manager->AddDiscreteProcess(inverseComptonProjToProj);
+  manager->AddDiscreteProcess(inverseBremsstrahlungProdToProj);
+  csManager->RegisterAdjointParticle(adjointGamma);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
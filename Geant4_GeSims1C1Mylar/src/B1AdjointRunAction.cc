@@ -0,0 +1,215 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointRunAction.cc
+/// \brief Implementation of the B1AdjointRunAction class
+
+#include "B1AdjointRunAction.hh"
+#include "B1AdjointRunActionMessenger.hh"
+#include "B1Analysis.hh"
+
+#include "G4AdjointSimManager.hh"
+#include "G4Run.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+
+#include <cmath>
+
+namespace {
+  // source energy binning of the response histograms
+  const G4int kNofBins = 3000;
+  const G4double kEmax = 3.*MeV;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointRunAction::B1AdjointRunAction()
+: G4UserRunAction(),
+  fLines(),
+  fWindow(1.*keV),
+  fSourceRadius(0.),
+  fNofEvents(0.),
+  fNofSourceHits(0.),
+  fTotal(),
+  fTotal2(),
+  fPeak(),
+  fPeak2(),
+  fH1(-1),
+  fH2(-1),
+  fNtuple(-1),
+  fMessenger(0)
+{
+  fMessenger = new B1AdjointRunActionMessenger(this);
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  G4cout << "Using " << analysisManager->GetType() << G4endl;
+  analysisManager->SetVerboseLevel(1);
+  analysisManager->SetFileName("LArGe_adjoint");
+
+  fH1 = analysisManager->CreateH1("AdjointTotal",
+          "Ge response per unit fluence, any deposit (mm2)",
+          kNofBins, 0., kEmax);
+  analysisManager->CreateH1("AdjointFullEnergy",
+          "Ge response per unit fluence, full-energy deposit (mm2)",
+          kNofBins, 0., kEmax);
+  fH2 = analysisManager->CreateH2("AdjointResponse",
+          "Adjoint weight by source energy and Ge deposit",
+          300, 0., kEmax, 300, 0., kEmax);
+
+  fNtuple = analysisManager->CreateNtuple("Adjoint",
+              "Adjoint gammas reaching the source");
+  analysisManager->CreateNtupleDColumn("Esource");
+  analysisManager->CreateNtupleDColumn("Edep1");
+  analysisManager->CreateNtupleDColumn("weight");
+  analysisManager->CreateNtupleDColumn("x");
+  analysisManager->CreateNtupleDColumn("y");
+  analysisManager->CreateNtupleDColumn("z");
+  analysisManager->CreateNtupleDColumn("dx");
+  analysisManager->CreateNtupleDColumn("dy");
+  analysisManager->CreateNtupleDColumn("dz");
+  analysisManager->FinishNtuple();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointRunAction::~B1AdjointRunAction()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointRunAction::BeginOfRunAction(const G4Run*)
+{
+  fNofEvents = G4AdjointSimManager::GetInstance()->GetNbEvtOfLastRun();
+  fNofSourceHits = 0.;
+  fTotal.assign(fLines.size(), 0.);
+  fTotal2.assign(fLines.size(), 0.);
+  fPeak.assign(fLines.size(), 0.);
+  fPeak2.assign(fLines.size(), 0.);
+
+  G4AnalysisManager::Instance()->OpenFile();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointRunAction::AddSourceHit(G4double sourceEnergy, G4double edep1,
+                                      G4double weight,
+                                      const G4ThreeVector& position,
+                                      const G4ThreeVector& direction)
+{
+  if (fNofEvents <= 0.) return;
+
+  fNofSourceHits += 1.;
+  G4bool fullEnergy = std::fabs(edep1 - sourceEnergy) < 0.5*fWindow;
+  G4double w = weight/fNofEvents;
+
+  // per unit line fluence: the source energies are spread over the bin
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  G4double binWidth = kEmax/kNofBins;
+  if (edep1 > 0.) analysisManager->FillH1(fH1, sourceEnergy, w/binWidth);
+  if (fullEnergy) analysisManager->FillH1(fH1+1, sourceEnergy, w/binWidth);
+  analysisManager->FillH2(fH2, sourceEnergy, edep1, w);
+
+  analysisManager->FillNtupleDColumn(fNtuple, 0, sourceEnergy);
+  analysisManager->FillNtupleDColumn(fNtuple, 1, edep1);
+  analysisManager->FillNtupleDColumn(fNtuple, 2, w);
+  for (G4int i = 0; i < 3; ++i) {
+    analysisManager->FillNtupleDColumn(fNtuple, 3+i, position[i]);
+    analysisManager->FillNtupleDColumn(fNtuple, 6+i, direction[i]);
+  }
+  analysisManager->AddNtupleRow(fNtuple);
+
+  if (edep1 <= 0.) return;
+  for (size_t k = 0; k < fLines.size(); ++k) {
+    if (std::fabs(sourceEnergy - fLines[k]) >= 0.5*fWindow) continue;
+    fTotal[k] += weight;
+    fTotal2[k] += weight*weight;
+    if (fullEnergy) {
+      fPeak[k] += weight;
+      fPeak2[k] += weight*weight;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointRunAction::EndOfRunAction(const G4Run*)
+{
+  G4cout
+     << G4endl
+     << "--------------------End of Adjoint Run-----------------------"
+     << G4endl
+     << " Adjoint events " << fNofEvents
+     << ", reaching the source " << fNofSourceHits
+     << G4endl;
+  PrintLines();
+  G4cout
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  analysisManager->Write();
+  analysisManager->CloseFile();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointRunAction::PrintLines() const
+{
+  if (fLines.empty() || fNofEvents <= 0.) return;
+
+  // line fluence spread over the window
+  G4double norm = 1./(fNofEvents*fWindow);
+  G4double area = pi*fSourceRadius*fSourceRadius;
+
+  G4cout << " Response per unit line fluence (source window "
+         << G4BestUnit(fWindow,"Energy") << "):" << G4endl;
+  for (size_t k = 0; k < fLines.size(); ++k) {
+    G4double total = fTotal[k]*norm;
+    G4double peak = fPeak[k]*norm;
+    G4double totalError = std::sqrt(fTotal2[k])*norm;
+    G4double peakError = std::sqrt(fPeak2[k])*norm;
+    G4cout
+       << "  " << G4BestUnit(fLines[k],"Energy")
+       << " : full energy " << G4BestUnit(peak,"Surface")
+       << " +- " << G4BestUnit(peakError,"Surface")
+       << ", total " << G4BestUnit(total,"Surface")
+       << " +- " << G4BestUnit(totalError,"Surface")
+       << G4endl;
+    if (area > 0.) {
+      G4cout
+         << "      FEP efficiency " << peak/area << " +- " << peakError/area
+         << ", total efficiency " << total/area << " +- " << totalError/area
+         << " (source sphere " << G4BestUnit(fSourceRadius,"Length") << ")"
+         << G4endl;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
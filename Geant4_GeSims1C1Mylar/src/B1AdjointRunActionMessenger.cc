@@ -0,0 +1,107 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AdjointRunActionMessenger.cc
+/// \brief Implementation of the B1AdjointRunActionMessenger class
+
+#include "B1AdjointRunActionMessenger.hh"
+#include "B1AdjointRunAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointRunActionMessenger::B1AdjointRunActionMessenger(
+                               B1AdjointRunAction* runAction)
+: G4UImessenger(),
+  fRunAction(runAction)
+{
+  fAdjointDir = new G4UIdirectory("/B1/adjoint/");
+  fAdjointDir->SetGuidance("Scoring of the reverse Monte Carlo mode");
+
+  fLineCmd = new G4UIcmdWithADoubleAndUnit("/B1/adjoint/line",this);
+  fLineCmd->SetGuidance("Print the responses at this source energy.");
+  fLineCmd->SetParameterName("energy",false);
+  fLineCmd->SetRange("energy>0.");
+  fLineCmd->SetUnitCategory("Energy");
+  fLineCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearLinesCmd = new G4UIcmdWithoutParameter("/B1/adjoint/clearLines",this);
+  fClearLinesCmd->SetGuidance("Remove all the lines.");
+  fClearLinesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fWindowCmd = new G4UIcmdWithADoubleAndUnit("/B1/adjoint/window",this);
+  fWindowCmd->SetGuidance("Width of the source energy window of a line,");
+  fWindowCmd->SetGuidance("and tolerance of a full-energy deposit.");
+  fWindowCmd->SetParameterName("window",false);
+  fWindowCmd->SetRange("window>0.");
+  fWindowCmd->SetUnitCategory("Energy");
+  fWindowCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSourceRadiusCmd
+    = new G4UIcmdWithADoubleAndUnit("/B1/adjoint/sourceRadius",this);
+  fSourceRadiusCmd->SetGuidance("Radius of the spherical external source,");
+  fSourceRadiusCmd->SetGuidance("to print efficiencies per emitted gamma.");
+  fSourceRadiusCmd->SetGuidance("0 prints the responses only.");
+  fSourceRadiusCmd->SetParameterName("radius",false);
+  fSourceRadiusCmd->SetRange("radius>=0.");
+  fSourceRadiusCmd->SetUnitCategory("Length");
+  fSourceRadiusCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AdjointRunActionMessenger::~B1AdjointRunActionMessenger()
+{
+  delete fLineCmd;
+  delete fClearLinesCmd;
+  delete fWindowCmd;
+  delete fSourceRadiusCmd;
+  delete fAdjointDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AdjointRunActionMessenger::SetNewValue(G4UIcommand* command,
+                                              G4String newValue)
+{
+  if (command == fLineCmd) {
+    fRunAction->AddLine(fLineCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fClearLinesCmd) {
+    fRunAction->ClearLines();
+  }
+  else if (command == fWindowCmd) {
+    fRunAction->SetWindow(fWindowCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fSourceRadiusCmd) {
+    fRunAction->SetSourceRadius(fSourceRadiusCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
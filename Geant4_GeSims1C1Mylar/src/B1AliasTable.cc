@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AliasTable.cc
+/// \brief Implementation of the B1AliasTable class
+
+#include "B1AliasTable.hh"
+
+#include "Randomize.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AliasTable::B1AliasTable()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AliasTable::~B1AliasTable()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AliasTable::Build(const std::vector<G4double>& weights)
+{
+  Clear();
+
+  G4double sum = 0.;
+  for (size_t i = 0; i < weights.size(); ++i) {
+    if (weights[i] < 0.) {
+      G4ExceptionDescription msg;
+      msg << "Negative weight " << weights[i] << " at index " << i << ".";
+      G4Exception("B1AliasTable::Build()", "MyCode0003",
+                  FatalErrorInArgument, msg);
+    }
+    sum += weights[i];
+  }
+  if (sum <= 0.) {
+    G4Exception("B1AliasTable::Build()", "MyCode0003",
+                FatalErrorInArgument, "Sum of weights is zero.");
+  }
+
+  // Vose's variant of Walker's method: split the scaled probabilities
+  // into a "small" and a "large" work list and pair them up.
+  //
+  const size_t n = weights.size();
+  fCut.resize(n);
+  fAlias.resize(n);
+  fProb.resize(n);
+
+  std::vector<G4int> small, large;
+  for (size_t i = 0; i < n; ++i) {
+    fProb[i] = weights[i]/sum;
+    fCut[i]  = fProb[i]*n;
+    fAlias[i] = i;
+    if (fCut[i] < 1.) small.push_back(i); else large.push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    G4int s = small.back(); small.pop_back();
+    G4int l = large.back();
+    fAlias[s] = l;
+    fCut[l] -= 1. - fCut[s];
+    if (fCut[l] < 1.) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+
+  // Whatever is left over is 1 up to rounding
+  for (size_t i = 0; i < large.size(); ++i) fCut[large[i]] = 1.;
+  for (size_t i = 0; i < small.size(); ++i) fCut[small[i]] = 1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AliasTable::Clear()
+{
+  fCut.clear();
+  fAlias.clear();
+  fProb.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1AliasTable::Sample() const
+{
+  return Sample(G4UniformRand());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1AliasTable::Sample(G4double rand) const
+{
+  // The integer part of rand*n picks the column, the fractional part
+  // decides between the column and its alias.
+  G4double x = rand*fCut.size();
+  G4int i = G4int(x);
+  if (i >= G4int(fCut.size())) i = fCut.size() - 1;
+  return (x - i < fCut[i]) ? i : fAlias[i];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,204 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AnalyticSource.cc
+/// \brief Implementation of the B1AnalyticSource class
+
+#include "B1AnalyticSource.hh"
+#include "B1AnalyticSourceMessenger.hh"
+
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4Gamma.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+#include <cfloat>
+
+namespace {
+  // distance to the slab |x| <= half from inside it, along dx
+  G4double DistanceToSlab(G4double x, G4double dx, G4double half)
+  {
+    if (dx > 0.) return (half - x)/dx;
+    if (dx < 0.) return (-half - x)/dx;
+    return DBL_MAX;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AnalyticSource::B1AnalyticSource()
+: G4VPrimaryGenerator(),
+  fParticle(G4Gamma::Definition()),
+  fEnergy(1332.501*keV),
+  fShape(kPoint),
+  fCentre(),
+  fAxis(0.,0.,1.),
+  fRadius(0.),
+  fHalfX(0.),
+  fHalfY(0.),
+  fHalfZ(0.),
+  fAngular(kIsotropic),
+  fDirection(0.,0.,-1.),
+  fCosCone(-1.),
+  fMessenger(0)
+{
+  fMessenger = new B1AnalyticSourceMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AnalyticSource::~B1AnalyticSource()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AnalyticSource::GeneratePrimaryVertex(G4Event* event)
+{
+  G4PrimaryVertex* vertex = new G4PrimaryVertex(SamplePosition(), 0.);
+
+  G4PrimaryParticle* primary = new G4PrimaryParticle(fParticle);
+  primary->SetKineticEnergy(fEnergy);
+  primary->SetMomentumDirection(SampleDirection());
+  vertex->SetPrimary(primary);
+
+  event->AddPrimaryVertex(vertex);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AnalyticSource::SetShape(const G4String& shape)
+{
+  if      (shape == "point")    fShape = kPoint;
+  else if (shape == "disk")     fShape = kDisk;
+  else if (shape == "cylinder") fShape = kCylinder;
+  else if (shape == "box")      fShape = kBox;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AnalyticSource::SetAngular(const G4String& angular)
+{
+  if      (angular == "iso")  fAngular = kIsotropic;
+  else if (angular == "cone") fAngular = kCone;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AnalyticSource::SetConeAngle(G4double angle)
+{
+  fCosCone = std::cos(angle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector B1AnalyticSource::SamplePosition() const
+{
+  if (fShape == kPoint) return fCentre;
+
+  G4ThreeVector local;
+  if (fShape == kBox) {
+    local.set(fHalfX*(2.*G4UniformRand() - 1.),
+              fHalfY*(2.*G4UniformRand() - 1.),
+              fHalfZ*(2.*G4UniformRand() - 1.));
+  }
+  else {
+    // uniform in area: r = R*sqrt(u)
+    G4double r = fRadius*std::sqrt(G4UniformRand());
+    G4double phi = twopi*G4UniformRand();
+    G4double z = (fShape == kCylinder) ? fHalfZ*(2.*G4UniformRand() - 1.) : 0.;
+    local.set(r*std::cos(phi), r*std::sin(phi), z);
+  }
+  return fCentre + local.rotateUz(fAxis);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector B1AnalyticSource::SampleDirection() const
+{
+  // isotropic is the cone with cos(angle) = -1
+  G4double cosMin = (fAngular == kCone) ? fCosCone : -1.;
+  G4double cosTheta = 1. - G4UniformRand()*(1. - cosMin);
+  G4double sinTheta = std::sqrt(std::max(0., 1. - cosTheta*cosTheta));
+  G4double phi = twopi*G4UniformRand();
+
+  G4ThreeVector dir(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+  if (fAngular == kCone) dir.rotateUz(fDirection);
+  return dir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1AnalyticSource::DistanceToOut(const G4ThreeVector& position,
+                                         const G4ThreeVector& direction) const
+{
+  if (fShape == kPoint || fShape == kDisk) return 0.;
+
+  // local frame of SamplePosition()
+  G4ThreeVector offset = position - fCentre;
+  G4double z = offset.dot(fAxis);
+  G4double dz = direction.dot(fAxis);
+  G4double distance = DistanceToSlab(z, dz, fHalfZ);
+
+  if (fShape == kBox) {
+    G4ThreeVector xAxis = G4ThreeVector(1., 0., 0.).rotateUz(fAxis);
+    G4ThreeVector yAxis = G4ThreeVector(0., 1., 0.).rotateUz(fAxis);
+    distance = std::min(distance, DistanceToSlab(offset.dot(xAxis),
+                                    direction.dot(xAxis), fHalfX));
+    distance = std::min(distance, DistanceToSlab(offset.dot(yAxis),
+                                    direction.dot(yAxis), fHalfY));
+  }
+  else {
+    // |r + t*dr| = R, r inside
+    G4ThreeVector r = offset - z*fAxis;
+    G4ThreeVector dr = direction - dz*fAxis;
+    G4double a = dr.mag2();
+    if (a > 0.) {
+      G4double b = r.dot(dr);
+      G4double c = r.mag2() - fRadius*fRadius;
+      distance = std::min(distance,
+                          (-b + std::sqrt(std::max(0., b*b - a*c)))/a);
+    }
+  }
+  return std::max(0., distance);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1AnalyticSource::GetMaxPathLength() const
+{
+  if (fShape == kBox) {
+    return 2.*std::sqrt(fHalfX*fHalfX + fHalfY*fHalfY + fHalfZ*fHalfZ);
+  }
+  if (fShape == kCylinder) return 2.*std::sqrt(fRadius*fRadius + fHalfZ*fHalfZ);
+  return 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
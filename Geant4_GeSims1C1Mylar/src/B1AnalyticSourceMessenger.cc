@@ -0,0 +1,197 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1AnalyticSourceMessenger.cc
+/// \brief Implementation of the B1AnalyticSourceMessenger class
+
+#include "B1AnalyticSourceMessenger.hh"
+#include "B1AnalyticSource.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWith3Vector.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+#include "G4ParticleTable.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AnalyticSourceMessenger::B1AnalyticSourceMessenger(B1AnalyticSource* source)
+: G4UImessenger(),
+  fSource(source)
+{
+  fGunDir = new G4UIdirectory("/B1/gun/");
+  fGunDir->SetGuidance("Analytic source (used with /B1/source/generator analytic)");
+
+  fParticleCmd = new G4UIcmdWithAString("/B1/gun/particle",this);
+  fParticleCmd->SetGuidance("Set the primary particle.");
+  fParticleCmd->SetParameterName("particleName",false);
+  fParticleCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fEnergyCmd = new G4UIcmdWithADoubleAndUnit("/B1/gun/energy",this);
+  fEnergyCmd->SetGuidance("Set the mono energy (overridden by energyMode lines).");
+  fEnergyCmd->SetParameterName("energy",false);
+  fEnergyCmd->SetRange("energy>0.");
+  fEnergyCmd->SetUnitCategory("Energy");
+  fEnergyCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fShapeCmd = new G4UIcmdWithAString("/B1/gun/shape",this);
+  fShapeCmd->SetGuidance("Set the source shape.");
+  fShapeCmd->SetParameterName("shape",false);
+  fShapeCmd->SetCandidates("point disk cylinder box");
+  fShapeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fCentreCmd = new G4UIcmdWith3VectorAndUnit("/B1/gun/centre",this);
+  fCentreCmd->SetGuidance("Set the centre of the source.");
+  fCentreCmd->SetParameterName("x","y","z",false);
+  fCentreCmd->SetUnitCategory("Length");
+  fCentreCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fAxisCmd = new G4UIcmdWith3Vector("/B1/gun/axis",this);
+  fAxisCmd->SetGuidance("Set the source axis (disk normal, cylinder axis,");
+  fAxisCmd->SetGuidance("local z of a box).");
+  fAxisCmd->SetParameterName("ux","uy","uz",false);
+  fAxisCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fRadiusCmd = new G4UIcmdWithADoubleAndUnit("/B1/gun/radius",this);
+  fRadiusCmd->SetGuidance("Set the radius of a disk or cylinder source.");
+  fRadiusCmd->SetParameterName("radius",false);
+  fRadiusCmd->SetRange("radius>=0.");
+  fRadiusCmd->SetUnitCategory("Length");
+  fRadiusCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fHalfXCmd = new G4UIcmdWithADoubleAndUnit("/B1/gun/halfx",this);
+  fHalfXCmd->SetGuidance("Set the local x half length of a box source.");
+  fHalfXCmd->SetParameterName("halfx",false);
+  fHalfXCmd->SetRange("halfx>=0.");
+  fHalfXCmd->SetUnitCategory("Length");
+  fHalfXCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fHalfYCmd = new G4UIcmdWithADoubleAndUnit("/B1/gun/halfy",this);
+  fHalfYCmd->SetGuidance("Set the local y half length of a box source.");
+  fHalfYCmd->SetParameterName("halfy",false);
+  fHalfYCmd->SetRange("halfy>=0.");
+  fHalfYCmd->SetUnitCategory("Length");
+  fHalfYCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fHalfZCmd = new G4UIcmdWithADoubleAndUnit("/B1/gun/halfz",this);
+  fHalfZCmd->SetGuidance("Set the half length along the axis of a cylinder");
+  fHalfZCmd->SetGuidance("or box source.");
+  fHalfZCmd->SetParameterName("halfz",false);
+  fHalfZCmd->SetRange("halfz>=0.");
+  fHalfZCmd->SetUnitCategory("Length");
+  fHalfZCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fAngularCmd = new G4UIcmdWithAString("/B1/gun/angular",this);
+  fAngularCmd->SetGuidance("Set the angular distribution.");
+  fAngularCmd->SetParameterName("type",false);
+  fAngularCmd->SetCandidates("iso cone");
+  fAngularCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fDirectionCmd = new G4UIcmdWith3Vector("/B1/gun/direction",this);
+  fDirectionCmd->SetGuidance("Set the cone axis.");
+  fDirectionCmd->SetParameterName("ux","uy","uz",false);
+  fDirectionCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fConeAngleCmd = new G4UIcmdWithADoubleAndUnit("/B1/gun/coneAngle",this);
+  fConeAngleCmd->SetGuidance("Set the cone half angle.");
+  fConeAngleCmd->SetParameterName("angle",false);
+  fConeAngleCmd->SetRange("angle>=0.");
+  fConeAngleCmd->SetUnitCategory("Angle");
+  fConeAngleCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1AnalyticSourceMessenger::~B1AnalyticSourceMessenger()
+{
+  delete fParticleCmd;
+  delete fEnergyCmd;
+  delete fShapeCmd;
+  delete fCentreCmd;
+  delete fAxisCmd;
+  delete fRadiusCmd;
+  delete fHalfXCmd;
+  delete fHalfYCmd;
+  delete fHalfZCmd;
+  delete fAngularCmd;
+  delete fDirectionCmd;
+  delete fConeAngleCmd;
+  delete fGunDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1AnalyticSourceMessenger::SetNewValue(G4UIcommand* command,
+                                            G4String newValue)
+{
+  if (command == fParticleCmd) {
+    G4ParticleDefinition* particle
+      = G4ParticleTable::GetParticleTable()->FindParticle(newValue);
+    if (particle) fSource->SetParticleDefinition(particle);
+    else {
+      G4ExceptionDescription msg;
+      msg << "Unknown particle " << newValue << ".";
+      G4Exception("B1AnalyticSourceMessenger::SetNewValue()",
+       "MyCode0005",JustWarning,msg);
+    }
+  }
+  else if (command == fEnergyCmd) {
+    fSource->SetEnergy(fEnergyCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fShapeCmd) {
+    fSource->SetShape(newValue);
+  }
+  else if (command == fCentreCmd) {
+    fSource->SetCentre(fCentreCmd->GetNew3VectorValue(newValue));
+  }
+  else if (command == fAxisCmd) {
+    fSource->SetAxis(fAxisCmd->GetNew3VectorValue(newValue));
+  }
+  else if (command == fRadiusCmd) {
+    fSource->SetRadius(fRadiusCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fHalfXCmd) {
+    fSource->SetHalfX(fHalfXCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fHalfYCmd) {
+    fSource->SetHalfY(fHalfYCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fHalfZCmd) {
+    fSource->SetHalfZ(fHalfZCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fAngularCmd) {
+    fSource->SetAngular(newValue);
+  }
+  else if (command == fDirectionCmd) {
+    fSource->SetDirection(fDirectionCmd->GetNew3VectorValue(newValue));
+  }
+  else if (command == fConeAngleCmd) {
+    fSource->SetConeAngle(fConeAngleCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
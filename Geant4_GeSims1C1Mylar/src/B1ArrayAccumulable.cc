@@ -0,0 +1,77 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ArrayAccumulable.cc
+/// \brief Implementation of the B1ArrayAccumulable class
+
+#include "B1ArrayAccumulable.hh"
+
+#include <algorithm>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ArrayAccumulable::B1ArrayAccumulable(const G4String& name)
+: G4VAccumulable(name),
+  fValues()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ArrayAccumulable::~B1ArrayAccumulable()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ArrayAccumulable::Merge(const G4VAccumulable& other)
+{
+  const B1ArrayAccumulable& otherArray
+    = static_cast<const B1ArrayAccumulable&>(other);
+
+  if (otherArray.fValues.size() > fValues.size()) {
+    fValues.resize(otherArray.fValues.size(), 0.);
+  }
+  for (size_t i = 0; i < otherArray.fValues.size(); ++i) {
+    fValues[i] += otherArray.fValues[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ArrayAccumulable::Reset()
+{
+  std::fill(fValues.begin(), fValues.end(), 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ArrayAccumulable::Add(G4int i, G4double value)
+{
+  if (i < 0) return;
+  if (i >= G4int(fValues.size())) fValues.resize(i+1, 0.);
+  fValues[i] += value;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,220 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1Benchmark.cc
+/// \brief Implementation of the B1Benchmark class
+
+#include "B1Benchmark.hh"
+
+#include "G4Timer.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+  G4Timer  gJobTimer;
+  G4Timer  gRunTimer;
+  G4String gPhysicsListName = "QBBC";
+  G4String gReportFile;
+  G4double gInitTime = -1.;
+
+  struct Report
+  {
+    G4String name;
+    G4double initTime = 0.;
+    G4double nofEvents = 0.;
+    G4double runTime = 0.;
+    G4double eventsPerSecond = 0.;
+    G4double memory = 0.;
+    G4double efficiency = 0.;
+    G4double error = 0.;
+  };
+
+  // the last run reported in a file
+  G4bool ReadReport(const G4String& fileName, Report& report)
+  {
+    std::ifstream file(fileName);
+    std::string line, last;
+    while (std::getline(file, line)) {
+      if (!line.empty() && line[0] != '#') last = line;
+    }
+    std::istringstream input(last);
+    std::string name;
+    input >> name >> report.initTime >> report.nofEvents >> report.runTime
+          >> report.eventsPerSecond >> report.memory
+          >> report.efficiency >> report.error;
+    report.name = name;
+    return bool(input);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Benchmark::Start(const G4String& physicsListName)
+{
+  gPhysicsListName = physicsListName;
+  gJobTimer.Start();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Benchmark::SetReportFile(const G4String& fileName)
+{
+  gReportFile = fileName;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const G4String& B1Benchmark::GetReportFile()
+{
+  return gReportFile;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Benchmark::BeginOfRun()
+{
+  if (gInitTime < 0.) {
+    gJobTimer.Stop();
+    gInitTime = gJobTimer.GetRealElapsed();
+  }
+  gRunTimer.Start();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1Benchmark::GetRunTime()
+{
+  return gRunTimer.GetRealElapsed();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Benchmark::EndOfRun(G4int nofEvents, G4double nofFullEnergyEvents)
+{
+  gRunTimer.Stop();
+  if (gReportFile.empty() || nofEvents == 0) return;
+
+  G4double runTime = gRunTimer.GetRealElapsed();
+  G4double efficiency = nofFullEnergyEvents/nofEvents;
+  G4double error = std::sqrt(efficiency*(1.-efficiency)/nofEvents);
+
+  std::ofstream file(gReportFile, std::ios::app);
+  file << gPhysicsListName << " " << gInitTime << " " << nofEvents << " "
+       << runTime << " " << (runTime > 0. ? nofEvents/runTime : 0.) << " "
+       << GetMaxResidentMemory() << " "
+       << std::setprecision(8) << efficiency << " " << error << std::endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1Benchmark::Compare(const G4String& program,
+                           const std::vector<G4String>& physicsLists,
+                           const G4String& macro)
+{
+  std::vector<Report> reports;
+  for (size_t i = 0; i < physicsLists.size(); ++i) {
+    const G4String& name = physicsLists[i];
+    G4String reportFile = "compare_" + name + ".report";
+    G4String logFile = "compare_" + name + ".log";
+    std::remove(reportFile.c_str());
+
+    G4String command = "\"" + program + "\" -p " + name + " -r " + reportFile
+                     + " " + macro + " > " + logFile + " 2>&1";
+    G4cout << "Running " << macro << " with " << name
+           << " (log in " << logFile << ")" << G4endl;
+    G4int status = std::system(command.c_str());
+
+    Report report;
+    if (status != 0 || !ReadReport(reportFile, report)) {
+      G4ExceptionDescription msg;
+      msg << "No report for physics list " << name << ", see " << logFile;
+      G4Exception("B1Benchmark::Compare()", "MyCode0012", JustWarning, msg);
+      continue;
+    }
+    reports.push_back(report);
+  }
+  if (reports.empty()) return 1;
+
+  // differences to the first list, in absolute and in standard deviations
+  const Report& reference = reports[0];
+  G4cout
+     << G4endl
+     << "------------------ Physics list comparison ------------------"
+     << G4endl
+     << std::setw(16) << "list" << std::setw(10) << "init(s)"
+     << std::setw(12) << "events/s" << std::setw(10) << "RSS(MB)"
+     << std::setw(14) << "FEP eff" << std::setw(12) << "+-"
+     << std::setw(12) << "diff" << std::setw(9) << "sigma"
+     << G4endl;
+  for (size_t i = 0; i < reports.size(); ++i) {
+    const Report& report = reports[i];
+    G4double diff = report.efficiency - reference.efficiency;
+    G4double sigma = std::sqrt(report.error*report.error
+                               + reference.error*reference.error);
+    G4cout
+       << std::setw(16) << report.name
+       << std::setw(10) << std::setprecision(3) << report.initTime
+       << std::setw(12) << std::setprecision(4) << report.eventsPerSecond
+       << std::setw(10) << std::setprecision(4) << report.memory
+       << std::setw(14) << std::setprecision(5) << report.efficiency
+       << std::setw(12) << std::setprecision(2) << report.error
+       << std::setw(12) << std::setprecision(2) << diff
+       << std::setw(9) << std::setprecision(2)
+       << (sigma > 0. ? diff/sigma : 0.)
+       << G4endl;
+  }
+  G4cout
+     << "-------------------------------------------------------------"
+     << G4endl;
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1Benchmark::GetMaxResidentMemory()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.;
+#if defined(__APPLE__)
+  return usage.ru_maxrss/(1024.*1024.);   // bytes
+#else
+  return usage.ru_maxrss/1024.;           // kilobytes
+#endif
+#else
+  return 0.;
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,152 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ChargeCollectionMap.cc
+/// \brief Implementation of the B1ChargeCollectionMap class
+
+#include "B1ChargeCollectionMap.hh"
+#include "B1ChargeCollectionMapMessenger.hh"
+
+#include "G4Step.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4Threading.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+#include <sstream>
+
+G4ThreadLocal B1ChargeCollectionMap* B1ChargeCollectionMap::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ChargeCollectionMap* B1ChargeCollectionMap::Instance()
+{
+  if (!fInstance) fInstance = new B1ChargeCollectionMap();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ChargeCollectionMap::B1ChargeCollectionMap()
+: fActive(false),
+  fFileName(),
+  fNofR(0), fNofZ(0),
+  fRMin(0.), fZMin(0.),
+  fInvDR(0.), fInvDZ(0.),
+  fValues(),
+  fMessenger(0)
+{
+  fMessenger = new B1ChargeCollectionMapMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ChargeCollectionMap::~B1ChargeCollectionMap()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1ChargeCollectionMap::Load(const G4String& fileName)
+{
+  std::ifstream file(fileName);
+  if (!file) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open charge collection map " << fileName << ".";
+    G4Exception("B1ChargeCollectionMap::Load()",
+                "MyCode0009", JustWarning, msg);
+    return false;
+  }
+
+  // all numbers of the file, comments stripped
+  std::vector<G4double> numbers;
+  std::string line;
+  while (std::getline(file, line)) {
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) line.erase(comment);
+    std::istringstream input(line);
+    G4double value;
+    while (input >> value) numbers.push_back(value);
+  }
+
+  G4int nofR = numbers.size() >= 6 ? G4int(numbers[0]) : 0;
+  G4int nofZ = numbers.size() >= 6 ? G4int(numbers[3]) : 0;
+  if (nofR < 2 || nofZ < 2 || numbers.size() != 6 + size_t(nofR*nofZ)
+      || numbers[2] <= numbers[1] || numbers[5] <= numbers[4]) {
+    G4ExceptionDescription msg;
+    msg << "Bad charge collection map " << fileName
+        << ": expected nr rmin rmax nz zmin zmax and nr*nz values"
+        << " with nr, nz >= 2.";
+    G4Exception("B1ChargeCollectionMap::Load()",
+                "MyCode0009", JustWarning, msg);
+    return false;
+  }
+
+  fNofR = nofR;
+  fNofZ = nofZ;
+  fRMin = numbers[1]*mm;
+  fZMin = numbers[4]*mm;
+  fInvDR = (nofR-1)/(numbers[2]*mm - fRMin);
+  fInvDZ = (nofZ-1)/(numbers[5]*mm - fZMin);
+  fValues.assign(numbers.begin()+6, numbers.end());
+  fFileName = fileName;
+  fActive = true;
+
+  if (G4Threading::G4GetThreadId() <= 0) {
+    G4cout << "Loaded " << fNofR << " x " << fNofZ
+           << " (r, z) charge collection map from " << fileName << G4endl;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ChargeCollectionMap::SetActive(G4bool active)
+{
+  if (active && fValues.empty()) {
+    G4Exception("B1ChargeCollectionMap::SetActive()", "MyCode0009",
+                JustWarning, "No charge collection map loaded.");
+    return;
+  }
+  fActive = active;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1ChargeCollectionMap::GetEfficiency(const G4Step* step) const
+{
+  const G4StepPoint* preStep = step->GetPreStepPoint();
+  G4ThreeVector midPoint
+    = 0.5*(preStep->GetPosition() + step->GetPostStepPoint()->GetPosition());
+  return GetEfficiency(preStep->GetTouchableHandle()->GetHistory()
+                       ->GetTopTransform().TransformPoint(midPoint));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,81 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ChargeCollectionMapMessenger.cc
+/// \brief Implementation of the B1ChargeCollectionMapMessenger class
+
+#include "B1ChargeCollectionMapMessenger.hh"
+#include "B1ChargeCollectionMap.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ChargeCollectionMapMessenger::B1ChargeCollectionMapMessenger(
+                                  B1ChargeCollectionMap* map)
+: G4UImessenger(),
+  fMap(map)
+{
+  fCceDir = new G4UIdirectory("/B1/cce/");
+  fCceDir->SetGuidance("Charge collection efficiency of the Ge crystal");
+
+  fMapFileCmd = new G4UIcmdWithAString("/B1/cce/mapFile",this);
+  fMapFileCmd->SetGuidance("Load an (r, z) efficiency map and apply it.");
+  fMapFileCmd->SetParameterName("fileName",false);
+  fMapFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fApplyCmd = new G4UIcmdWithABool("/B1/cce/apply",this);
+  fApplyCmd->SetGuidance("Switch the loaded map on or off.");
+  fApplyCmd->SetParameterName("apply",true);
+  fApplyCmd->SetDefaultValue(true);
+  fApplyCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ChargeCollectionMapMessenger::~B1ChargeCollectionMapMessenger()
+{
+  delete fMapFileCmd;
+  delete fApplyCmd;
+  delete fCceDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ChargeCollectionMapMessenger::SetNewValue(G4UIcommand* command,
+                                                 G4String newValue)
+{
+  if (command == fMapFileCmd) {
+    fMap->Load(newValue);
+  }
+  else if (command == fApplyCmd) {
+    fMap->SetActive(fApplyCmd->GetNewBoolValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
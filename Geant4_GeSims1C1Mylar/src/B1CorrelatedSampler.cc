@@ -0,0 +1,202 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1CorrelatedSampler.cc
+/// \brief Implementation of the B1CorrelatedSampler class
+
+#include "B1CorrelatedSampler.hh"
+#include "B1CorrelatedSamplerMessenger.hh"
+
+#include "G4RunManager.hh"
+#include "Randomize.hh"
+
+#include <cmath>
+#include <cstdint>
+
+namespace {
+  // splitmix64 step, giving a positive non-zero seed
+  long NextSeed(std::uint64_t& state)
+  {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27))*0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    return long(z & 0x7ffffffe) + 1;
+  }
+
+  const char* kScoreNames[] = { "Ge events ", "FEP events" };
+}
+
+B1CorrelatedSampler* B1CorrelatedSampler::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1CorrelatedSampler* B1CorrelatedSampler::Instance()
+{
+  // first created by the master run action, before any worker starts
+  if (!fInstance) fInstance = new B1CorrelatedSampler();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1CorrelatedSampler::B1CorrelatedSampler()
+: fMode(kOff),
+  fSeed(12345),
+  fReference(),
+  fNofPairs(0),
+  fNofUnpaired(0),
+  fMessenger(0)
+{
+  for (G4int i = 0; i < kNofScores; ++i) {
+    for (G4int j = 0; j < 3; ++j) fCounts[i][j] = 0;
+  }
+  fMessenger = new B1CorrelatedSamplerMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1CorrelatedSampler::~B1CorrelatedSampler()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1CorrelatedSampler::BeginOfRun()
+{
+  fNofPairs = 0;
+  fNofUnpaired = 0;
+  for (G4int i = 0; i < kNofScores; ++i) {
+    for (G4int j = 0; j < 3; ++j) fCounts[i][j] = 0;
+  }
+
+  if (fMode == kReference) {
+    G4int nofEvents
+      = G4RunManager::GetRunManager()->GetNumberOfEventsToBeProcessed();
+    fReference.assign(nofEvents, 0);
+  }
+  else if (fMode == kVariant && fReference.empty()) {
+    G4Exception("B1CorrelatedSampler::BeginOfRun()", "MyCode0019",
+                JustWarning,
+                "No reference run: run one with /B1/corr/mode reference"
+                " first, nothing is compared.");
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1CorrelatedSampler::SeedEvent(G4int eventID) const
+{
+  std::uint64_t state = (std::uint64_t(fSeed) << 32) ^ std::uint64_t(eventID);
+  long seeds[3] = { NextSeed(state), NextSeed(state), 0 };
+  G4Random::setTheSeeds(seeds);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1CorrelatedSampler::EndOfEvent(G4int eventID, G4bool geEvent,
+                                     G4bool fullEnergy)
+{
+  unsigned char outcome = (geEvent ? 1 : 0) | (fullEnergy ? 2 : 0);
+  if (eventID < 0 || eventID >= G4int(fReference.size())) {
+    if (fMode == kVariant) ++fNofUnpaired;
+    return;
+  }
+
+  if (fMode == kReference) {
+    fReference[eventID] = outcome;
+    return;
+  }
+
+  unsigned char reference = fReference[eventID];
+  ++fNofPairs;
+  for (G4int i = 0; i < kNofScores; ++i) {
+    G4bool inReference = reference & (1 << i);
+    G4bool inVariant = outcome & (1 << i);
+    if (inReference) ++fCounts[i][0];
+    if (inVariant) ++fCounts[i][1];
+    if (inReference && inVariant) ++fCounts[i][2];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1CorrelatedSampler::Print() const
+{
+  if (fMode == kReference) {
+    G4cout
+       << " Correlated sampling: reference of " << fReference.size()
+       << " events stored, seed " << fSeed << G4endl
+       << "------------------------------------------------------------"
+       << G4endl
+       << G4endl;
+    return;
+  }
+  G4double nofPairs = fNofPairs;
+  if (fMode != kVariant || nofPairs <= 0.) return;
+
+  G4cout
+     << " Correlated sampling: variant against the reference run, "
+     << nofPairs << " paired events" << G4endl;
+  for (G4int i = 0; i < kNofScores; ++i) {
+    G4double reference = fCounts[i][0]/nofPairs;
+    G4double variant = fCounts[i][1]/nofPairs;
+    G4double both = fCounts[i][2]/nofPairs;
+
+    // paired differences are -1, 0 or 1: their mean square is the
+    // fraction of events in one run only
+    G4double difference = variant - reference;
+    G4double meanSquare = reference + variant - 2.*both;
+    G4double error = std::sqrt(std::max(0.,
+                       meanSquare - difference*difference)/nofPairs);
+    G4double independent
+      = std::sqrt((reference*(1. - reference) + variant*(1. - variant))
+                  /nofPairs);
+
+    G4cout
+       << "  " << kScoreNames[i] << " : reference " << reference
+       << ", variant " << variant
+       << ", difference " << difference << " +- " << error
+       << " (independent runs +- " << independent;
+    if (error > 0.) {
+      G4cout << ", variance reduced "
+             << independent*independent/(error*error) << " times";
+    }
+    G4cout << ")" << G4endl;
+  }
+  if (fNofUnpaired > 0) {
+    G4cout << "  " << fNofUnpaired
+           << " events beyond the reference run not compared" << G4endl;
+  }
+  G4cout
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
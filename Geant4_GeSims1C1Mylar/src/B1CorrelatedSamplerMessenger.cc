@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1CorrelatedSamplerMessenger.cc
+/// \brief Implementation of the B1CorrelatedSamplerMessenger class
+
+#include "B1CorrelatedSamplerMessenger.hh"
+#include "B1CorrelatedSampler.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1CorrelatedSamplerMessenger::B1CorrelatedSamplerMessenger(
+                                B1CorrelatedSampler* sampler)
+: G4UImessenger(),
+  fSampler(sampler)
+{
+  // the sampler is shared by all threads: not broadcast to workers
+  fCorrDir = new G4UIdirectory("/B1/corr/", false);
+  fCorrDir->SetGuidance("Correlated sampling of geometry variants");
+
+  fModeCmd = new G4UIcmdWithAString("/B1/corr/mode",this);
+  fModeCmd->SetGuidance("reference: store the outcome of every event;");
+  fModeCmd->SetGuidance("variant: compare every event with the reference;");
+  fModeCmd->SetGuidance("off: usual random streams.");
+  fModeCmd->SetParameterName("mode",false);
+  fModeCmd->SetCandidates("off reference variant");
+  fModeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSeedCmd = new G4UIcmdWithAnInteger("/B1/corr/seed",this);
+  fSeedCmd->SetGuidance("Base seed of the per-event random streams.");
+  fSeedCmd->SetParameterName("seed",false);
+  fSeedCmd->SetRange("seed>0");
+  fSeedCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1CorrelatedSamplerMessenger::~B1CorrelatedSamplerMessenger()
+{
+  delete fModeCmd;
+  delete fSeedCmd;
+  delete fCorrDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1CorrelatedSamplerMessenger::SetNewValue(G4UIcommand* command,
+                                               G4String newValue)
+{
+  if (command == fModeCmd) {
+    if (newValue == "reference")
+      fSampler->SetMode(B1CorrelatedSampler::kReference);
+    else if (newValue == "variant")
+      fSampler->SetMode(B1CorrelatedSampler::kVariant);
+    else
+      fSampler->SetMode(B1CorrelatedSampler::kOff);
+  }
+  else if (command == fSeedCmd) {
+    fSampler->SetSeed(fSeedCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,64 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1CrystalParameterisation.cc
+/// \brief Implementation of the B1CrystalParameterisation class
+
+#include "B1CrystalParameterisation.hh"
+
+#include "G4VPhysicalVolume.hh"
+#include "G4ThreeVector.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1CrystalParameterisation::B1CrystalParameterisation(G4int nofCrystals,
+                                                     G4int nofColumns,
+                                                     G4double pitch)
+: G4VPVParameterisation(),
+  fNofColumns(nofColumns),
+  fNofRows((nofCrystals + nofColumns - 1)/nofColumns),
+  fPitch(pitch)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1CrystalParameterisation::~B1CrystalParameterisation()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1CrystalParameterisation::ComputeTransformation(const G4int copyNo,
+                                     G4VPhysicalVolume* physVol) const
+{
+  G4int column = copyNo % fNofColumns;
+  G4int row = copyNo / fNofColumns;
+  G4double x = (column - 0.5*(fNofColumns-1))*fPitch;
+  G4double y = (row - 0.5*(fNofRows-1))*fPitch;
+  physVol->SetTranslation(G4ThreeVector(x, y, 0.));
+  physVol->SetRotation(0);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
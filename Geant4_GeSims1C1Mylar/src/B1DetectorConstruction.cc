@@ -28,8 +28,10 @@
 /// \brief Implementation of the B1DetectorConstruction class
 
 #include "B1DetectorConstruction.hh"
+#include "B1DetectorMessenger.hh"
+#include "B1CrystalParameterisation.hh"
 
-#include "G4RunManager.hh"
+#include "G4UImanager.hh"
 #include "G4NistManager.hh"
 #include "G4Box.hh"
 #include "G4Cons.hh"
@@ -38,8 +40,13 @@
 #include "G4Sphere.hh"
 #include "G4Trd.hh"
 #include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
 #include "G4PVPlacement.hh"
+#include "G4PVParameterised.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4BOptrForceCollision.hh"
+
+const G4double B1DetectorConstruction::kMaxWindowThickness = 5.*mm;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -47,13 +54,68 @@ B1DetectorConstruction::B1DetectorConstruction()
 : G4VUserDetectorConstruction(),
   fScoringVolume(0),
   fScoringVolume1(0),
-  fScoringVolume2(0)
-{ }
+  fScoringVolume2(0),
+  fNofCrystals(1),
+  fNofColumns(0),
+  fCrystalPitch(80.*mm),
+  fWindowThickness(0.6*mm),
+  fWindowSolid(0),
+  fWindowPlacement(0),
+  fGammaBiasing(false),
+  fForcedVolumes(),
+  fMessenger(0)
+{
+  fMessenger = new B1DetectorMessenger(this);
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1DetectorConstruction::~B1DetectorConstruction()
-{ }
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetNumberOfCrystals(G4int nofCrystals)
+{
+  if (nofCrystals < 1 || nofCrystals > kMaxCrystals) {
+    G4ExceptionDescription msg;
+    msg << "Number of crystals must be between 1 and " << kMaxCrystals
+        << ", " << nofCrystals << " ignored.";
+    G4Exception("B1DetectorConstruction::SetNumberOfCrystals()",
+                "MyCode0010", JustWarning, msg);
+    return;
+  }
+  fNofCrystals = nofCrystals;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetWindowThickness(G4double thickness)
+{
+  // the window must stay clear of the crystal top at z = -5.6 mm
+  if (thickness <= 0. || thickness > kMaxWindowThickness) {
+    G4ExceptionDescription msg;
+    msg << "Carbon window thickness must be between 0 and "
+        << kMaxWindowThickness/mm << " mm, " << thickness/mm
+        << " mm ignored.";
+    G4Exception("B1DetectorConstruction::SetWindowThickness()",
+                "MyCode0010", JustWarning, msg);
+    return;
+  }
+  fWindowThickness = thickness;
+  if (!fWindowSolid) return;
+
+  // already built: resize the window and have the navigation re-optimised,
+  // through the UI command so that the worker threads are told as well
+  fWindowSolid->SetZHalfLength(0.5*fWindowThickness);
+  fWindowPlacement->SetTranslation(
+    G4ThreeVector(0., 0., -0.5*fWindowThickness));
+  G4UImanager::GetUIpointer()->ApplyCommand("/run/geometryModified");
+  G4cout << "Carbon window thickness set to " << fWindowThickness/mm
+         << " mm" << G4endl;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -62,9 +124,30 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   // Get nist material manager
   G4NistManager* nist = G4NistManager::Instance();
   
-  // Envelope parameters
+  // Crystal array layout, a grid as square as possible by default
+  //
+  G4double crystalRadius = 34.779*mm;
+  G4int nofColumns = fNofColumns;
+  if (nofColumns <= 0 || nofColumns > fNofCrystals) {
+    nofColumns = G4int(std::ceil(std::sqrt(G4double(fNofCrystals))));
+  }
+  G4int nofRows = (fNofCrystals + nofColumns - 1)/nofColumns;
+  if (fNofCrystals > 1 && fCrystalPitch < 2.*crystalRadius) {
+    G4ExceptionDescription msg;
+    msg << "Crystal pitch " << fCrystalPitch/mm << " mm is smaller than the"
+        << " crystal diameter, using " << 2.*crystalRadius/mm << " mm.";
+    G4Exception("B1DetectorConstruction::Construct()",
+                "MyCode0010", JustWarning, msg);
+    fCrystalPitch = 2.*crystalRadius;
+  }
+
+  // Envelope parameters, enlarged to hold the array if needed
   //
   G4double env_sizeXY = 100.0*mm, env_sizeZ = 100.0*mm;
+  if (fNofCrystals > 1) {
+    G4double arraySize = std::max(nofColumns, nofRows)*fCrystalPitch;
+    env_sizeXY = std::max(env_sizeXY, arraySize + 20.*mm);
+  }
   G4Material* env_mat = nist->FindOrBuildMaterial("G4_AIR");
    
   // Option to switch on/off checking of volumes overlaps
@@ -123,7 +206,7 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   G4ThreeVector pos1 = G4ThreeVector(0., 0., -15.6*mm);
   
   G4double innerRadius = 0.*mm;
-  G4double outerRadius = 34.779*mm;
+  G4double outerRadius = crystalRadius;
   G4double hz = 10.*mm;
   G4double startAngle = 0.*deg;
   G4double spanningAngle = 360.*deg;
@@ -141,22 +224,49 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
                         shape1_mat,          //its material
                         "Shape1");           //its name
                
-  new G4PVPlacement(0,                       //no rotation
-                    pos1,                    //at position
-                    logicShape1,             //its logical volume
-                    "Shape1",                //its name
-                    logicEnv,                //its mother  volume
-                    false,                   //no boolean operation
-                    0,                       //copy number
-                    checkOverlaps);          //overlaps checking                
+  if (fNofCrystals == 1) {
+    new G4PVPlacement(0,                     //no rotation
+                      pos1,                  //at position
+                      logicShape1,           //its logical volume
+                      "Shape1",              //its name
+                      logicEnv,              //its mother  volume
+                      false,                 //no boolean operation
+                      0,                     //copy number
+                      checkOverlaps);        //overlaps checking                
+  }
+  else {
+    // The crystals are the only daughters of an air container, so that
+    // the navigation voxelises them and the step cost does not grow
+    // with their number.
+    G4Box* solidArray =
+      new G4Box("CrystalArray",
+                0.5*nofColumns*fCrystalPitch, 0.5*nofRows*fCrystalPitch, hz);
+    G4LogicalVolume* logicArray =
+      new G4LogicalVolume(solidArray, env_mat, "CrystalArray");
+    new G4PVPlacement(0, pos1, logicArray, "CrystalArray", logicEnv,
+                      false, 0, checkOverlaps);
+
+    B1CrystalParameterisation* crystalParam
+      = new B1CrystalParameterisation(fNofCrystals, nofColumns, fCrystalPitch);
+    new G4PVParameterised("Shape1",          //its name
+                          logicShape1,       //its logical volume
+                          logicArray,        //its mother volume
+                          kUndefined,        //placed along no axis
+                          fNofCrystals,      //number of copies
+                          crystalParam,      //the parameterisation
+                          checkOverlaps);    //overlaps checking
+    G4cout << "Built an array of " << fNofCrystals << " Ge crystals, "
+           << nofColumns << " per row, pitch " << fCrystalPitch/mm << " mm"
+           << G4endl;
+  }
   
   // Create disk for carbon window
   G4Material* shape2_mat = nist->FindOrBuildMaterial("G4_C");
-  G4ThreeVector pos2 = G4ThreeVector(0., 0., -0.3*mm);
+  G4ThreeVector pos2 = G4ThreeVector(0., 0., -0.5*fWindowThickness);
   
   innerRadius = 0.*mm;
   outerRadius = 34.779*mm;
-  hz = 0.3*mm;
+  hz = 0.5*fWindowThickness;
   startAngle = 0.*deg;
   spanningAngle = 360.*deg;
   
@@ -173,14 +283,16 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
                         shape2_mat,          //its material
                         "Shape2");           //its name
                
-  new G4PVPlacement(0,                       //no rotation
-                    pos2,                    //at position
-                    logicShape2,             //its logical volume
-                    "Shape2",                //its name
-                    logicEnv,                //its mother  volume
-                    false,                   //no boolean operation
-                    0,                       //copy number
-                    checkOverlaps);          //overlaps checking
+  fWindowSolid = solidShape2;
+  fWindowPlacement =
+    new G4PVPlacement(0,                     //no rotation
+                      pos2,                  //at position
+                      logicShape2,           //its logical volume
+                      "Shape2",              //its name
+                      logicEnv,              //its mother  volume
+                      false,                 //no boolean operation
+                      0,                     //copy number
+                      checkOverlaps);        //overlaps checking
   
   // Create disk for test source
   
@@ -294,3 +406,35 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::ConstructSDandField()
+{
+  if (fForcedVolumes.empty()) return;
+  if (!fGammaBiasing) {
+    G4ExceptionDescription msg;
+    msg << "Forced collision needs the gamma processes wrapped for biasing,"
+        << " run exampleB1 -b; no volume is biased.";
+    G4Exception("B1DetectorConstruction::ConstructSDandField()",
+                "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  // the operators are thread-local: one set per worker
+  for (size_t i = 0; i < fForcedVolumes.size(); ++i) {
+    G4LogicalVolume* volume
+      = G4LogicalVolumeStore::GetInstance()->GetVolume(fForcedVolumes[i], false);
+    if (!volume) {
+      G4ExceptionDescription msg;
+      msg << "No volume " << fForcedVolumes[i] << " to force collisions in.";
+      G4Exception("B1DetectorConstruction::ConstructSDandField()",
+                  "MyCode0015", JustWarning, msg);
+      continue;
+    }
+    G4BOptrForceCollision* forceCollision
+      = new G4BOptrForceCollision("gamma", "ForceCollision" + fForcedVolumes[i]);
+    forceCollision->AttachTo(volume);
+    G4cout << "Forced gamma collisions in " << fForcedVolumes[i] << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
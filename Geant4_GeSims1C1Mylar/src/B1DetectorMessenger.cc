@@ -0,0 +1,121 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1DetectorMessenger.cc
+/// \brief Implementation of the B1DetectorMessenger class
+
+#include "B1DetectorMessenger.hh"
+#include "B1DetectorConstruction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DetectorMessenger::B1DetectorMessenger(B1DetectorConstruction* detector)
+: G4UImessenger(),
+  fDetector(detector)
+{
+  fDetDir = new G4UIdirectory("/B1/det/");
+  fDetDir->SetGuidance("Detector geometry");
+
+  fNofCrystalsCmd = new G4UIcmdWithAnInteger("/B1/det/nofCrystals",this);
+  fNofCrystalsCmd->SetGuidance("Number of Ge crystals of the array.");
+  fNofCrystalsCmd->SetGuidance("With 1 the single crystal setup is built.");
+  fNofCrystalsCmd->SetParameterName("nofCrystals",false);
+  fNofCrystalsCmd->SetRange("nofCrystals>=1 && nofCrystals<=50");
+  fNofCrystalsCmd->AvailableForStates(G4State_PreInit);
+
+  fNofColumnsCmd = new G4UIcmdWithAnInteger("/B1/det/nofColumns",this);
+  fNofColumnsCmd->SetGuidance("Crystals per row of the array;");
+  fNofColumnsCmd->SetGuidance("0 for a grid as square as possible.");
+  fNofColumnsCmd->SetParameterName("nofColumns",false);
+  fNofColumnsCmd->SetRange("nofColumns>=0");
+  fNofColumnsCmd->AvailableForStates(G4State_PreInit);
+
+  fPitchCmd = new G4UIcmdWithADoubleAndUnit("/B1/det/pitch",this);
+  fPitchCmd->SetGuidance("Distance between neighbouring crystal axes.");
+  fPitchCmd->SetParameterName("pitch",false);
+  fPitchCmd->SetRange("pitch>0.");
+  fPitchCmd->SetUnitCategory("Length");
+  fPitchCmd->AvailableForStates(G4State_PreInit);
+
+  fForceCollisionCmd = new G4UIcmdWithAString("/B1/det/forceCollision",this);
+  fForceCollisionCmd->SetGuidance("Force the gammas to interact in this");
+  fForceCollisionCmd->SetGuidance("logical volume, e.g. Shape2 or Shape3;");
+  fForceCollisionCmd->SetGuidance("repeat for several volumes. Needs -b.");
+  fForceCollisionCmd->SetGuidance("Both copies are weighted histories of the");
+  fForceCollisionCmd->SetGuidance("Edep histograms and run statistics then.");
+  fForceCollisionCmd->SetParameterName("volume",false);
+  fForceCollisionCmd->AvailableForStates(G4State_PreInit);
+
+  fWindowThicknessCmd
+    = new G4UIcmdWithADoubleAndUnit("/B1/det/windowThickness",this);
+  fWindowThicknessCmd->SetGuidance("Thickness of the carbon window (Shape2),");
+  fWindowThicknessCmd->SetGuidance("0.6 mm by default. Also between runs.");
+  fWindowThicknessCmd->SetParameterName("thickness",false);
+  fWindowThicknessCmd->SetRange("thickness>0.");
+  fWindowThicknessCmd->SetUnitCategory("Length");
+  fWindowThicknessCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DetectorMessenger::~B1DetectorMessenger()
+{
+  delete fNofCrystalsCmd;
+  delete fNofColumnsCmd;
+  delete fPitchCmd;
+  delete fForceCollisionCmd;
+  delete fWindowThicknessCmd;
+  delete fDetDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fNofCrystalsCmd) {
+    fDetector->SetNumberOfCrystals(fNofCrystalsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fNofColumnsCmd) {
+    fDetector->SetNumberOfColumns(fNofColumnsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fPitchCmd) {
+    fDetector->SetCrystalPitch(fPitchCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fForceCollisionCmd) {
+    fDetector->AddForcedCollisionVolume(newValue);
+  }
+  else if (command == fWindowThicknessCmd) {
+    fDetector->SetWindowThickness(
+      fWindowThicknessCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,462 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EfficiencyEngine.cc
+/// \brief Implementation of the B1EfficiencyEngine class
+
+#include "B1EfficiencyEngine.hh"
+#include "B1EfficiencyEngineMessenger.hh"
+#include "B1PrimaryGeneratorAction.hh"
+#include "B1AnalyticSource.hh"
+#include "B1DetectorConstruction.hh"
+#include "B1ChargeCollectionMap.hh"
+
+#include "G4RunManager.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Material.hh"
+#include "G4NistManager.hh"
+#include "G4EmCalculator.hh"
+#include "G4Gamma.hh"
+#include "G4Timer.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <thread>
+
+namespace {
+  // gamma processes of the attenuation coefficient
+  const char* kGammaProcesses[] = { "phot", "compt", "Rayl", "conv" };
+}
+
+B1EfficiencyEngine* B1EfficiencyEngine::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EfficiencyEngine* B1EfficiencyEngine::Instance()
+{
+  // first created by the master run action, before any worker starts
+  if (!fInstance) fInstance = new B1EfficiencyEngine();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EfficiencyEngine::B1EfficiencyEngine()
+: fEnergies(),
+  fNofPoints(1000),
+  fNofRays(1000),
+  fNofThreads(std::max(1u, std::thread::hardware_concurrency())),
+  fSampleMaterialName("none"),
+  fPeakToTotal(0.),
+  fVolumes(),
+  fEnvelope(0),
+  fEnvelopeToLocal(),
+  fAir(0),
+  fMuAir(0.),
+  fSampleMaterial(0),
+  fMuSample(0.),
+  fGeCentre(),
+  fGeRadius(0.),
+  fSource(0),
+  fPoints(),
+  fResults(),
+  fMessenger(0)
+{
+  fMessenger = new B1EfficiencyEngineMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EfficiencyEngine::~B1EfficiencyEngine()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EfficiencyEngine::SetSampleMaterial(const G4String& name)
+{
+  fSampleMaterialName = name;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EfficiencyEngine::Compute()
+{
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  const B1PrimaryGeneratorAction* generatorAction
+    = static_cast<const B1PrimaryGeneratorAction*>
+      (runManager->GetUserPrimaryGeneratorAction());
+  if (!generatorAction
+      || generatorAction->GetGenerator() != B1PrimaryGeneratorAction::kAnalytic) {
+    G4ExceptionDescription msg;
+    msg << "The efficiency engine takes the analytic source"
+        << " (/B1/source/generator analytic) of a sequential run manager"
+        << " (exampleB1 -s), nothing computed.";
+    G4Exception("B1EfficiencyEngine::Compute()", "MyCode0017",
+                JustWarning, msg);
+    return;
+  }
+  fSource = generatorAction->GetAnalyticSource();
+
+  // builds the physics tables, for the cross sections
+  runManager->BeamOn(0);
+  if (!BuildVolumes()) return;
+
+  fSampleMaterial = 0;
+  if (fSampleMaterialName != "none") {
+    fSampleMaterial
+      = G4NistManager::Instance()->FindOrBuildMaterial(fSampleMaterialName);
+    if (!fSampleMaterial) fSampleMaterial
+      = G4Material::GetMaterial(fSampleMaterialName, false);
+    if (!fSampleMaterial) {
+      G4ExceptionDescription msg;
+      msg << "Unknown sample material " << fSampleMaterialName
+          << ", no sample attenuation.";
+      G4Exception("B1EfficiencyEngine::Compute()", "MyCode0017",
+                  JustWarning, msg);
+    }
+  }
+
+  // the same source points at every energy
+  fPoints.resize(std::max(fNofPoints, 1));
+  for (auto& point : fPoints) point = fSource->SamplePosition();
+
+  std::vector<G4double> energies = fEnergies;
+  if (energies.empty()) energies.push_back(fSource->GetEnergy());
+  G4int nofThreads = std::min(std::max(fNofThreads, 1), G4int(fPoints.size()));
+
+  G4Timer timer;
+  timer.Start();
+  fResults.clear();
+  for (size_t k = 0; k < energies.size(); ++k) {
+    G4double energy = energies[k];
+    G4double photoFraction = 0.;
+    for (auto& volume : fVolumes) {
+      volume.mu = Attenuation(volume.material, energy,
+                              volume.ge ? &photoFraction : 0);
+    }
+    fMuAir = Attenuation(fAir, energy);
+    fMuSample = fSampleMaterial ? Attenuation(fSampleMaterial, energy) : 0.;
+
+    // sums of solid angle, efficiency and squared efficiency per thread;
+    // the seeds only depend on the thread, so that a computation can be
+    // repeated with another geometry on the same rays
+    std::vector<G4double> sums(3*nofThreads, 0.);
+    std::vector<std::thread> threads;
+    for (G4int t = 0; t < nofThreads; ++t) {
+      threads.push_back(std::thread(&B1EfficiencyEngine::Trace, this,
+                                    size_t(t), size_t(nofThreads),
+                                    G4long(t), &sums[3*t]));
+    }
+    for (auto& thread : threads) thread.join();
+
+    G4double n = fPoints.size();
+    G4double solidAngle = 0., sum = 0., sum2 = 0.;
+    for (G4int t = 0; t < nofThreads; ++t) {
+      solidAngle += sums[3*t];
+      sum += sums[3*t+1];
+      sum2 += sums[3*t+2];
+    }
+    Result result;
+    result.energy = energy;
+    result.solidAngle = solidAngle/n;
+    result.total = sum/n;
+    result.totalError = (n > 1.)
+      ? std::sqrt(std::max(0., sum2/n - result.total*result.total)/(n - 1.))
+      : 0.;
+    result.peakToTotal = (fPeakToTotal > 0.) ? fPeakToTotal : photoFraction;
+    fResults.push_back(result);
+  }
+  timer.Stop();
+
+  G4cout
+     << G4endl
+     << " Semi-analytic efficiency in Ge, " << fPoints.size()
+     << " source points x " << fNofRays << " rays, " << nofThreads
+     << " threads, sample matrix "
+     << (fSampleMaterial ? fSampleMaterial->GetName() : G4String("none"))
+     << G4endl;
+  for (const Result& result : fResults) {
+    G4cout
+       << "  " << G4BestUnit(result.energy,"Energy")
+       << " : solid angle/4pi " << result.solidAngle
+       << ", total " << result.total << " +- " << result.totalError
+       << ", peak/total " << result.peakToTotal
+       << ", FEP " << result.total*result.peakToTotal
+       << " +- " << result.totalError*result.peakToTotal
+       << G4endl;
+  }
+  G4cout
+     << "  computed in " << timer.GetRealElapsed() << " s"
+     << (fPeakToTotal > 0. ? "" : ", peak/total = Ge photoelectric fraction")
+     << G4endl
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1EfficiencyEngine::BuildVolumes()
+{
+  fVolumes.clear();
+
+  G4LogicalVolume* envelope
+    = G4LogicalVolumeStore::GetInstance()->GetVolume("Envelope");
+  G4VPhysicalVolume* envelopePlacement
+    = G4PhysicalVolumeStore::GetInstance()->GetVolume("Envelope");
+  const B1DetectorConstruction* detectorConstruction
+    = static_cast<const B1DetectorConstruction*>
+      (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  if (!envelope || !envelopePlacement || !detectorConstruction) return false;
+  G4LogicalVolume* ge = detectorConstruction->GetScoringVolume1();
+
+  // the envelope is placed in the world at the origin
+  G4AffineTransform envelopeToWorld(envelopePlacement->GetRotation(),
+                                    envelopePlacement->GetTranslation());
+  fEnvelope = envelope->GetSolid();
+  fEnvelopeToLocal = envelopeToWorld.Inverse();
+  fAir = envelope->GetMaterial();
+
+  G4ThreeVector geMin(DBL_MAX, DBL_MAX, DBL_MAX);
+  G4ThreeVector geMax(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+  for (size_t i = 0; i < envelope->GetNoDaughters(); ++i) {
+    G4VPhysicalVolume* daughter = envelope->GetDaughter(i);
+    G4LogicalVolume* daughterLV = daughter->GetLogicalVolume();
+    if (daughter->IsReplicated() || daughterLV->GetNoDaughters() > 0) {
+      G4ExceptionDescription msg;
+      msg << "Volume " << daughter->GetName()
+          << " is replicated or has daughters, ignored by the efficiency"
+          << " engine.";
+      G4Exception("B1EfficiencyEngine::BuildVolumes()", "MyCode0017",
+                  JustWarning, msg);
+      continue;
+    }
+
+    G4AffineTransform toWorld
+      = G4AffineTransform(daughter->GetRotation(), daughter->GetTranslation())
+        * envelopeToWorld;
+    Volume volume = { daughterLV->GetSolid(), toWorld.Inverse(),
+                      daughterLV->GetMaterial(), daughterLV == ge, 0. };
+    fVolumes.push_back(volume);
+    if (!volume.ge) continue;
+
+    // world-frame box around the crystal
+    G4ThreeVector min, max;
+    volume.solid->BoundingLimits(min, max);
+    for (G4int corner = 0; corner < 8; ++corner) {
+      G4ThreeVector point((corner & 1) ? max.x() : min.x(),
+                          (corner & 2) ? max.y() : min.y(),
+                          (corner & 4) ? max.z() : min.z());
+      point = toWorld.TransformPoint(point);
+      geMin.set(std::min(geMin.x(), point.x()), std::min(geMin.y(), point.y()),
+                std::min(geMin.z(), point.z()));
+      geMax.set(std::max(geMax.x(), point.x()), std::max(geMax.y(), point.y()),
+                std::max(geMax.z(), point.z()));
+    }
+  }
+
+  if (geMin.x() > geMax.x()) {
+    G4Exception("B1EfficiencyEngine::BuildVolumes()", "MyCode0017",
+                JustWarning,
+                "No single Ge crystal in the envelope, nothing computed.");
+    return false;
+  }
+  fGeCentre = 0.5*(geMin + geMax);
+  fGeRadius = 0.5*(geMax - geMin).mag();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1EfficiencyEngine::Attenuation(const G4Material* material,
+                                         G4double energy,
+                                         G4double* photoFraction) const
+{
+  if (!material) return 0.;
+
+  G4EmCalculator calculator;
+  G4double mu = 0.;
+  G4double muPhoto = 0.;
+  for (const char* process : kGammaProcesses) {
+    G4double value = calculator.ComputeCrossSectionPerVolume(
+                       energy, G4Gamma::Gamma(), process, material);
+    mu += value;
+    if (G4String(process) == "phot") muPhoto = value;
+  }
+  if (photoFraction) *photoFraction = (mu > 0.) ? muPhoto/mu : 0.;
+  return mu;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EfficiencyEngine::Trace(size_t first, size_t step, G4long seed,
+                               G4double* sums) const
+{
+  // an engine of its own: the Geant4 one belongs to the calling thread
+  CLHEP::RanecuEngine engine(seed);
+  std::vector<Segment> segments;
+  segments.reserve(fVolumes.size());
+
+  for (size_t i = first; i < fPoints.size(); i += step) {
+    const G4ThreeVector& point = fPoints[i];
+
+    // cone around the bounding sphere of the crystal
+    G4ThreeVector toGe = fGeCentre - point;
+    G4double distance = toGe.mag();
+    G4double cosMax = -1.;
+    if (distance > fGeRadius) {
+      cosMax = std::sqrt(1. - fGeRadius*fGeRadius/(distance*distance));
+    }
+    G4ThreeVector axis = (distance > 0.) ? toGe/distance
+                                         : G4ThreeVector(0., 0., 1.);
+    G4double cone = 0.5*(1. - cosMax);
+
+    G4double efficiency = 0.;
+    G4int nofHits = 0;
+    for (G4int ray = 0; ray < fNofRays; ++ray) {
+      G4double cosTheta = 1. - engine.flat()*(1. - cosMax);
+      G4double sinTheta = std::sqrt(std::max(0., 1. - cosTheta*cosTheta));
+      G4double phi = twopi*engine.flat();
+      G4ThreeVector direction(sinTheta*std::cos(phi),
+                              sinTheta*std::sin(phi), cosTheta);
+      direction.rotateUz(axis);
+
+      G4bool hit = false;
+      efficiency += CastRay(point, direction, hit, segments);
+      if (hit) ++nofHits;
+    }
+    efficiency *= cone/fNofRays;
+
+    sums[0] += cone*nofHits/fNofRays;
+    sums[1] += efficiency;
+    sums[2] += efficiency*efficiency;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1EfficiencyEngine::CastRay(const G4ThreeVector& point,
+                                     const G4ThreeVector& direction,
+                                     G4bool& hit,
+                                     std::vector<Segment>& segments) const
+{
+  // the rays end on the envelope surface
+  G4ThreeVector localPoint = fEnvelopeToLocal.TransformPoint(point);
+  G4ThreeVector localDirection = fEnvelopeToLocal.TransformAxis(direction);
+  if (fEnvelope->Inside(localPoint) == kOutside) return 0.;
+  G4double end = fEnvelope->DistanceToOut(localPoint, localDirection);
+
+  segments.clear();
+  for (const Volume& volume : fVolumes) {
+    localPoint = volume.toLocal.TransformPoint(point);
+    localDirection = volume.toLocal.TransformAxis(direction);
+    G4double start = 0.;
+    if (volume.solid->Inside(localPoint) == kOutside) {
+      start = volume.solid->DistanceToIn(localPoint, localDirection);
+      if (start >= end) continue;
+    }
+    G4double length = volume.solid->DistanceToOut(
+                        localPoint + start*localDirection, localDirection);
+    Segment segment = { start, std::min(start + length, end), &volume };
+    segments.push_back(segment);
+  }
+  std::sort(segments.begin(), segments.end(),
+            [](const Segment& a, const Segment& b)
+            { return a.start < b.start; });
+
+  // optical depth, with the sample replacing the air in the source
+  G4double depth = 0.;
+  if (fSampleMaterial) {
+    depth = (fMuSample - fMuAir)
+            * std::min(fSource->DistanceToOut(point, direction), end);
+  }
+
+  G4double probability = 0.;
+  G4double position = 0.;
+  for (const Segment& segment : segments) {
+    depth += fMuAir*std::max(0., segment.start - position);
+    G4double length = segment.end - segment.start;
+    if (segment.volume->ge) {
+      probability += std::exp(-depth)*(1. - std::exp(-segment.volume->mu*length));
+      hit = true;
+    }
+    depth += segment.volume->mu*length;
+    position = segment.end;
+  }
+  return probability;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EfficiencyEngine::CrossCheck(G4double energy, G4int nofEvents,
+                                    G4double nofGeEvents,
+                                    G4double nofFullEnergyEvents) const
+{
+  if (nofEvents <= 0) return;
+
+  const Result* result = 0;
+  for (const Result& candidate : fResults) {
+    if (std::abs(candidate.energy - energy) < 1.*eV) result = &candidate;
+  }
+  if (!result) return;
+
+  G4double total = nofGeEvents/nofEvents;
+  G4double peak = nofFullEnergyEvents/nofEvents;
+  G4double totalError = std::sqrt(total*(1. - total)/nofEvents);
+  G4double peakError = std::sqrt(peak*(1. - peak)/nofEvents);
+  G4double enginePeak = result->total*result->peakToTotal;
+
+  G4cout
+     << " Semi-analytic against Monte Carlo at "
+     << G4BestUnit(energy,"Energy")
+     << (fSampleMaterial ? " (the Monte Carlo source has no sample matrix)" : "")
+     << G4endl
+     << "  total " << result->total << " / " << total << " +- " << totalError
+     << " (ratio " << (total > 0. ? result->total/total : 0.) << ")"
+     << G4endl
+     << "  FEP   " << enginePeak << " / " << peak << " +- " << peakError
+     << " (ratio " << (peak > 0. ? enginePeak/peak : 0.) << ")"
+     << (B1ChargeCollectionMap::Instance()->IsActive()
+         ? ", Monte Carlo in collected charge" : "")
+     << G4endl
+     << "  Monte Carlo peak/total " << (total > 0. ? peak/total : 0.)
+     << ", for /B1/eff/peakToTotal"
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,144 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EfficiencyEngineMessenger.cc
+/// \brief Implementation of the B1EfficiencyEngineMessenger class
+
+#include "B1EfficiencyEngineMessenger.hh"
+#include "B1EfficiencyEngine.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EfficiencyEngineMessenger::B1EfficiencyEngineMessenger(
+                               B1EfficiencyEngine* engine)
+: G4UImessenger(),
+  fEngine(engine)
+{
+  fEffDir = new G4UIdirectory("/B1/eff/", false);
+  fEffDir->SetGuidance("Semi-analytic efficiency of the analytic source");
+
+  fEnergyCmd = new G4UIcmdWithADoubleAndUnit("/B1/eff/energy",this);
+  fEnergyCmd->SetGuidance("Add a gamma energy to compute;");
+  fEnergyCmd->SetGuidance("without any, the /B1/gun/ energy.");
+  fEnergyCmd->SetParameterName("energy",false);
+  fEnergyCmd->SetRange("energy>0.");
+  fEnergyCmd->SetUnitCategory("Energy");
+  fEnergyCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearEnergiesCmd = new G4UIcmdWithoutParameter("/B1/eff/clearEnergies",this);
+  fClearEnergiesCmd->SetGuidance("Remove all the energies.");
+  fClearEnergiesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPointsCmd = new G4UIcmdWithAnInteger("/B1/eff/points",this);
+  fPointsCmd->SetGuidance("Number of source points.");
+  fPointsCmd->SetParameterName("points",false);
+  fPointsCmd->SetRange("points>0");
+  fPointsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fRaysCmd = new G4UIcmdWithAnInteger("/B1/eff/rays",this);
+  fRaysCmd->SetGuidance("Number of rays per source point.");
+  fRaysCmd->SetParameterName("rays",false);
+  fRaysCmd->SetRange("rays>0");
+  fRaysCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fThreadsCmd = new G4UIcmdWithAnInteger("/B1/eff/threads",this);
+  fThreadsCmd->SetGuidance("Number of ray-tracing threads.");
+  fThreadsCmd->SetParameterName("threads",false);
+  fThreadsCmd->SetRange("threads>0");
+  fThreadsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSampleMaterialCmd = new G4UIcmdWithAString("/B1/eff/sampleMaterial",this);
+  fSampleMaterialCmd->SetGuidance("Matrix filling the source volume,");
+  fSampleMaterialCmd->SetGuidance("a NIST or defined material, or none.");
+  fSampleMaterialCmd->SetParameterName("material",false);
+  fSampleMaterialCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPeakToTotalCmd = new G4UIcmdWithADouble("/B1/eff/peakToTotal",this);
+  fPeakToTotalCmd->SetGuidance("Peak-to-total ratio of the Ge, for the FEP;");
+  fPeakToTotalCmd->SetGuidance("0 takes the Ge photoelectric fraction.");
+  fPeakToTotalCmd->SetParameterName("ratio",false);
+  fPeakToTotalCmd->SetRange("ratio>=0. && ratio<=1.");
+  fPeakToTotalCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fComputeCmd = new G4UIcmdWithoutParameter("/B1/eff/compute",this);
+  fComputeCmd->SetGuidance("Compute and print the efficiencies.");
+  fComputeCmd->AvailableForStates(G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EfficiencyEngineMessenger::~B1EfficiencyEngineMessenger()
+{
+  delete fEnergyCmd;
+  delete fClearEnergiesCmd;
+  delete fPointsCmd;
+  delete fRaysCmd;
+  delete fThreadsCmd;
+  delete fSampleMaterialCmd;
+  delete fPeakToTotalCmd;
+  delete fComputeCmd;
+  delete fEffDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EfficiencyEngineMessenger::SetNewValue(G4UIcommand* command,
+                                              G4String newValue)
+{
+  if (command == fEnergyCmd) {
+    fEngine->AddEnergy(fEnergyCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fClearEnergiesCmd) {
+    fEngine->ClearEnergies();
+  }
+  else if (command == fPointsCmd) {
+    fEngine->SetNumberOfPoints(fPointsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fRaysCmd) {
+    fEngine->SetNumberOfRays(fRaysCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fThreadsCmd) {
+    fEngine->SetNumberOfThreads(fThreadsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fSampleMaterialCmd) {
+    fEngine->SetSampleMaterial(newValue);
+  }
+  else if (command == fPeakToTotalCmd) {
+    fEngine->SetPeakToTotal(fPeakToTotalCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fComputeCmd) {
+    fEngine->Compute();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,74 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EmPhysicsList.cc
+/// \brief Implementation of the B1EmPhysicsList class
+
+#include "B1EmPhysicsList.hh"
+#include "B1GammaElectronPhysics.hh"
+#include "B1AdjointPhysics.hh"
+
+#include "G4EmStandardPhysics.hh"
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4EmLivermorePhysics.hh"
+#include "G4EmPenelopePhysics.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EmPhysicsList::B1EmPhysicsList(const G4String& emName)
+: G4VModularPhysicsList()
+{
+  if (emName == "minimal") RegisterPhysics(new B1GammaElectronPhysics());
+  else if (emName == "adjoint") RegisterPhysics(new B1AdjointPhysics());
+  else if (emName == "livermore") RegisterPhysics(new G4EmLivermorePhysics());
+  else if (emName == "penelope") RegisterPhysics(new G4EmPenelopePhysics());
+  else if (emName == "option4") RegisterPhysics(new G4EmStandardPhysics_option4());
+  else {
+    if (emName != "standard") {
+      G4ExceptionDescription msg;
+      msg << "Unknown EM option " << emName << ", using standard.";
+      G4Exception("B1EmPhysicsList::B1EmPhysicsList()",
+                  "MyCode0022", JustWarning, msg);
+    }
+    RegisterPhysics(new G4EmStandardPhysics());
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EmPhysicsList::~B1EmPhysicsList()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1EmPhysicsList::IsKnown(const G4String& emName)
+{
+  return emName == "standard" || emName == "livermore"
+      || emName == "penelope" || emName == "option4" || emName == "minimal"
+      || emName == "adjoint";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
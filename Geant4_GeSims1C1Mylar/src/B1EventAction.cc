@@ -29,10 +29,34 @@
 
 #include "B1EventAction.hh"
 #include "B1RunAction.hh"
+#include "B1DetectorConstruction.hh"
+#include "B1EventInformation.hh"
+#include "B1TrackInformation.hh"
+#include "B1HitRecorder.hh"
+#include "B1Segmentation.hh"
+#include "B1PileupDigitizer.hh"
+#include "B1PulseShapeSimulator.hh"
+#include "B1PrecisionMonitor.hh"
+#include "B1TrackKiller.hh"
+#include "B1ImportanceSampler.hh"
+#include "B1SelfAbsorption.hh"
+#include "B1CorrelatedSampler.hh"
+#include "B1SlowEventDetector.hh"
+#include "B1EventWatchdog.hh"
 #include "B1Analysis.hh"
 
 #include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4Track.hh"
 #include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace {
+  // Half width of the full-energy-peak window used for the per-line
+  // efficiencies: half a bin of the 1 keV spectrum histograms.
+  const G4double kPeakHalfWidth = 0.5*keV;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -41,7 +65,25 @@ B1EventAction::B1EventAction(B1RunAction* runAction)
   fRunAction(runAction),
   fEdep(0.),
   fEdep1(0.),
-  fEdep4(0.)
+  fEdep4(0.),
+  fForcing(false),
+  fSampling(false),
+  fBranching(false),
+  fNofVolumes(B1RunAction::kNofVolumes),
+  fBranches(),
+  fSplits(),
+  fBranchEdep(),
+  fTrackBranch(),
+  fSplitWarned(false),
+  fWeightWarned(false),
+  fNofPrimaries(0),
+  fTrackPrimary(),
+  fPrimaryEdep1(),
+  fCrystalEdep(),
+  fSegmentEdep(),
+  fSegmentsHit(),
+  fSegmentsFired(),
+  fFiredEdep()
 {} 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -51,29 +93,440 @@ B1EventAction::~B1EventAction()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1EventAction::BeginOfEventAction(const G4Event*)
+void B1EventAction::BeginOfEventAction(const G4Event* event)
 {    
   fEdep = 0.;
   fEdep1 = 0.;
   fEdep4 = 0.;
+  fBranches.clear();
+  fSplits.clear();
+  fBranchEdep.clear();
+  fTrackBranch.clear();
+
+  B1TrackKiller::Instance()->BeginOfEvent();
+  B1EventWatchdog* watchdog = B1EventWatchdog::Instance();
+  if (watchdog->IsActive()) watchdog->BeginOfEvent();
+
+  // primaries are generated before this is called
+  const B1EventInformation* eventInfo
+    = static_cast<const B1EventInformation*>(event->GetUserInformation());
+  fNofPrimaries = eventInfo ? eventInfo->GetNumberOfGammas() : 0;
+  fPrimaryEdep1.assign(fNofPrimaries, 0.);
+  fTrackPrimary.clear();
+
+  // path lengths of the primaries through the sample
+  B1SelfAbsorption* selfAbsorption = B1SelfAbsorption::Instance();
+  if (selfAbsorption->IsActive()) selfAbsorption->BeginOfEvent(event);
+
+  // the geometry is fixed once built, so the size is taken only once
+  const B1DetectorConstruction* detectorConstruction
+    = static_cast<const B1DetectorConstruction*>
+      (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  fForcing = detectorConstruction->IsForcingCollisions();
+
+  // the primaries are the root of the branched history
+  G4int nofParticles = 0;
+  G4double weight = 1.;
+  for (G4int i = 0; i < event->GetNumberOfPrimaryVertex(); ++i) {
+    const G4PrimaryVertex* vertex = event->GetPrimaryVertex(i);
+    for (G4int j = 0; j < vertex->GetNumberOfParticle(); ++j) {
+      if (nofParticles == 0)
+        weight = vertex->GetWeight()*vertex->GetPrimary(j)->GetWeight();
+      ++nofParticles;
+    }
+  }
+  G4bool sampling = B1ImportanceSampler::Instance()->IsActive();
+  fSampling = sampling && nofParticles == 1;
+  fBranching = fSampling || fForcing || weight != 1.;
+  if (!fSplitWarned && nofParticles > 1 && sampling) {
+    G4ExceptionDescription msg;
+    msg << "Events with several primaries are not split; importance"
+        << " sampling only plays in events with a single primary.";
+    G4Exception("B1EventAction::BeginOfEventAction()",
+                "MyCode0016", JustWarning, msg);
+    fSplitWarned = true;
+  }
+  if (!fWeightWarned && weight != 1. && !sampling && !fForcing) {
+    G4ExceptionDescription msg;
+    msg << "Weighted primaries: only the Edep histograms, the run statistics"
+        << " and the full-energy-peak counts are scored for them.";
+    G4Exception("B1EventAction::BeginOfEventAction()",
+                "MyCode0016", JustWarning, msg);
+    fWeightWarned = true;
+  }
+  if (fCrystalEdep.empty()) {
+    fCrystalEdep.resize(detectorConstruction->GetNumberOfCrystals());
+  }
+  std::fill(fCrystalEdep.begin(), fCrystalEdep.end(), 0.);
+
+  // the segmentation may be switched on between runs
+  B1Segmentation* segmentation = B1Segmentation::Instance();
+  if (segmentation->IsActive()) {
+    size_t nofSegments = segmentation->GetNumberOfSegments();
+    if (fSegmentEdep.size() != nofSegments) {
+      fSegmentEdep.assign(nofSegments, 0.);
+      fSegmentsHit.clear();
+    }
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1EventAction::EndOfEventAction(const G4Event*)
+void B1EventAction::EndOfEventAction(const G4Event* event)
 {   
+  // time and steps of this event, saved if slow
+  B1SlowEventDetector* slowEventDetector = B1SlowEventDetector::Instance();
+  if (slowEventDetector->IsTiming()) slowEventDetector->EndOfEvent(event);
+
+  // events aborted by the watchdog are counted but not scored
+  if (event->IsAborted()) {
+    B1EventWatchdog::Instance()->RecordAbort(event, fEdep1);
+    return;
+  }
+
+  // one weighted entry per history of the tree, see the header
+  if (fBranching) {
+    ScoreBranches(event);
+    if (B1PrecisionMonitor::Instance()->IsReached())
+      G4RunManager::GetRunManager()->AbortRun(true);
+    return;
+  }
+
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
 
   // fill histograms
   if (fEdep > 0) analysisManager->FillH1(0, fEdep);
   if (fEdep1 > 0) analysisManager->FillH1(1, fEdep1);
   if (fEdep4 > 0) analysisManager->FillH1(2, fEdep4);
-  
-  
+
   // accumulate statistics in run action
-  fRunAction->AddEdep(fEdep);
-  fRunAction->AddEdep1(fEdep1);
-  fRunAction->AddEdep4(fEdep4);
+  fRunAction->AddEdep(B1RunAction::kCWindow, fEdep);
+  fRunAction->AddEdep(B1RunAction::kGe, fEdep1);
+  fRunAction->AddEdep(B1RunAction::kSourceWindow, fEdep4);
+
+  // stop the event loop once the monitored deposit is precise enough
+  if (B1PrecisionMonitor::Instance()->IsReached())
+    G4RunManager::GetRunManager()->AbortRun(true);
+
+  // count-rate effects on the Ge spectrum
+  B1PileupDigitizer* digitizer = B1PileupDigitizer::Instance();
+  if (digitizer->IsActive()) digitizer->ProcessEvent(fEdep1);
+
+  // Ge spectrum as if the escaping photons had been killed
+  B1TrackKiller* trackKiller = B1TrackKiller::Instance();
+  if (trackKiller->IsValidating()) trackKiller->EndOfEvent(fEdep1);
+
+  // full-energy-peak events: all the primary energy deposited in Ge; with
+  // a charge collection map the Ge deposit is the collected one, so this
+  // is the collected-charge peak, as in a measured spectrum
+  G4bool fullEnergy = false;
+  if (fEdep1 > 0.) {
+    fRunAction->AddGeEvent();
+    G4double primaryEnergy = 0.;
+    for (G4int i = 0; i < event->GetNumberOfPrimaryVertex(); ++i) {
+      const G4PrimaryVertex* vertex = event->GetPrimaryVertex(i);
+      for (G4int j = 0; j < vertex->GetNumberOfParticle(); ++j) {
+        primaryEnergy += vertex->GetPrimary(j)->GetKineticEnergy();
+      }
+    }
+    fullEnergy = std::abs(fEdep1 - primaryEnergy) < kPeakHalfWidth;
+    if (fullEnergy) {
+      fRunAction->AddFullEnergyEvent();
+      // a mono source is a single line; line sources are done per gamma
+      B1SelfAbsorption* selfAbsorption = B1SelfAbsorption::Instance();
+      if (fNofPrimaries == 0 && selfAbsorption->IsActive())
+        selfAbsorption->AddFullEnergy(0, primaryEnergy, 0);
+    }
+  }
+
+  // outcome of this event for the comparison of geometry variants
+  B1CorrelatedSampler* sampler = B1CorrelatedSampler::Instance();
+  if (sampler->IsActive())
+    sampler->EndOfEvent(event->GetEventID(), fEdep1 > 0., fullEnergy);
+
+  // per-crystal spectra and multiplicity for crystal arrays
+  if (fCrystalEdep.size() > 1) ScoreCrystals();
+
+  // segment energies and clusters for the virtual segmentation
+  if (!fSegmentsHit.empty()) ScoreSegments();
+
+  // per-line full-energy-peak counting for radionuclide line sources
+  const B1EventInformation* eventInfo
+    = static_cast<const B1EventInformation*>(event->GetUserInformation());
+  if (eventInfo && eventInfo->GetNumberOfGammas() > 0) ScoreLines(eventInfo);
+
+  // write the Ge deposits of this event for post-hoc re-scoring
+  B1HitRecorder* hitRecorder = B1HitRecorder::Instance();
+  if (hitRecorder->IsActive()) hitRecorder->EndOfEvent(event->GetEventID());
+
+  // hand the Ge hits over to the waveform synthesis threads
+  B1PulseShapeSimulator* pulseShapeSimulator = B1PulseShapeSimulator::Instance();
+  if (pulseShapeSimulator->IsActive())
+    pulseShapeSimulator->EndOfEvent(event->GetEventID());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1EventAction::OwnsBranch(G4int trackID) const
+{
+  return trackID < G4int(fTrackBranch.size())
+         && fBranches[fTrackBranch[trackID]].owner == trackID;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1EventAction::OpenBranch(G4int split, G4int owner, G4double weight)
+{
+  Branch branch = { split, owner, weight };
+  fBranches.push_back(branch);
+  fBranchEdep.resize(fBranchEdep.size() + fNofVolumes, 0.);
+  return fBranches.size() - 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::SplitBranch(const G4Track* track, G4double weight,
+                                G4TrackVector* secondaries, size_t firstCopy)
+{
+  G4int trackID = track->GetTrackID();
+  G4int parent = fTrackBranch[trackID];
+
+  // the secondaries made so far share the deposits before the split
+  for (size_t i = 0; i < firstCopy; ++i) {
+    G4Track* secondary = (*secondaries)[i];
+    if (!secondary->GetUserInformation())
+      secondary->SetUserInformation(new B1TrackInformation(parent));
+  }
+
+  // an owner leaving its branch fixes its weight
+  if (fBranches[parent].owner == trackID) fBranches[parent].weight = weight;
+  Split split = { parent, weight };
+  fSplits.push_back(split);
+  G4int splitIndex = fSplits.size() - 1;
+
+  // one branch for the continuation, one per copy
+  fTrackBranch[trackID] = OpenBranch(splitIndex, trackID, track->GetWeight());
+  for (size_t i = firstCopy; i < secondaries->size(); ++i) {
+    G4Track* copy = (*secondaries)[i];
+    G4int branch = OpenBranch(splitIndex, 0, copy->GetWeight());
+    copy->SetUserInformation(new B1TrackInformation(branch));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::BeginOfTrack(const G4Track* track)
+{
+  // parents are always tracked before their secondaries
+  G4int trackID = track->GetTrackID();
+  if (trackID >= G4int(fTrackBranch.size())) {
+    fTrackBranch.resize(2*trackID, 0);
+  }
+
+  const B1TrackInformation* info
+    = static_cast<const B1TrackInformation*>(track->GetUserInformation());
+  G4int branch;
+  if (info) {
+    branch = info->GetBranch();
+  }
+  else if (track->GetParentID() == 0) {
+    branch = fBranches.empty() ? OpenBranch(-1, trackID, track->GetWeight())
+                               : 0;
+  }
+  else {
+    branch = fTrackBranch[track->GetParentID()];
+  }
+  // a copy owns the branch opened for it
+  if (fBranches[branch].owner == 0) fBranches[branch].owner = trackID;
+  fTrackBranch[trackID] = branch;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::EndOfTrack(const G4Track* track)
+{
+  // the final weight of the owner is the one of its history
+  G4int trackID = track->GetTrackID();
+  if (OwnsBranch(trackID)) {
+    fBranches[fTrackBranch[trackID]].weight = track->GetWeight();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::AddHistories(G4int branch,
+                                 std::vector<History>& histories) const
+{
+  // the branch alone, weights relative to the one of the branch
+  std::vector<History> result(1);
+  for (G4int j = 0; j < fNofVolumes; ++j) {
+    result[0].edep[j] = fBranchEdep[branch*fNofVolumes + j];
+  }
+  result[0].weight = 1.;
+
+  // splits are opened after the branches they split, and their outcomes
+  // after them: every split of the branch takes one outcome each
+  std::vector<History> outcomes, combined;
+  for (size_t k = 0; k < fSplits.size(); ++k) {
+    if (fSplits[k].branch != branch) continue;
+    outcomes.clear();
+    for (size_t i = branch + 1; i < fBranches.size(); ++i) {
+      if (fBranches[i].split != G4int(k) || fBranches[i].weight <= 0.)
+        continue;
+      size_t first = outcomes.size();
+      AddHistories(i, outcomes);
+      G4double ratio = fBranches[i].weight/fSplits[k].weight;
+      for (size_t m = first; m < outcomes.size(); ++m) {
+        outcomes[m].weight *= ratio;
+      }
+    }
+    combined.clear();
+    for (size_t n = 0; n < result.size(); ++n) {
+      for (size_t m = 0; m < outcomes.size(); ++m) {
+        History history = result[n];
+        for (G4int j = 0; j < fNofVolumes; ++j) {
+          history.edep[j] += outcomes[m].edep[j];
+        }
+        history.weight *= outcomes[m].weight;
+        combined.push_back(history);
+      }
+    }
+    result.swap(combined);
+  }
+
+  histories.insert(histories.end(), result.begin(), result.end());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::ScoreBranches(const G4Event* event)
+{
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  G4double primaryEnergy = 0.;
+  for (G4int i = 0; i < event->GetNumberOfPrimaryVertex(); ++i) {
+    const G4PrimaryVertex* vertex = event->GetPrimaryVertex(i);
+    for (G4int j = 0; j < vertex->GetNumberOfParticle(); ++j) {
+      primaryEnergy += vertex->GetPrimary(j)->GetKineticEnergy();
+    }
+  }
+
+  std::vector<History> histories;
+  if (!fBranches.empty()) AddHistories(0, histories);
+
+  // the histogram of each volume has its index
+  G4double edeps[B1RunAction::kNofVolumes] = { 0. };
+  for (size_t i = 0; i < histories.size(); ++i) {
+    const History& history = histories[i];
+    G4double weight = fBranches[0].weight*history.weight;
+    if (weight <= 0.) continue;
+    for (G4int j = 0; j < fNofVolumes; ++j) {
+      G4double edep = history.edep[j];
+      if (edep <= 0.) continue;
+      analysisManager->FillH1(j, edep, weight);
+      edeps[j] += weight*edep;
+    }
+    G4double edep1 = history.edep[B1RunAction::kGe];
+    if (edep1 > 0.) {
+      fRunAction->AddGeEvent(weight);
+      if (std::abs(edep1 - primaryEnergy) < kPeakHalfWidth)
+        fRunAction->AddFullEnergyEvent(weight);
+    }
+  }
+
+  for (G4int j = 0; j < fNofVolumes; ++j) fRunAction->AddEdep(j, edeps[j]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::RecordTrack(G4int trackID, G4int parentID)
+{
+  // Primaries get track IDs 1..n in vertex order; every other track
+  // inherits the primary of its parent, which is always tracked first.
+  if (trackID >= G4int(fTrackPrimary.size())) {
+    fTrackPrimary.resize(2*trackID, 0);
+  }
+  fTrackPrimary[trackID] = (parentID == 0) ? trackID-1 : fTrackPrimary[parentID];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::ScoreCrystals()
+{
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  G4int firstH1 = fRunAction->GetFirstCrystalH1();
+
+  // the sum over crystals is the Edep1 spectrum
+  G4int multiplicity = 0;
+  for (size_t i = 0; i < fCrystalEdep.size(); ++i) {
+    if (fCrystalEdep[i] <= 0.) continue;
+    ++multiplicity;
+    analysisManager->FillH1(firstH1 + i, fCrystalEdep[i]);
+    fRunAction->AddCrystalEdep(i, fCrystalEdep[i]);
+  }
+  analysisManager->FillH1(firstH1 + fCrystalEdep.size(), multiplicity);
+  fRunAction->AddMultiplicity(multiplicity);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::ScoreSegments()
+{
+  B1Segmentation* segmentation = B1Segmentation::Instance();
+  G4double threshold = segmentation->GetThreshold();
+
+  fSegmentsFired.clear();
+  fFiredEdep.clear();
+  for (size_t k = 0; k < fSegmentsHit.size(); ++k) {
+    G4int segment = fSegmentsHit[k];
+    if (fSegmentEdep[segment] > threshold) {
+      fSegmentsFired.push_back(segment);
+      fFiredEdep.push_back(fSegmentEdep[segment]);
+    }
+    fSegmentEdep[segment] = 0.;
+  }
+  fSegmentsHit.clear();
+
+  G4int nofClusters = segmentation->CountClusters(fSegmentsFired);
+  fRunAction->AddSegmentEvent(fSegmentsFired, fFiredEdep, nofClusters);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventAction::ScoreLines(const B1EventInformation* eventInfo)
+{
+  // a single gamma owns the whole Ge deposit
+  if (fNofPrimaries == 1) fPrimaryEdep1[0] = fEdep1;
+
+  // A gamma counts as fully absorbed when its own shower deposits its
+  // energy in Ge; it is summed out when the total deposit is elsewhere
+  // because another gamma of the cascade deposited energy too.
+  G4int nofFull = 0;
+  G4double fullSum = 0.;
+  B1SelfAbsorption* selfAbsorption = B1SelfAbsorption::Instance();
+  for (G4int k = 0; k < fNofPrimaries; ++k) {
+    G4double energy = eventInfo->GetLineEnergy(k);
+    G4bool full = std::abs(fPrimaryEdep1[k] - energy) < kPeakHalfWidth;
+    G4bool summedOut = full && std::abs(fEdep1 - energy) >= kPeakHalfWidth;
+    fRunAction->AddLineEvent(eventInfo->GetLineIndex(k), energy, full, summedOut);
+    if (full) {
+      ++nofFull;
+      fullSum += energy;
+      if (selfAbsorption->IsActive())
+        selfAbsorption->AddFullEnergy(eventInfo->GetLineIndex(k), energy, k);
+    }
+  }
+
+  // Summing-in: two or more gammas fully absorbed with nothing else
+  // deposited, and their sum falls on a line of the table.
+  const std::vector<G4double>* lineTable = eventInfo->GetLineTable();
+  if (nofFull < 2 || !lineTable) return;
+  if (std::abs(fEdep1 - fullSum) >= kPeakHalfWidth) return;
+  for (size_t j = 0; j < lineTable->size(); ++j) {
+    if (std::abs((*lineTable)[j] - fEdep1) < kPeakHalfWidth) {
+      fRunAction->AddLineSumIn(j);
+      break;
+    }
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,207 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventWatchdog.cc
+/// \brief Implementation of the B1EventWatchdog class
+
+#include "B1EventWatchdog.hh"
+#include "B1EventWatchdogMessenger.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4RunManager.hh"
+#include "G4Event.hh"
+#include "G4Threading.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+
+namespace {
+  // steps between two reads of the clock
+  const G4int kTimeCheckInterval = 1000;
+  // event numbers listed in the summary
+  const size_t kMaxListed = 20;
+}
+
+G4ThreadLocal B1EventWatchdog* B1EventWatchdog::fInstance = 0;
+std::vector<G4int> B1EventWatchdog::fAbortedEvents;
+std::mutex B1EventWatchdog::fMutex;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventWatchdog* B1EventWatchdog::Instance()
+{
+  if (!fInstance) fInstance = new B1EventWatchdog();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventWatchdog::B1EventWatchdog()
+: fMaxTime(0.),
+  fMaxSteps(0),
+  fTimer(),
+  fNofSteps(0),
+  fAborted(false),
+  fOverTime(false),
+  fNofEvents(0.),
+  fNofTimeAborts(0.),
+  fNofStepAborts(0.),
+  fLostEdep1(0.),
+  fMessenger(0)
+{
+  fMessenger = new B1EventWatchdogMessenger(this);
+
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fNofEvents);
+  accumulableManager->RegisterAccumulable(fNofTimeAborts);
+  accumulableManager->RegisterAccumulable(fNofStepAborts);
+  accumulableManager->RegisterAccumulable(fLostEdep1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventWatchdog::~B1EventWatchdog()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventWatchdog::BeginOfRun()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fAbortedEvents.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventWatchdog::BeginOfEvent()
+{
+  fNofEvents += 1.;
+  fNofSteps = 0;
+  fAborted = false;
+  fOverTime = false;
+  fTimer.Start();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventWatchdog::ProcessStep()
+{
+  if (fAborted) return;
+
+  ++fNofSteps;
+  if (fMaxSteps > 0 && fNofSteps > fMaxSteps) {
+    Abort("steps");
+    return;
+  }
+  if (fMaxTime > 0. && fNofSteps % kTimeCheckInterval == 0) {
+    fTimer.Stop();
+    if (fTimer.GetRealElapsed()*s > fMaxTime) {
+      fOverTime = true;
+      Abort("wall time");
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventWatchdog::Abort(const char* limit)
+{
+  fAborted = true;
+  fTimer.Stop();
+
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  G4ExceptionDescription msg;
+  msg << "Event " << runManager->GetCurrentEvent()->GetEventID()
+      << " over its " << limit << " limit after "
+      << G4BestUnit(fTimer.GetRealElapsed()*s,"Time") << " and "
+      << fNofSteps << " steps, aborted.";
+  G4Exception("B1EventWatchdog::Abort()", "MyCode0021", JustWarning, msg);
+
+  // the current track and all the stacked ones are dropped
+  runManager->AbortEvent();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventWatchdog::RecordAbort(const G4Event* event, G4double edep1)
+{
+  // aborted for another reason
+  if (!fAborted) return;
+
+  if (fOverTime) fNofTimeAborts += 1.;
+  else fNofStepAborts += 1.;
+  fLostEdep1 += edep1;
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  fAbortedEvents.push_back(event->GetEventID());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventWatchdog::Print() const
+{
+  if (!IsActive() || fNofEvents.GetValue() <= 0.) return;
+
+  G4double nofEvents = fNofEvents.GetValue();
+  G4double nofAborted = fNofTimeAborts.GetValue() + fNofStepAborts.GetValue();
+  G4cout << " Event watchdog, limits";
+  if (fMaxTime > 0.) G4cout << " " << G4BestUnit(fMaxTime,"Time");
+  if (fMaxSteps > 0) G4cout << " " << fMaxSteps << " steps";
+  G4cout
+     << G4endl
+     << "  aborted " << nofAborted << " of " << nofEvents << " events ("
+     << fNofTimeAborts.GetValue() << " over time, "
+     << fNofStepAborts.GetValue() << " over steps), Ge deposit lost "
+     << G4BestUnit(fLostEdep1.GetValue(),"Energy") << G4endl;
+  if (nofAborted > 0.) {
+    G4cout
+       << "  aborted events are not scored: efficiencies low by at most "
+       << nofAborted/nofEvents << " (relative)" << G4endl;
+  }
+
+  // all the threads add to the list, so only the master prints it
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (G4Threading::IsMasterThread() && !fAbortedEvents.empty()) {
+    std::vector<G4int> events(fAbortedEvents);
+    std::sort(events.begin(), events.end());
+    G4cout << "  aborted events:";
+    for (size_t i = 0; i < events.size() && i < kMaxListed; ++i) {
+      G4cout << " " << events[i];
+    }
+    if (events.size() > kMaxListed) G4cout << " ...";
+    G4cout << G4endl;
+  }
+  G4cout
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
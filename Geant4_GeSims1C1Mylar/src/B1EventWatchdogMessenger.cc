@@ -0,0 +1,83 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventWatchdogMessenger.cc
+/// \brief Implementation of the B1EventWatchdogMessenger class
+
+#include "B1EventWatchdogMessenger.hh"
+#include "B1EventWatchdog.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventWatchdogMessenger::B1EventWatchdogMessenger(B1EventWatchdog* watchdog)
+: G4UImessenger(),
+  fWatchdog(watchdog)
+{
+  fWatchdogDir = new G4UIdirectory("/B1/watchdog/");
+  fWatchdogDir->SetGuidance("Per-event limits, over which events are aborted");
+
+  fMaxTimeCmd = new G4UIcmdWithADoubleAndUnit("/B1/watchdog/maxTime",this);
+  fMaxTimeCmd->SetGuidance("Wall time limit of an event (0: none),");
+  fMaxTimeCmd->SetGuidance("checked every 1000 steps.");
+  fMaxTimeCmd->SetParameterName("time",false);
+  fMaxTimeCmd->SetRange("time>=0.");
+  fMaxTimeCmd->SetUnitCategory("Time");
+  fMaxTimeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMaxStepsCmd = new G4UIcmdWithAnInteger("/B1/watchdog/maxSteps",this);
+  fMaxStepsCmd->SetGuidance("Step limit of an event (0: none).");
+  fMaxStepsCmd->SetParameterName("steps",false);
+  fMaxStepsCmd->SetRange("steps>=0");
+  fMaxStepsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventWatchdogMessenger::~B1EventWatchdogMessenger()
+{
+  delete fMaxTimeCmd;
+  delete fMaxStepsCmd;
+  delete fWatchdogDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventWatchdogMessenger::SetNewValue(G4UIcommand* command,
+                                           G4String newValue)
+{
+  if (command == fMaxTimeCmd) {
+    fWatchdog->SetMaxTime(fMaxTimeCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fMaxStepsCmd) {
+    fWatchdog->SetMaxSteps(fMaxStepsCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
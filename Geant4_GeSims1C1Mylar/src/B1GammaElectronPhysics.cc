@@ -0,0 +1,131 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1GammaElectronPhysics.cc
+/// \brief Implementation of the B1GammaElectronPhysics class
+
+#include "B1GammaElectronPhysics.hh"
+
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4Geantino.hh"
+#include "G4ChargedGeantino.hh"
+
+#include "G4PhysicsListHelper.hh"
+#include "G4EmParameters.hh"
+#include "G4LossTableManager.hh"
+#include "G4UAtomicDeexcitation.hh"
+
+#include "G4PhotoElectricEffect.hh"
+#include "G4LivermorePhotoElectricModel.hh"
+#include "G4ComptonScattering.hh"
+#include "G4LivermoreComptonModel.hh"
+#include "G4GammaConversion.hh"
+#include "G4RayleighScattering.hh"
+
+#include "G4eMultipleScattering.hh"
+#include "G4eIonisation.hh"
+#include "G4eBremsstrahlung.hh"
+#include "G4eplusAnnihilation.hh"
+
+#include "G4SystemOfUnits.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GammaElectronPhysics::B1GammaElectronPhysics(G4int verbose)
+: G4VPhysicsConstructor("B1GammaElectron")
+{
+  verboseLevel = verbose;
+
+  G4EmParameters* parameters = G4EmParameters::Instance();
+  parameters->SetDefaults();
+  parameters->SetVerbose(verbose);
+  parameters->SetMinEnergy(100.*eV);
+  parameters->SetLowestElectronEnergy(100.*eV);
+  parameters->SetFluo(true);
+  parameters->SetAuger(false);
+  parameters->SetPixe(false);
+  parameters->SetDeexcitationIgnoreCut(true);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1GammaElectronPhysics::~B1GammaElectronPhysics()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GammaElectronPhysics::ConstructParticle()
+{
+  G4Gamma::Gamma();
+  G4Electron::Electron();
+  G4Positron::Positron();
+
+  // default particles of the general particle source
+  G4Geantino::GeantinoDefinition();
+  G4ChargedGeantino::ChargedGeantinoDefinition();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1GammaElectronPhysics::ConstructProcess()
+{
+  G4PhysicsListHelper* helper = G4PhysicsListHelper::GetPhysicsListHelper();
+
+  // gamma
+  G4ParticleDefinition* gamma = G4Gamma::Gamma();
+
+  G4PhotoElectricEffect* photoElectric = new G4PhotoElectricEffect();
+  photoElectric->SetEmModel(new G4LivermorePhotoElectricModel());
+  helper->RegisterProcess(photoElectric, gamma);
+
+  G4ComptonScattering* compton = new G4ComptonScattering();
+  compton->SetEmModel(new G4LivermoreComptonModel());
+  helper->RegisterProcess(compton, gamma);
+
+  helper->RegisterProcess(new G4GammaConversion(), gamma);
+  helper->RegisterProcess(new G4RayleighScattering(), gamma);
+
+  // e-
+  G4ParticleDefinition* electron = G4Electron::Electron();
+  helper->RegisterProcess(new G4eMultipleScattering(), electron);
+  helper->RegisterProcess(new G4eIonisation(), electron);
+  helper->RegisterProcess(new G4eBremsstrahlung(), electron);
+
+  // e+
+  G4ParticleDefinition* positron = G4Positron::Positron();
+  helper->RegisterProcess(new G4eMultipleScattering(), positron);
+  helper->RegisterProcess(new G4eIonisation(), positron);
+  helper->RegisterProcess(new G4eBremsstrahlung(), positron);
+  helper->RegisterProcess(new G4eplusAnnihilation(), positron);
+
+  // fluorescence after photoelectric absorption and ionisation
+  G4LossTableManager::Instance()
+    ->SetAtomDeexcitation(new G4UAtomicDeexcitation());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,233 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HitRecorder.cc
+/// \brief Implementation of the B1HitRecorder class
+
+#include "B1HitRecorder.hh"
+#include "B1HitRecorderMessenger.hh"
+
+#include "G4Step.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Tubs.hh"
+#include "G4Threading.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+  // bytes kept in memory before each write
+  const size_t kBufferSize = 1 << 20;
+}
+
+G4ThreadLocal B1HitRecorder* B1HitRecorder::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HitRecorder* B1HitRecorder::Instance()
+{
+  if (!fInstance) fInstance = new B1HitRecorder();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HitRecorder::B1HitRecorder()
+: B1WorkerFile("hit", ".hits", "MyCode0008"),
+  fActive(false),
+  fFileName("GeHits"),
+  fRadius(0.),
+  fHalfZ(0.),
+  fEventHits(),
+  fBuffer(),
+  fNofEvents(0),
+  fMessenger(0)
+{
+  fMessenger = new B1HitRecorderMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HitRecorder::~B1HitRecorder()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HitRecorder::BeginOfRun()
+{
+  if (!fActive) return;
+
+  // the crystal dimensions go into the header for the re-scoring tools
+  G4LogicalVolume* crystalLV
+    = G4LogicalVolumeStore::GetInstance()->GetVolume("Shape1");
+  G4Tubs* crystal = crystalLV ? dynamic_cast<G4Tubs*>(crystalLV->GetSolid()) : 0;
+  if (crystal) {
+    fRadius = crystal->GetOuterRadius();
+    fHalfZ = crystal->GetZHalfLength();
+  }
+  else {
+    G4Exception("B1HitRecorder::BeginOfRun()", "MyCode0008", JustWarning,
+                "Ge crystal Shape1 of tube shape not found.");
+  }
+
+  // in MT mode the master only merges the worker files
+  if (IsMasterOfWorkers()) return;
+
+  if (!OpenFile(fFileName)) {
+    fActive = false;
+    return;
+  }
+
+  fNofEvents = 0;
+  fEventHits.clear();
+  fBuffer.clear();
+  fBuffer.reserve(kBufferSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HitRecorder::EndOfRun(G4int nofEvents)
+{
+  if (!fActive) return;
+
+  if (IsMasterOfWorkers()) {
+    uint64_t nofHitEvents = 0;
+    uint64_t nofHistories = 0;
+    MergeFiles(fFileName, nofHitEvents, nofHistories);
+    G4cout << " Ge hits: " << nofHitEvents << " events with deposits out of "
+           << nofHistories << " written to " << fFileName << ".hits" << G4endl;
+    return;
+  }
+
+  if (!IsFileOpen()) return;
+  Flush();
+  CloseFile(fNofEvents, nofEvents);
+
+  if (!G4Threading::IsWorkerThread()) {
+    G4cout << " Ge hits: " << fNofEvents << " events with deposits out of "
+           << nofEvents << " written to " << fFileName << ".hits" << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HitRecorder::AddHit(const G4Step* step, G4double edep)
+{
+  if (edep <= 0.) return;
+
+  const G4StepPoint* preStep = step->GetPreStepPoint();
+  G4ThreeVector midPoint
+    = 0.5*(preStep->GetPosition() + step->GetPostStepPoint()->GetPosition());
+  G4ThreeVector local = preStep->GetTouchableHandle()->GetHistory()
+                        ->GetTopTransform().TransformPoint(midPoint);
+
+  B1HitRecord hit;
+  hit.x = local.x()/mm;
+  hit.y = local.y()/mm;
+  hit.z = local.z()/mm;
+  hit.edep = edep/MeV;
+  hit.copyNo = preStep->GetTouchableHandle()->GetCopyNumber();
+  fEventHits.push_back(hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HitRecorder::EndOfEvent(G4int eventID)
+{
+  if (fEventHits.empty() || !IsFileOpen()) {
+    fEventHits.clear();
+    return;
+  }
+
+  // grouped by crystal, see B1HitFile.hh
+  std::stable_sort(fEventHits.begin(), fEventHits.end(),
+                   [](const B1HitRecord& a, const B1HitRecord& b)
+                   { return a.copyNo < b.copyNo; });
+
+  B1HitEventHeader header;
+  header.eventID = eventID;
+  header.nofHits = fEventHits.size();
+
+  const char* begin = reinterpret_cast<const char*>(&header);
+  fBuffer.insert(fBuffer.end(), begin, begin + sizeof(header));
+  begin = reinterpret_cast<const char*>(&fEventHits[0]);
+  fBuffer.insert(fBuffer.end(), begin,
+                 begin + fEventHits.size()*sizeof(B1HitRecord));
+
+  ++fNofEvents;
+  fEventHits.clear();
+  if (fBuffer.size() >= kBufferSize) Flush();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HitRecorder::Flush()
+{
+  if (fBuffer.empty()) return;
+  WriteToFile(&fBuffer[0], fBuffer.size());
+  fBuffer.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HitRecorder::WriteHeader(std::ostream& file, uint64_t nofEvents,
+                                uint64_t nofHistories) const
+{
+  B1HitFileHeader header;
+  std::memcpy(header.magic, kB1HitFileMagic, sizeof(header.magic));
+  header.nofEvents = nofEvents;
+  header.nofHistories = nofHistories;
+  header.radius = fRadius/mm;
+  header.halfZ = fHalfZ/mm;
+  header.recordSize = sizeof(B1HitRecord);
+  header.reserved = 0;
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1HitRecorder::ReadHeader(std::istream& file, uint64_t& nofEvents,
+                                 uint64_t& nofHistories) const
+{
+  B1HitFileHeader header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!file || std::memcmp(header.magic, kB1HitFileMagic, 8) != 0)
+    return false;
+  nofEvents = header.nofEvents;
+  nofHistories = header.nofHistories;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
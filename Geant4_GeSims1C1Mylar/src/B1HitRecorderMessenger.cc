@@ -0,0 +1,80 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HitRecorderMessenger.cc
+/// \brief Implementation of the B1HitRecorderMessenger class
+
+#include "B1HitRecorderMessenger.hh"
+#include "B1HitRecorder.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HitRecorderMessenger::B1HitRecorderMessenger(B1HitRecorder* recorder)
+: G4UImessenger(),
+  fRecorder(recorder)
+{
+  fHitsDir = new G4UIdirectory("/B1/hits/");
+  fHitsDir->SetGuidance("Recording of individual Ge deposits");
+
+  fRecordCmd = new G4UIcmdWithABool("/B1/hits/record",this);
+  fRecordCmd->SetGuidance("Write the position and energy of every Ge deposit.");
+  fRecordCmd->SetParameterName("record",true);
+  fRecordCmd->SetDefaultValue(true);
+  fRecordCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileNameCmd = new G4UIcmdWithAString("/B1/hits/fileName",this);
+  fFileNameCmd->SetGuidance("Set the output file name (without .hits).");
+  fFileNameCmd->SetParameterName("fileName",false);
+  fFileNameCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HitRecorderMessenger::~B1HitRecorderMessenger()
+{
+  delete fRecordCmd;
+  delete fFileNameCmd;
+  delete fHitsDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HitRecorderMessenger::SetNewValue(G4UIcommand* command,
+                                         G4String newValue)
+{
+  if (command == fRecordCmd) {
+    fRecorder->SetActive(fRecordCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fFileNameCmd) {
+    fRecorder->SetFileName(newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
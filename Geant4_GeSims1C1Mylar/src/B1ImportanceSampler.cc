@@ -0,0 +1,268 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ImportanceSampler.cc
+/// \brief Implementation of the B1ImportanceSampler class
+
+#include "B1ImportanceSampler.hh"
+#include "B1ImportanceSamplerMessenger.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4Gamma.hh"
+#include "G4Track.hh"
+#include "G4Step.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Threading.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+
+namespace {
+  // weight window [lower, kWindowRatio*lower], survivors at
+  // kSurvivalRatio*lower
+  const G4double kWindowRatio = 5.;
+  const G4double kSurvivalRatio = 3.;
+}
+
+G4ThreadLocal B1ImportanceSampler* B1ImportanceSampler::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ImportanceSampler* B1ImportanceSampler::Instance()
+{
+  if (!fInstance) fInstance = new B1ImportanceSampler();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ImportanceSampler::B1ImportanceSampler()
+: fActive(false),
+  fCentre(),
+  fShells(),
+  fVolumeNames(),
+  fWindowWeight(0.),
+  fMaxSplit(10),
+  fVolumes(),
+  fNofSplit(0.),
+  fNofCopies(0.),
+  fNofRoulette(0.),
+  fNofKilled(0.),
+  fMessenger(0)
+{
+  fMessenger = new B1ImportanceSamplerMessenger(this);
+
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fNofSplit);
+  accumulableManager->RegisterAccumulable(fNofCopies);
+  accumulableManager->RegisterAccumulable(fNofRoulette);
+  accumulableManager->RegisterAccumulable(fNofKilled);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ImportanceSampler::~B1ImportanceSampler()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceSampler::SetShell(G4double radius, G4double importance)
+{
+  fShells[radius] = importance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceSampler::SetVolume(const G4String& name, G4double importance)
+{
+  fVolumeNames[name] = importance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceSampler::Clear()
+{
+  fShells.clear();
+  fVolumeNames.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceSampler::BeginOfRun()
+{
+  if (!fActive) return;
+
+  // volumes are looked up by name once the geometry is built
+  fVolumes.clear();
+  G4bool verbose = G4Threading::G4GetThreadId() <= 0;
+  std::map<G4String, G4double>::const_iterator it;
+  for (it = fVolumeNames.begin(); it != fVolumeNames.end(); ++it) {
+    const G4LogicalVolume* volume
+      = G4LogicalVolumeStore::GetInstance()->GetVolume(it->first, false);
+    if (volume) {
+      fVolumes[volume] = it->second;
+    }
+    else if (verbose) {
+      G4ExceptionDescription msg;
+      msg << "No volume " << it->first << ", its importance is ignored.";
+      G4Exception("B1ImportanceSampler::BeginOfRun()",
+                  "MyCode0016", JustWarning, msg);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1ImportanceSampler::GetImportance(const G4ThreeVector& point,
+                                            const G4LogicalVolume* volume) const
+{
+  if (!fVolumes.empty()) {
+    std::unordered_map<const G4LogicalVolume*, G4double>::const_iterator it
+      = fVolumes.find(volume);
+    if (it != fVolumes.end()) return it->second;
+  }
+  if (fShells.empty()) return 1.;
+
+  // first shell reaching the point, or the outermost one
+  std::map<G4double, G4double>::const_iterator shell
+    = fShells.lower_bound((point - fCentre).mag());
+  if (shell == fShells.end()) --shell;
+  return shell->second;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceSampler::ProcessStep(const G4Step* step,
+                                      G4TrackVector* secondaries)
+{
+  const G4Track* track = step->GetTrack();
+  if (track->GetDefinition() != G4Gamma::Definition()
+      || track->GetTrackStatus() != fAlive) return;
+
+  const G4StepPoint* postStep = step->GetPostStepPoint();
+  if (!postStep->GetPhysicalVolume()) return;   // leaving the world
+  G4double importance
+    = GetImportance(postStep->GetPosition(),
+                    postStep->GetPhysicalVolume()->GetLogicalVolume());
+  if (importance <= 0.) return;
+
+  if (fWindowWeight > 0.) {
+    G4double lower = fWindowWeight/importance;
+    G4double weight = track->GetWeight();
+    if (weight > kWindowRatio*lower) {
+      Split(step, weight/(kSurvivalRatio*lower), secondaries);
+    }
+    else if (weight < lower) {
+      Roulette(step, weight/(kSurvivalRatio*lower));
+    }
+    return;
+  }
+
+  const G4StepPoint* preStep = step->GetPreStepPoint();
+  G4double previous
+    = GetImportance(preStep->GetPosition(),
+                    preStep->GetPhysicalVolume()->GetLogicalVolume());
+  if (previous <= 0. || importance == previous) return;
+  if (importance > previous) {
+    Split(step, importance/previous, secondaries);
+  }
+  else {
+    Roulette(step, importance/previous);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceSampler::Split(const G4Step* step, G4double ratio,
+                                G4TrackVector* secondaries)
+{
+  // ratio copies on average, each with the weight divided by ratio
+  ratio = std::min(ratio, G4double(fMaxSplit));
+  G4int nofCopies = G4int(ratio);
+  if (G4UniformRand() < ratio - nofCopies) ++nofCopies;
+
+  // the post-step point weight is the next pre-step one
+  G4Track* track = step->GetTrack();
+  G4double weight = track->GetWeight()/ratio;
+  track->SetWeight(weight);
+  step->GetPostStepPoint()->SetWeight(weight);
+
+  fNofSplit += 1.;
+  fNofCopies += nofCopies - 1;
+  for (G4int i = 1; i < nofCopies; ++i) {
+    G4Track* copy
+      = new G4Track(new G4DynamicParticle(*track->GetDynamicParticle()),
+                    track->GetGlobalTime(), track->GetPosition());
+    copy->SetWeight(weight);
+    copy->SetParentID(track->GetTrackID());
+    copy->SetTouchableHandle(step->GetPostStepPoint()->GetTouchableHandle());
+    secondaries->push_back(copy);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceSampler::Roulette(const G4Step* step, G4double survival)
+{
+  fNofRoulette += 1.;
+  G4Track* track = step->GetTrack();
+  if (G4UniformRand() >= survival) {
+    fNofKilled += 1.;
+    track->SetWeight(0.);
+    track->SetTrackStatus(fStopAndKill);
+    return;
+  }
+  G4double weight = track->GetWeight()/survival;
+  track->SetWeight(weight);
+  step->GetPostStepPoint()->SetWeight(weight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceSampler::Print() const
+{
+  if (!fActive) return;
+
+  G4cout
+     << " Importance sampling of gammas ("
+     << (fWindowWeight > 0. ? "weight windows" : "geometric")
+     << "): " << fNofSplit.GetValue() << " splits into "
+     << fNofCopies.GetValue() << " extra copies, "
+     << fNofRoulette.GetValue() << " roulette games, "
+     << fNofKilled.GetValue() << " killed"
+     << G4endl
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
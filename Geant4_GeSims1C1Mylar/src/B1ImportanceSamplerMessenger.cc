@@ -0,0 +1,159 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ImportanceSamplerMessenger.cc
+/// \brief Implementation of the B1ImportanceSamplerMessenger class
+
+#include "B1ImportanceSamplerMessenger.hh"
+#include "B1ImportanceSampler.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ImportanceSamplerMessenger::B1ImportanceSamplerMessenger(
+                                B1ImportanceSampler* sampler)
+: G4UImessenger(),
+  fSampler(sampler)
+{
+  fImpDir = new G4UIdirectory("/B1/imp/");
+  fImpDir->SetGuidance("Importance sampling of the gammas");
+
+  fActiveCmd = new G4UIcmdWithABool("/B1/imp/active",this);
+  fActiveCmd->SetGuidance("Split and roulette the gammas.");
+  fActiveCmd->SetParameterName("active",true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fCentreCmd = new G4UIcmdWith3VectorAndUnit("/B1/imp/centre",this);
+  fCentreCmd->SetGuidance("Centre of the importance shells.");
+  fCentreCmd->SetParameterName("x","y","z",false);
+  fCentreCmd->SetUnitCategory("Length");
+  fCentreCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fShellCmd = new G4UIcommand("/B1/imp/shell",this);
+  fShellCmd->SetGuidance("Importance up to this distance from the centre,");
+  fShellCmd->SetGuidance("beyond the next smaller shell. The outermost");
+  fShellCmd->SetGuidance("shell extends to infinity.");
+  G4UIparameter* parameter = new G4UIparameter("radius",'d',false);
+  parameter->SetParameterRange("radius>0.");
+  fShellCmd->SetParameter(parameter);
+  parameter = new G4UIparameter("unit",'s',false);
+  fShellCmd->SetParameter(parameter);
+  parameter = new G4UIparameter("importance",'d',false);
+  parameter->SetParameterRange("importance>0.");
+  fShellCmd->SetParameter(parameter);
+  fShellCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fVolumeCmd = new G4UIcommand("/B1/imp/volume",this);
+  fVolumeCmd->SetGuidance("Importance of a logical volume, overriding");
+  fVolumeCmd->SetGuidance("the shells.");
+  parameter = new G4UIparameter("volume",'s',false);
+  fVolumeCmd->SetParameter(parameter);
+  parameter = new G4UIparameter("importance",'d',false);
+  parameter->SetParameterRange("importance>0.");
+  fVolumeCmd->SetParameter(parameter);
+  fVolumeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/B1/imp/clear",this);
+  fClearCmd->SetGuidance("Remove all shells and volume importances.");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fWeightWindowCmd = new G4UIcmdWithADouble("/B1/imp/weightWindow",this);
+  fWeightWindowCmd->SetGuidance("Lower weight bound at importance 1, the");
+  fWeightWindowCmd->SetGuidance("window being [w/I, 5w/I]; 0 splits at");
+  fWeightWindowCmd->SetGuidance("importance changes only.");
+  fWeightWindowCmd->SetParameterName("weight",false);
+  fWeightWindowCmd->SetRange("weight>=0.");
+  fWeightWindowCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMaxSplitCmd = new G4UIcmdWithAnInteger("/B1/imp/maxSplit",this);
+  fMaxSplitCmd->SetGuidance("Maximum number of copies per step.");
+  fMaxSplitCmd->SetParameterName("maxSplit",false);
+  fMaxSplitCmd->SetRange("maxSplit>=1");
+  fMaxSplitCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ImportanceSamplerMessenger::~B1ImportanceSamplerMessenger()
+{
+  delete fActiveCmd;
+  delete fCentreCmd;
+  delete fShellCmd;
+  delete fVolumeCmd;
+  delete fClearCmd;
+  delete fWeightWindowCmd;
+  delete fMaxSplitCmd;
+  delete fImpDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ImportanceSamplerMessenger::SetNewValue(G4UIcommand* command,
+                                               G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fSampler->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fCentreCmd) {
+    fSampler->SetCentre(fCentreCmd->GetNew3VectorValue(newValue));
+  }
+  else if (command == fShellCmd) {
+    std::istringstream input(newValue);
+    G4double radius, importance;
+    G4String unit;
+    input >> radius >> unit >> importance;
+    fSampler->SetShell(radius*G4UIcommand::ValueOf(unit), importance);
+  }
+  else if (command == fVolumeCmd) {
+    std::istringstream input(newValue);
+    G4String name;
+    G4double importance;
+    input >> name >> importance;
+    fSampler->SetVolume(name, importance);
+  }
+  else if (command == fClearCmd) {
+    fSampler->Clear();
+  }
+  else if (command == fWeightWindowCmd) {
+    fSampler->SetWeightWindow(fWeightWindowCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fMaxSplitCmd) {
+    fSampler->SetMaxSplit(fMaxSplitCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,261 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PhaseSpaceSource.cc
+/// \brief Implementation of the B1PhaseSpaceSource class
+
+#include "B1PhaseSpaceSource.hh"
+
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4ParticleTable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Threading.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+#ifdef G4MULTITHREADED
+#include "G4MTRunManager.hh"
+#endif
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhaseSpaceSource::B1PhaseSpaceSource()
+: G4VPrimaryGenerator(),
+  fFileName(""),
+  fMap(0),
+  fMapSize(0),
+  fRecords(0),
+  fNofRecords(0),
+  fNofHistories(0),
+  fFirst(0),
+  fLast(0),
+  fNext(0),
+  fRecycle(1),
+  fRotate(false),
+  fUse(0),
+  fWrapped(false),
+  fSkipWarned(false),
+  fPdg(0),
+  fParticle(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhaseSpaceSource::~B1PhaseSpaceSource()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PhaseSpaceSource::Open(const G4String& fileName)
+{
+  Close();
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  struct stat status;
+  if (fd < 0 || fstat(fd, &status) != 0
+      || size_t(status.st_size) < sizeof(B1PhaseSpaceHeader)) {
+    if (fd >= 0) close(fd);
+    G4ExceptionDescription msg;
+    msg << "Cannot read phase-space file " << fileName << ".";
+    G4Exception("B1PhaseSpaceSource::Open()", "MyCode0007", JustWarning, msg);
+    return false;
+  }
+
+  fMapSize = status.st_size;
+  fMap = mmap(0, fMapSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (fMap == MAP_FAILED) {
+    fMap = 0;
+    G4ExceptionDescription msg;
+    msg << "Cannot map phase-space file " << fileName << ".";
+    G4Exception("B1PhaseSpaceSource::Open()", "MyCode0007", JustWarning, msg);
+    return false;
+  }
+
+  const B1PhaseSpaceHeader* header
+    = static_cast<const B1PhaseSpaceHeader*>(fMap);
+  uint64_t available
+    = (fMapSize - sizeof(B1PhaseSpaceHeader))/sizeof(B1PhaseSpaceRecord);
+  if (std::memcmp(header->magic, kB1PhaseSpaceMagic, 8) != 0
+      || header->recordSize != sizeof(B1PhaseSpaceRecord)
+      || header->nofRecords > available || header->nofRecords == 0) {
+    G4ExceptionDescription msg;
+    msg << fileName << " is not a valid (or is an empty) phase-space file.";
+    G4Exception("B1PhaseSpaceSource::Open()", "MyCode0007", JustWarning, msg);
+    Close();
+    return false;
+  }
+
+  fFileName = fileName;
+  fRecords = reinterpret_cast<const B1PhaseSpaceRecord*>(
+               static_cast<const char*>(fMap) + sizeof(B1PhaseSpaceHeader));
+  fNofRecords = header->nofRecords;
+  fNofHistories = header->nofHistories;
+
+  // Contiguous slice for this worker; slices of all workers tile the file
+  G4int nofThreads = 1;
+  G4int threadID = 0;
+#ifdef G4MULTITHREADED
+  if (G4Threading::IsWorkerThread()) {
+    nofThreads = G4MTRunManager::GetMasterRunManager()->GetNumberOfThreads();
+    threadID = G4Threading::G4GetThreadId();
+  }
+#endif
+  // of whole histories
+  fFirst = HistoryStart(fNofRecords*threadID/nofThreads);
+  fLast  = HistoryStart(fNofRecords*(threadID+1)/nofThreads);
+  if (fFirst == fLast) {
+    fFirst = 0;
+    fLast = fNofRecords;
+  }
+  fNext = fFirst;
+  fUse = 0;
+  fWrapped = false;
+  fSkipWarned = false;
+
+  if (threadID == 0) {
+    uint64_t nofRecorded = 1;
+    for (uint64_t i = 1; i < fNofRecords; ++i) {
+      if (fRecords[i].eventID != fRecords[i-1].eventID) ++nofRecorded;
+    }
+    G4cout << "Phase space " << fileName << " : " << fNofRecords
+           << " particles of " << nofRecorded << " histories from "
+           << fNofHistories << " source events;"
+           << " each replayed event stands for "
+           << G4double(fNofHistories)/(G4double(nofRecorded)*fRecycle)
+           << " source events" << G4endl;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhaseSpaceSource::Close()
+{
+  if (fMap) munmap(fMap, fMapSize);
+  fMap = 0;
+  fMapSize = 0;
+  fRecords = 0;
+  fNofRecords = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhaseSpaceSource::GeneratePrimaryVertex(G4Event* event)
+{
+  if (!fRecords) {
+    G4Exception("B1PhaseSpaceSource::GeneratePrimaryVertex()", "MyCode0007",
+                RunMustBeAborted, "No phase-space file open.");
+    return;
+  }
+
+  // the records of one history, rotated together
+  uint64_t first = fNext;
+  uint64_t last = first + 1;
+  while (last < fLast && fRecords[last].eventID == fRecords[first].eventID) {
+    ++last;
+  }
+  if (++fUse >= fRecycle) {
+    fUse = 0;
+    fNext = last;
+    if (fNext == fLast) {
+      fNext = fFirst;
+      if (!fWrapped) {
+        G4Exception("B1PhaseSpaceSource::GeneratePrimaryVertex()",
+                    "MyCode0007", JustWarning,
+                    "Phase-space slice exhausted, restarting from its first record.");
+        fWrapped = true;
+      }
+    }
+  }
+
+  G4double phi = (fRecycle > 1 && fRotate) ? twopi*G4UniformRand() : 0.;
+  for (uint64_t i = first; i < last; ++i) {
+    const B1PhaseSpaceRecord& record = fRecords[i];
+    const G4ParticleDefinition* particle = FindParticle(record.pdg);
+    if (!particle) {
+      if (!fSkipWarned) {
+        G4ExceptionDescription msg;
+        msg << "Unknown particle, PDG code " << record.pdg << ", in "
+            << fFileName << "; such records are skipped.";
+        G4Exception("B1PhaseSpaceSource::GeneratePrimaryVertex()",
+                    "MyCode0007", JustWarning, msg);
+        fSkipWarned = true;
+      }
+      continue;
+    }
+
+    G4ThreeVector position(record.x*mm, record.y*mm, record.z*mm);
+    G4ThreeVector direction(record.u, record.v, record.w);
+    position.rotateZ(phi);
+    direction.rotateZ(phi);
+
+    G4PrimaryVertex* vertex = new G4PrimaryVertex(position, 0.);
+    G4PrimaryParticle* primary = new G4PrimaryParticle(particle);
+    primary->SetKineticEnergy(record.energy*MeV);
+    primary->SetMomentumDirection(direction.unit());
+    primary->SetWeight(record.weight);
+    vertex->SetPrimary(primary);
+    event->AddPrimaryVertex(vertex);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+uint64_t B1PhaseSpaceSource::HistoryStart(uint64_t record) const
+{
+  // the writer keeps the records of an event together
+  while (record > 0 && record < fNofRecords
+         && fRecords[record].eventID == fRecords[record-1].eventID) {
+    ++record;
+  }
+  return record;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const G4ParticleDefinition* B1PhaseSpaceSource::FindParticle(G4int pdg)
+{
+  // nearly all records are gammas, so remember the last lookup
+  if (pdg != fPdg || !fParticle) {
+    fParticle = G4ParticleTable::GetParticleTable()->FindParticle(pdg);
+    fPdg = pdg;
+  }
+  return fParticle;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
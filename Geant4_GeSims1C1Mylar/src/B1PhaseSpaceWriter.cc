@@ -0,0 +1,239 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PhaseSpaceWriter.cc
+/// \brief Implementation of the B1PhaseSpaceWriter class
+
+#include "B1PhaseSpaceWriter.hh"
+#include "B1PhaseSpaceWriterMessenger.hh"
+
+#include "G4RunManager.hh"
+#include "G4Event.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4Threading.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+  // records kept in memory before each write
+  const size_t kBufferSize = 4096;
+}
+
+G4ThreadLocal B1PhaseSpaceWriter* B1PhaseSpaceWriter::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhaseSpaceWriter* B1PhaseSpaceWriter::Instance()
+{
+  if (!fInstance) fInstance = new B1PhaseSpaceWriter();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhaseSpaceWriter::B1PhaseSpaceWriter()
+: B1WorkerFile("phase-space", ".phsp", "MyCode0006"),
+  fActive(false),
+  fFileName("phsp"),
+  fPlaneZ(1.*mm),
+  fVolumeName(""),
+  fVolume(0),
+  fKill(false),
+  fBuffer(),
+  fNofRecords(0),
+  fMessenger(0)
+{
+  fMessenger = new B1PhaseSpaceWriterMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhaseSpaceWriter::~B1PhaseSpaceWriter()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhaseSpaceWriter::BeginOfRun()
+{
+  if (!fActive) return;
+
+  // in MT mode the master only merges the worker files
+  if (IsMasterOfWorkers()) return;
+
+  if (!OpenFile(fFileName)) {
+    fActive = false;
+    return;
+  }
+
+  fNofRecords = 0;
+  fBuffer.clear();
+  fBuffer.reserve(kBufferSize);
+
+  if (!fVolumeName.empty() && !fVolume) {
+    fVolume
+      = G4LogicalVolumeStore::GetInstance()->GetVolume(fVolumeName, false);
+    if (!fVolume && G4Threading::G4GetThreadId() <= 0) {
+      G4ExceptionDescription msg;
+      msg << "No volume " << fVolumeName
+          << ", no particle is recorded on its surface.";
+      G4Exception("B1PhaseSpaceWriter::BeginOfRun()",
+                  "MyCode0006", JustWarning, msg);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhaseSpaceWriter::EndOfRun(G4int nofEvents)
+{
+  if (!fActive) return;
+
+  if (IsMasterOfWorkers()) {
+    uint64_t nofRecords = 0;
+    uint64_t nofHistories = 0;
+    MergeFiles(fFileName, nofRecords, nofHistories);
+    G4cout << " Phase space: " << nofRecords << " particles from "
+           << nofHistories << " events written to " << fFileName << ".phsp"
+           << G4endl;
+    return;
+  }
+
+  if (!IsFileOpen()) return;
+  Flush();
+  CloseFile(fNofRecords, nofEvents);
+
+  if (!G4Threading::IsWorkerThread()) {
+    G4cout << " Phase space: " << fNofRecords << " particles from "
+           << nofEvents << " events written to " << fFileName << ".phsp"
+           << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhaseSpaceWriter::ProcessStep(const G4Step* step)
+{
+  const G4StepPoint* preStep = step->GetPreStepPoint();
+  const G4StepPoint* postStep = step->GetPostStepPoint();
+
+  G4ThreeVector position, direction;
+  G4double energy;
+
+  if (!fVolumeName.empty()) {
+    // surface mode: the step ends on the boundary of the volume
+    if (!fVolume || postStep->GetStepStatus() != fGeomBoundary) return;
+    G4VPhysicalVolume* next = postStep->GetPhysicalVolume();
+    if (!next || next->GetLogicalVolume() != fVolume) return;
+    position = postStep->GetPosition();
+    direction = postStep->GetMomentumDirection();
+    energy = postStep->GetKineticEnergy();
+  }
+  else {
+    // plane mode: the plane is not a volume boundary, so the crossing
+    // point is interpolated along the (straight) step
+    G4double z1 = preStep->GetPosition().z();
+    G4double z2 = postStep->GetPosition().z();
+    if (!(z1 > fPlaneZ && z2 <= fPlaneZ)) return;
+    G4double t = (z1 - fPlaneZ)/(z1 - z2);
+    position = preStep->GetPosition()
+             + t*(postStep->GetPosition() - preStep->GetPosition());
+    position.setZ(fPlaneZ);
+    direction = preStep->GetMomentumDirection();
+    energy = preStep->GetKineticEnergy();
+    if (step->GetTrack()->GetDefinition()->GetPDGCharge() != 0.) {
+      energy -= t*(preStep->GetKineticEnergy() - postStep->GetKineticEnergy());
+    }
+  }
+
+  B1PhaseSpaceRecord record;
+  record.energy = energy/MeV;
+  record.x = position.x()/mm;
+  record.y = position.y()/mm;
+  record.z = position.z()/mm;
+  record.u = direction.x();
+  record.v = direction.y();
+  record.w = direction.z();
+  record.weight = preStep->GetWeight();
+  record.eventID = G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID();
+  record.pdg = step->GetTrack()->GetDefinition()->GetPDGEncoding();
+
+  fBuffer.push_back(record);
+  if (fBuffer.size() >= kBufferSize) Flush();
+
+  if (fKill) step->GetTrack()->SetTrackStatus(fStopAndKill);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhaseSpaceWriter::Flush()
+{
+  if (fBuffer.empty()) return;
+  WriteToFile(&fBuffer[0], fBuffer.size()*sizeof(B1PhaseSpaceRecord));
+  fNofRecords += fBuffer.size();
+  fBuffer.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhaseSpaceWriter::WriteHeader(std::ostream& file, uint64_t nofRecords,
+                                     uint64_t nofHistories) const
+{
+  B1PhaseSpaceHeader header;
+  std::memcpy(header.magic, kB1PhaseSpaceMagic, sizeof(header.magic));
+  header.nofRecords = nofRecords;
+  header.nofHistories = nofHistories;
+  header.planeZ = fVolumeName.empty() ? fPlaneZ/mm : 0.;
+  header.recordSize = sizeof(B1PhaseSpaceRecord);
+  header.reserved = 0;
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PhaseSpaceWriter::ReadHeader(std::istream& file,
+                                      uint64_t& nofRecords,
+                                      uint64_t& nofHistories) const
+{
+  B1PhaseSpaceHeader header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!file || std::memcmp(header.magic, kB1PhaseSpaceMagic, 8) != 0)
+    return false;
+  nofRecords = header.nofRecords;
+  nofHistories = header.nofHistories;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
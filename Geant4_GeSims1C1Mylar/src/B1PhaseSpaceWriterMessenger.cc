@@ -0,0 +1,114 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PhaseSpaceWriterMessenger.cc
+/// \brief Implementation of the B1PhaseSpaceWriterMessenger class
+
+#include "B1PhaseSpaceWriterMessenger.hh"
+#include "B1PhaseSpaceWriter.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhaseSpaceWriterMessenger::B1PhaseSpaceWriterMessenger(
+                                                  B1PhaseSpaceWriter* writer)
+: G4UImessenger(),
+  fWriter(writer)
+{
+  fPhspDir = new G4UIdirectory("/B1/phsp/");
+  fPhspDir->SetGuidance("Phase-space recording");
+
+  fRecordCmd = new G4UIcmdWithABool("/B1/phsp/record",this);
+  fRecordCmd->SetGuidance("Record particles crossing the scoring plane or");
+  fRecordCmd->SetGuidance("entering the scoring volume.");
+  fRecordCmd->SetParameterName("record",true);
+  fRecordCmd->SetDefaultValue(true);
+  fRecordCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileNameCmd = new G4UIcmdWithAString("/B1/phsp/fileName",this);
+  fFileNameCmd->SetGuidance("Set the output file name (without .phsp).");
+  fFileNameCmd->SetParameterName("fileName",false);
+  fFileNameCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPlaneZCmd = new G4UIcmdWithADoubleAndUnit("/B1/phsp/planeZ",this);
+  fPlaneZCmd->SetGuidance("Score on the plane z = planeZ, for particles");
+  fPlaneZCmd->SetGuidance("crossing it towards -z (the detector side).");
+  fPlaneZCmd->SetParameterName("planeZ",false);
+  fPlaneZCmd->SetUnitCategory("Length");
+  fPlaneZCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fVolumeCmd = new G4UIcmdWithAString("/B1/phsp/volume",this);
+  fVolumeCmd->SetGuidance("Score on entry into this logical volume");
+  fVolumeCmd->SetGuidance("(e.g. Shape2) instead of a plane.");
+  fVolumeCmd->SetParameterName("volume",false);
+  fVolumeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fKillCmd = new G4UIcmdWithABool("/B1/phsp/kill",this);
+  fKillCmd->SetGuidance("Kill particles once recorded.");
+  fKillCmd->SetParameterName("kill",true);
+  fKillCmd->SetDefaultValue(true);
+  fKillCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhaseSpaceWriterMessenger::~B1PhaseSpaceWriterMessenger()
+{
+  delete fRecordCmd;
+  delete fFileNameCmd;
+  delete fPlaneZCmd;
+  delete fVolumeCmd;
+  delete fKillCmd;
+  delete fPhspDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhaseSpaceWriterMessenger::SetNewValue(G4UIcommand* command,
+                                              G4String newValue)
+{
+  if (command == fRecordCmd) {
+    fWriter->SetActive(fRecordCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fFileNameCmd) {
+    fWriter->SetFileName(newValue);
+  }
+  else if (command == fPlaneZCmd) {
+    fWriter->SetPlaneZ(fPlaneZCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fVolumeCmd) {
+    fWriter->SetVolume(newValue);
+  }
+  else if (command == fKillCmd) {
+    fWriter->SetKill(fKillCmd->GetNewBoolValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,228 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PileupDigitizer.cc
+/// \brief Implementation of the B1PileupDigitizer class
+
+#include "B1PileupDigitizer.hh"
+#include "B1PileupDigitizerMessenger.hh"
+#include "B1Analysis.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <cfloat>
+
+namespace {
+  // pending pulses; beyond this the oldest is resolved early
+  const size_t kBufferCapacity = 4096;
+}
+
+G4ThreadLocal B1PileupDigitizer* B1PileupDigitizer::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PileupDigitizer* B1PileupDigitizer::Instance()
+{
+  if (!fInstance) fInstance = new B1PileupDigitizer();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PileupDigitizer::B1PileupDigitizer()
+: fActive(false),
+  fActivity(1.e4*becquerel),
+  fShapingTime(6.*microsecond),
+  fDeadTime(10.*microsecond),
+  fParalyzable(false),
+  fThreshold(0.),
+  fTime(0.),
+  fDeadUntil(0.),
+  fBuffer(kBufferCapacity),
+  fHead(0),
+  fSize(0),
+  fH1(-1),
+  fRealTime(0.),
+  fNofPulses(0.),
+  fNofRecorded(0.),
+  fNofPiledUp(0.),
+  fNofLost(0.),
+  fMessenger(0)
+{
+  fMessenger = new B1PileupDigitizerMessenger(this);
+
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fRealTime);
+  accumulableManager->RegisterAccumulable(fNofPulses);
+  accumulableManager->RegisterAccumulable(fNofRecorded);
+  accumulableManager->RegisterAccumulable(fNofPiledUp);
+  accumulableManager->RegisterAccumulable(fNofLost);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PileupDigitizer::~B1PileupDigitizer()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PileupDigitizer::BeginOfRun()
+{
+  if (!fActive) return;
+
+  if (fH1 < 0) {
+    G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+    fH1 = analysisManager->CreateH1("Edep1_pileup",
+            "Energy recorded in Ge detector with pile-up and dead time",
+            20001, -0.0005*MeV, 20.0005*MeV);
+  }
+  fTime = 0.;
+  fDeadUntil = -DBL_MAX;
+  fHead = 0;
+  fSize = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PileupDigitizer::ProcessEvent(G4double edep)
+{
+  // every event is a decay, whether it reaches the Ge or not
+  fTime += G4RandExponential::shoot(1./fActivity);
+  if (edep <= 0.) return;
+
+  fNofPulses += 1.;
+  Pulse pulse = { fTime, edep };
+  Push(pulse);
+  Process(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PileupDigitizer::EndOfRun()
+{
+  if (!fActive) return;
+  Process(true);
+  fRealTime += fTime;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PileupDigitizer::Push(const Pulse& pulse)
+{
+  // very high rate: resolve the oldest pulse without full look-ahead
+  if (fSize == fBuffer.size()) ResolveOldest();
+
+  fBuffer[(fHead + fSize) % fBuffer.size()] = pulse;
+  ++fSize;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PileupDigitizer::Process(G4bool flush)
+{
+  while (fSize > 0) {
+    // wait until no later pulse can pile up on the oldest one
+    if (!flush && fTime - fBuffer[fHead].time < fShapingTime) return;
+    ResolveOldest();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PileupDigitizer::ResolveOldest()
+{
+  const size_t capacity = fBuffer.size();
+  G4double start = fBuffer[fHead].time;
+  G4double energy = fBuffer[fHead].energy;
+  fHead = (fHead + 1) % capacity;
+  --fSize;
+
+  if (start < fDeadUntil) {
+    fNofLost += 1.;
+    if (fParalyzable) fDeadUntil = std::max(fDeadUntil, start + fDeadTime);
+    return;
+  }
+
+  // pile-up within the shaping time; with a paralyzable dead time the
+  // piled-up pulses retrigger it too
+  fDeadUntil = start + std::max(fShapingTime, fDeadTime);
+  while (fSize > 0 && fBuffer[fHead].time - start < fShapingTime) {
+    energy += fBuffer[fHead].energy;
+    if (fParalyzable)
+      fDeadUntil = std::max(fDeadUntil, fBuffer[fHead].time + fDeadTime);
+    fNofPiledUp += 1.;
+    fHead = (fHead + 1) % capacity;
+    --fSize;
+  }
+  Record(energy);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PileupDigitizer::Record(G4double energy)
+{
+  if (energy <= fThreshold) return;
+  fNofRecorded += 1.;
+  G4AnalysisManager::Instance()->FillH1(fH1, energy);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PileupDigitizer::Print() const
+{
+  if (!fActive || fNofPulses.GetValue() <= 0.) return;
+
+  G4double pulses = fNofPulses.GetValue();
+  G4double realTime = fRealTime.GetValue();
+  G4cout
+     << " Ge digitizer at " << G4BestUnit(fActivity,"Activity")
+     << ", shaping " << G4BestUnit(fShapingTime,"Time")
+     << ", dead time " << G4BestUnit(fDeadTime,"Time")
+     << (fParalyzable ? " (paralyzable)" : " (non-paralyzable)")
+     << G4endl
+     << "  real time " << G4BestUnit(realTime,"Time")
+     << ", Ge pulses " << pulses
+     << ", recorded " << fNofRecorded.GetValue()
+     << ", piled up " << fNofPiledUp.GetValue()
+     << ", lost in dead time " << fNofLost.GetValue()
+     << G4endl
+     << "  input rate " << pulses/realTime*second << " /s"
+     << ", output rate " << fNofRecorded.GetValue()/realTime*second << " /s"
+     << ", dead-time losses " << 100.*fNofLost.GetValue()/pulses << " %"
+     << ", pile-up fraction " << 100.*fNofPiledUp.GetValue()/pulses << " %"
+     << G4endl
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,126 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PileupDigitizerMessenger.cc
+/// \brief Implementation of the B1PileupDigitizerMessenger class
+
+#include "B1PileupDigitizerMessenger.hh"
+#include "B1PileupDigitizer.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PileupDigitizerMessenger::B1PileupDigitizerMessenger(
+                              B1PileupDigitizer* digitizer)
+: G4UImessenger(),
+  fDigitizer(digitizer)
+{
+  fDigiDir = new G4UIdirectory("/B1/digi/");
+  fDigiDir->SetGuidance("Pile-up and dead time of the Ge readout");
+
+  fActiveCmd = new G4UIcmdWithABool("/B1/digi/active",this);
+  fActiveCmd->SetGuidance("Fill the Edep1_pileup spectrum.");
+  fActiveCmd->SetParameterName("active",true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fActivityCmd = new G4UIcmdWithADoubleAndUnit("/B1/digi/activity",this);
+  fActivityCmd->SetGuidance("Source activity, one event per decay.");
+  fActivityCmd->SetParameterName("activity",false);
+  fActivityCmd->SetRange("activity>0.");
+  fActivityCmd->SetUnitCategory("Activity");
+  fActivityCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fShapingTimeCmd = new G4UIcmdWithADoubleAndUnit("/B1/digi/shapingTime",this);
+  fShapingTimeCmd->SetGuidance("Pulses closer than this pile up.");
+  fShapingTimeCmd->SetParameterName("shapingTime",false);
+  fShapingTimeCmd->SetRange("shapingTime>=0.");
+  fShapingTimeCmd->SetUnitCategory("Time");
+  fShapingTimeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fDeadTimeCmd = new G4UIcmdWithADoubleAndUnit("/B1/digi/deadTime",this);
+  fDeadTimeCmd->SetGuidance("Dead time after each recorded pulse.");
+  fDeadTimeCmd->SetParameterName("deadTime",false);
+  fDeadTimeCmd->SetRange("deadTime>=0.");
+  fDeadTimeCmd->SetUnitCategory("Time");
+  fDeadTimeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fParalyzableCmd = new G4UIcmdWithABool("/B1/digi/paralyzable",this);
+  fParalyzableCmd->SetGuidance("Lost pulses extend the dead time.");
+  fParalyzableCmd->SetParameterName("paralyzable",true);
+  fParalyzableCmd->SetDefaultValue(true);
+  fParalyzableCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fThresholdCmd = new G4UIcmdWithADoubleAndUnit("/B1/digi/threshold",this);
+  fThresholdCmd->SetGuidance("Energy threshold of recorded pulses.");
+  fThresholdCmd->SetParameterName("threshold",false);
+  fThresholdCmd->SetRange("threshold>=0.");
+  fThresholdCmd->SetUnitCategory("Energy");
+  fThresholdCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PileupDigitizerMessenger::~B1PileupDigitizerMessenger()
+{
+  delete fActiveCmd;
+  delete fActivityCmd;
+  delete fShapingTimeCmd;
+  delete fDeadTimeCmd;
+  delete fParalyzableCmd;
+  delete fThresholdCmd;
+  delete fDigiDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PileupDigitizerMessenger::SetNewValue(G4UIcommand* command,
+                                             G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fDigitizer->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fActivityCmd) {
+    fDigitizer->SetActivity(fActivityCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fShapingTimeCmd) {
+    fDigitizer->SetShapingTime(fShapingTimeCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fDeadTimeCmd) {
+    fDigitizer->SetDeadTime(fDeadTimeCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fParalyzableCmd) {
+    fDigitizer->SetParalyzable(fParalyzableCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fThresholdCmd) {
+    fDigitizer->SetThreshold(fThresholdCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
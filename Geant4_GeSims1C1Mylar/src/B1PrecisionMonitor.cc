@@ -0,0 +1,96 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PrecisionMonitor.cc
+/// \brief Implementation of the B1PrecisionMonitor class
+
+#include "B1PrecisionMonitor.hh"
+#include "B1PrecisionMonitorMessenger.hh"
+
+B1PrecisionMonitor* B1PrecisionMonitor::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrecisionMonitor* B1PrecisionMonitor::Instance()
+{
+  // first created by the master run action, before any worker starts
+  if (!fInstance) fInstance = new B1PrecisionMonitor();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrecisionMonitor::B1PrecisionMonitor()
+: fPrecision(0.),
+  fVolume("Ge"),
+  fBatchSize(1000),
+  fMinBatches(10),
+  fMutex(),
+  fBatchMeans("BatchMeans"),
+  fReached(false),
+  fMessenger(0)
+{
+  fMessenger = new B1PrecisionMonitorMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrecisionMonitor::~B1PrecisionMonitor()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrecisionMonitor::BeginOfRun()
+{
+  fBatchMeans.Reset();
+  fReached = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrecisionMonitor::AddBatch(G4double mean)
+{
+  if (!IsActive() || fReached) return;
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  fBatchMeans.Fill(mean);
+  if (fBatchMeans.GetEntries() < fMinBatches) return;
+
+  G4double value = fBatchMeans.GetMean();
+  G4double error = fBatchMeans.GetError();
+  if (value <= 0. || error > fPrecision*value) return;
+
+  fReached = true;
+  G4cout << "--> Energy deposit in " << fVolume << " known to "
+         << error/value*100. << " % after "
+         << fBatchMeans.GetEntries() << " batches of " << fBatchSize
+         << " events, stopping the run" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
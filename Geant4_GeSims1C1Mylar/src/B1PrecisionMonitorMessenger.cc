@@ -0,0 +1,106 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PrecisionMonitorMessenger.cc
+/// \brief Implementation of the B1PrecisionMonitorMessenger class
+
+#include "B1PrecisionMonitorMessenger.hh"
+#include "B1PrecisionMonitor.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrecisionMonitorMessenger::B1PrecisionMonitorMessenger(
+                               B1PrecisionMonitor* monitor)
+: G4UImessenger(),
+  fMonitor(monitor)
+{
+  // the monitor is shared by all threads: not broadcast to workers
+  fStatDir = new G4UIdirectory("/B1/stat/", false);
+  fStatDir->SetGuidance("Run statistics and early stopping");
+
+  fPrecisionCmd = new G4UIcmdWithADouble("/B1/stat/precision",this);
+  fPrecisionCmd->SetGuidance("Stop the run once the relative standard");
+  fPrecisionCmd->SetGuidance("error of the monitored energy deposit is");
+  fPrecisionCmd->SetGuidance("below this value (0: never).");
+  fPrecisionCmd->SetParameterName("precision",false);
+  fPrecisionCmd->SetRange("precision>=0.");
+  fPrecisionCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fVolumeCmd = new G4UIcmdWithAString("/B1/stat/volume",this);
+  fVolumeCmd->SetGuidance("Scoring volume monitored for early stopping.");
+  fVolumeCmd->SetParameterName("volume",false);
+  fVolumeCmd->SetCandidates("CWindow Ge SourceWindow");
+  fVolumeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBatchSizeCmd = new G4UIcmdWithAnInteger("/B1/stat/batchSize",this);
+  fBatchSizeCmd->SetGuidance("Events per batch of the batch-means errors.");
+  fBatchSizeCmd->SetParameterName("batchSize",false);
+  fBatchSizeCmd->SetRange("batchSize>0");
+  fBatchSizeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMinBatchesCmd = new G4UIcmdWithAnInteger("/B1/stat/minBatches",this);
+  fMinBatchesCmd->SetGuidance("Batches needed before stopping early.");
+  fMinBatchesCmd->SetParameterName("minBatches",false);
+  fMinBatchesCmd->SetRange("minBatches>1");
+  fMinBatchesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrecisionMonitorMessenger::~B1PrecisionMonitorMessenger()
+{
+  delete fPrecisionCmd;
+  delete fVolumeCmd;
+  delete fBatchSizeCmd;
+  delete fMinBatchesCmd;
+  delete fStatDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrecisionMonitorMessenger::SetNewValue(G4UIcommand* command,
+                                              G4String newValue)
+{
+  if (command == fPrecisionCmd) {
+    fMonitor->SetPrecision(fPrecisionCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fVolumeCmd) {
+    fMonitor->SetVolume(newValue);
+  }
+  else if (command == fBatchSizeCmd) {
+    fMonitor->SetBatchSize(fBatchSizeCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fMinBatchesCmd) {
+    fMonitor->SetMinBatches(fMinBatchesCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
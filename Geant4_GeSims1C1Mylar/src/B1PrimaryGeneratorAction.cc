@@ -28,6 +28,13 @@
 /// \brief Implementation of the B1PrimaryGeneratorAction class
 
 #include "B1PrimaryGeneratorAction.hh"
+#include "B1PrimaryGeneratorMessenger.hh"
+#include "B1EventInformation.hh"
+#include "B1AnalyticSource.hh"
+#include "B1PhaseSpaceSource.hh"
+#include "B1DetectorConstruction.hh"
+#include "B1CorrelatedSampler.hh"
+#include "B1SlowEventDetector.hh"
 
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
@@ -37,19 +44,38 @@
 #include "G4GeneralParticleSource.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
+#include "G4Gamma.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4Event.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4UnitsTable.hh"
+#include "G4Threading.hh"
 #include "Randomize.hh"
 
+#include <fstream>
+#include <sstream>
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1PrimaryGeneratorAction::B1PrimaryGeneratorAction()
 : G4VUserPrimaryGeneratorAction(),
   fParticleSource(nullptr),
+  fAnalyticSource(nullptr),
+  fPhaseSpaceSource(nullptr),
+  fGenerator(kGPS),
   //fParticleGun(0), 
-  fEnvelopeBox(0)
+  fEnvelopeBox(0),
+  fMessenger(0),
+  fUseLines(false),
+  fAngularWarned(false),
+  fLineFile(""),
+  fLineEnergies(),
+  fBranches(),
+  fBranchTable()
 {
-  G4int n_particle = 1;
-  //fParticleGun  = new G4ParticleGun(n_particle);
+  //fParticleGun  = new G4ParticleGun(1);
   fParticleSource = new G4GeneralParticleSource();
 
   // default particle kinematic
@@ -60,6 +86,11 @@ B1PrimaryGeneratorAction::B1PrimaryGeneratorAction()
   fParticleSource->SetParticleDefinition(particle);
   //fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.));
   //fParticleSource->SetCurrentSourceIntensity(1173.237*keV);
+
+  fAnalyticSource = new B1AnalyticSource();
+  fPhaseSpaceSource = new B1PhaseSpaceSource();
+
+  fMessenger = new B1PrimaryGeneratorMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -68,6 +99,9 @@ B1PrimaryGeneratorAction::~B1PrimaryGeneratorAction()
 {
   //delete fParticleGun;
   delete fParticleSource;
+  delete fAnalyticSource;
+  delete fPhaseSpaceSource;
+  delete fMessenger;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -77,6 +111,14 @@ void B1PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
   //this function is called at the begining of each event
   //
 
+  // correlated sampling: the same random stream for the same event of
+  // every geometry variant, starting with the source sampling
+  B1CorrelatedSampler* sampler = B1CorrelatedSampler::Instance();
+  if (sampler->IsActive()) sampler->SeedEvent(anEvent->GetEventID());
+
+  // engine status of a replay, or taken to replay a slow event
+  B1SlowEventDetector::Instance()->StartEvent();
+
   // In order to avoid dependence of PrimaryGeneratorAction
   // on DetectorConstruction class we get Envelope volume
   // from G4LogicalVolumeStore.
@@ -117,8 +159,284 @@ void B1PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
    //->SetParticlePosition(G4ThreeVector(0., 0., 0.*mm));
   
   //fParticleGun->GeneratePrimaryVertex(anEvent);
-  fParticleSource->GeneratePrimaryVertex(anEvent);
+  if ( fGenerator == kAnalytic ) {
+    fAnalyticSource->GeneratePrimaryVertex(anEvent);
+  }
+  else if ( fGenerator == kPhaseSpace ) {
+    // recorded particles keep their own energy
+    fPhaseSpaceSource->GeneratePrimaryVertex(anEvent);
+    return;
+  }
+  else {
+    fParticleSource->GeneratePrimaryVertex(anEvent);
+  }
+
+  // Position and direction come from the generator; in line mode only the
+  // energy of the primary is replaced. This leaves the (shared) GPS data alone,
+  // which keeps it safe in MT mode. Gammas emitted in cascade with the
+  // first one are added to the same vertex with isotropic, uncorrelated
+  // directions, so the first one should be isotropic and unbiased too.
+  if ( fUseLines ) {
+    const std::vector<G4int>& branch = fBranches[fBranchTable.Sample()];
+    G4PrimaryVertex* vertex = anEvent->GetPrimaryVertex(0);
+    if ( branch.size() > 1 && ! fAngularWarned
+         && ! IsIsotropic(vertex->GetPrimary(0)) ) {
+      G4ExceptionDescription msg;
+      msg << "The cascade gammas after the first one are isotropic, but the"
+          << " first one follows a non-isotropic or biased angular"
+          << " distribution: the summing corrections are not valid.";
+      G4Exception("B1PrimaryGeneratorAction::GeneratePrimaries()",
+       "MyCode0004",JustWarning,msg);
+      fAngularWarned = true;
+    }
+
+    B1EventInformation* eventInfo = new B1EventInformation(&fLineEnergies);
+    for ( size_t k = 0; k < branch.size(); ++k ) {
+      G4PrimaryParticle* primary = 0;
+      if ( k == 0 ) {
+        primary = vertex->GetPrimary(0);
+      }
+      else {
+        // no angular correlation with the first gamma, W(theta) = 1
+        primary = new G4PrimaryParticle(G4Gamma::Definition());
+        primary->SetMomentumDirection(IsotropicDirection());
+        vertex->SetPrimary(primary);
+      }
+      G4double energy = fLineEnergies[branch[k]];
+      primary->SetKineticEnergy(energy);
+      eventInfo->AddGamma(branch[k], energy);
+    }
+    anEvent->SetUserInformation(eventInfo);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::LoadLineFile(const G4String& fileName)
+{
+  // one branch per line: "energy(keV) intensity"
+  std::vector< std::vector<G4double> > branches;
+  std::vector<G4double> weights;
+  if ( ! ReadTable(fileName, false, branches, weights) ) return;
+  SetEmissionTable(fileName, branches, weights);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::LoadCascadeFile(const G4String& fileName)
+{
+  // one branch per line: "probability energy1(keV) [energy2 ...]"
+  std::vector< std::vector<G4double> > branches;
+  std::vector<G4double> weights;
+  if ( ! ReadTable(fileName, true, branches, weights) ) return;
+  SetEmissionTable(fileName, branches, weights);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PrimaryGeneratorAction::ReadTable(const G4String& fileName,
+                          G4bool cascade,
+                          std::vector< std::vector<G4double> >& branches,
+                          std::vector<G4double>& weights) const
+{
+  std::ifstream file(fileName);
+  if ( ! file ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open line file " << fileName << ".";
+    G4Exception("B1PrimaryGeneratorAction::ReadTable()",
+     "MyCode0004",JustWarning,msg);
+    return false;
+  }
+
+  std::string line;
+  while ( std::getline(file, line) ) {
+    size_t comment = line.find('#');
+    if ( comment != std::string::npos ) line.erase(comment);
+    std::istringstream input(line);
+
+    std::vector<G4double> energies;
+    G4double weight = 0.;
+    G4double value;
+    if ( cascade ) {
+      if ( !(input >> weight) ) continue;
+      while ( input >> value ) {
+        if ( value > 0. ) energies.push_back(value*keV);
+      }
+    }
+    else {
+      if ( !(input >> value >> weight) ) continue;
+      if ( value > 0. ) energies.push_back(value*keV);
+    }
+    if ( energies.empty() || weight < 0. ) continue;
+    branches.push_back(energies);
+    weights.push_back(weight);
+  }
+
+  if ( branches.empty() ) {
+    G4ExceptionDescription msg;
+    msg << "No gamma lines found in " << fileName << ".";
+    G4Exception("B1PrimaryGeneratorAction::ReadTable()",
+     "MyCode0004",JustWarning,msg);
+    return false;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::SetEmissionTable(const G4String& fileName,
+                    const std::vector< std::vector<G4double> >& branches,
+                    const std::vector<G4double>& weights)
+{
+  // Collect the distinct gamma energies; they define the line indices
+  // used for per-line scoring.
+  fLineEnergies.clear();
+  fBranches.clear();
+  for ( size_t b = 0; b < branches.size(); ++b ) {
+    std::vector<G4int> branch;
+    for ( size_t k = 0; k < branches[b].size(); ++k ) {
+      G4double energy = branches[b][k];
+      size_t line = 0;
+      while ( line < fLineEnergies.size()
+              && std::abs(fLineEnergies[line] - energy) > 1.*eV ) ++line;
+      if ( line == fLineEnergies.size() ) fLineEnergies.push_back(energy);
+      branch.push_back(line);
+    }
+    fBranches.push_back(branch);
+  }
+
+  fLineFile = fileName;
+  fBranchTable.Build(weights);
+  fUseLines = true;
+
+  // print the table once, from the first worker (or sequential mode)
+  if ( G4Threading::G4GetThreadId() <= 0 ) {
+    G4cout << "Loaded " << fBranches.size() << " emission branches with "
+           << fLineEnergies.size() << " gamma lines from "
+           << fileName << G4endl;
+    for ( size_t b = 0; b < fBranches.size(); ++b ) {
+      G4cout << "  p = " << fBranchTable.GetProbability(b) << " :";
+      for ( size_t k = 0; k < fBranches[b].size(); ++k ) {
+        G4cout << " [" << fBranches[b][k] << "] "
+               << G4BestUnit(fLineEnergies[fBranches[b][k]],"Energy");
+      }
+      G4cout << G4endl;
+    }
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void B1PrimaryGeneratorAction::SetEnergyMode(const G4String& mode)
+{
+  if ( mode == "lines" ) {
+    if ( fBranches.empty() ) {
+      G4Exception("B1PrimaryGeneratorAction::SetEnergyMode()",
+       "MyCode0004",JustWarning,
+       "No line table loaded, use /B1/source/lineFile or cascadeFile first.");
+      return;
+    }
+    fUseLines = true;
+  }
+  else {
+    fUseLines = false;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::SetGenerator(const G4String& generator)
+{
+  if ( generator == "phsp" ) {
+    if ( ! fPhaseSpaceSource->IsOpen() ) {
+      G4Exception("B1PrimaryGeneratorAction::SetGenerator()",
+       "MyCode0007",JustWarning,
+       "No phase-space file open, use /B1/source/phspFile first.");
+      return;
+    }
+    fGenerator = kPhaseSpace;
+  }
+  else if ( generator == "analytic" ) {
+    fGenerator = kAnalytic;
+  }
+  else {
+    fGenerator = kGPS;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::OpenPhaseSpace(const G4String& fileName)
+{
+  if ( fPhaseSpaceSource->Open(fileName) ) fGenerator = kPhaseSpace;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::SetPhaseSpaceRecycle(G4int recycle)
+{
+  fPhaseSpaceSource->SetRecycle(recycle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorAction::SetPhaseSpaceRotation(G4bool rotate)
+{
+  // a crystal array is not symmetric about the z axis
+  const B1DetectorConstruction* detectorConstruction
+    = static_cast<const B1DetectorConstruction*>
+      (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  if (rotate && detectorConstruction->GetNumberOfCrystals() > 1) {
+    G4ExceptionDescription msg;
+    msg << "The geometry has " << detectorConstruction->GetNumberOfCrystals()
+        << " crystals and is not symmetric about the z axis;"
+        << " recycled phase-space particles are not rotated.";
+    G4Exception("B1PrimaryGeneratorAction::SetPhaseSpaceRotation()",
+                "MyCode0007", JustWarning, msg);
+    rotate = false;
+  }
+  fPhaseSpaceSource->SetRotation(rotate);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const G4ParticleDefinition*
+B1PrimaryGeneratorAction::GetParticleDefinition() const
+{
+  if ( fGenerator == kAnalytic ) return fAnalyticSource->GetParticleDefinition();
+  return fParticleSource->GetParticleDefinition();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1PrimaryGeneratorAction::GetParticleEnergy() const
+{
+  if ( fGenerator == kAnalytic ) return fAnalyticSource->GetEnergy();
+  return fParticleSource->GetParticleEnergy();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PrimaryGeneratorAction::IsIsotropic(
+                                   const G4PrimaryParticle* primary) const
+{
+  // GPS biasing shows up as a primary weight
+  if ( primary->GetWeight() != 1. ) return false;
+  if ( fGenerator == kAnalytic ) {
+    return fAnalyticSource->GetAngular() == B1AnalyticSource::kIsotropic;
+  }
+  return fParticleSource->GetCurrentSource()->GetAngDist()->GetDistType()
+         == "iso";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector B1PrimaryGeneratorAction::IsotropicDirection() const
+{
+  G4double cosTheta = 2.*G4UniformRand() - 1.;
+  G4double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+  G4double phi = twopi*G4UniformRand();
+  return G4ThreeVector(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,165 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PrimaryGeneratorMessenger.cc
+/// \brief Implementation of the B1PrimaryGeneratorMessenger class
+
+#include "B1PrimaryGeneratorMessenger.hh"
+#include "B1PrimaryGeneratorAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrimaryGeneratorMessenger::B1PrimaryGeneratorMessenger(
+                                          B1PrimaryGeneratorAction* action)
+: G4UImessenger(),
+  fAction(action),
+  fB1Dir(0),
+  fSourceDir(0),
+  fLineFileCmd(0),
+  fCascadeFileCmd(0),
+  fEnergyModeCmd(0),
+  fGeneratorCmd(0),
+  fPhspFileCmd(0),
+  fPhspRecycleCmd(0),
+  fPhspRotateCmd(0)
+{
+  fB1Dir = new G4UIdirectory("/B1/");
+  fB1Dir->SetGuidance("UI commands of the Ge simulation");
+
+  fSourceDir = new G4UIdirectory("/B1/source/");
+  fSourceDir->SetGuidance("Primary source control");
+
+  fLineFileCmd = new G4UIcmdWithAString("/B1/source/lineFile",this);
+  fLineFileCmd->SetGuidance("Load gamma lines of a radionuclide.");
+  fLineFileCmd->SetGuidance("Each line of the file holds an energy in keV");
+  fLineFileCmd->SetGuidance("and an intensity (any normalisation);");
+  fLineFileCmd->SetGuidance("'#' starts a comment. Switches to energyMode lines.");
+  fLineFileCmd->SetParameterName("fileName",false);
+  fLineFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fCascadeFileCmd = new G4UIcmdWithAString("/B1/source/cascadeFile",this);
+  fCascadeFileCmd->SetGuidance("Load decay branches of a radionuclide.");
+  fCascadeFileCmd->SetGuidance("Each line holds a branch probability followed");
+  fCascadeFileCmd->SetGuidance("by the gamma energies in keV emitted together,");
+  fCascadeFileCmd->SetGuidance("e.g. '99.85 1173.237 1332.501' for Co-60.");
+  fCascadeFileCmd->SetGuidance("Switches to energyMode lines.");
+  fCascadeFileCmd->SetGuidance("The cascade gammas are isotropic and uncorrelated:");
+  fCascadeFileCmd->SetGuidance("the angular correlation W(theta) is not sampled, so");
+  fCascadeFileCmd->SetGuidance("the summing factors hold for W(theta) = 1 only.");
+  fCascadeFileCmd->SetGuidance("Keep the source isotropic and unbiased.");
+  fCascadeFileCmd->SetParameterName("fileName",false);
+  fCascadeFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fEnergyModeCmd = new G4UIcmdWithAString("/B1/source/energyMode",this);
+  fEnergyModeCmd->SetGuidance("Select how the primary energy is chosen.");
+  fEnergyModeCmd->SetGuidance("  gps   : as configured with /gps/ene/...");
+  fEnergyModeCmd->SetGuidance("  lines : sampled from the loaded line or cascade table");
+  fEnergyModeCmd->SetParameterName("mode",false);
+  fEnergyModeCmd->SetCandidates("gps lines");
+  fEnergyModeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fGeneratorCmd = new G4UIcmdWithAString("/B1/source/generator",this);
+  fGeneratorCmd->SetGuidance("Select the primary generator.");
+  fGeneratorCmd->SetGuidance("  gps      : G4GeneralParticleSource (/gps/...)");
+  fGeneratorCmd->SetGuidance("  analytic : built-in analytic source (/B1/gun/...)");
+  fGeneratorCmd->SetGuidance("  phsp     : replay of a phase-space file");
+  fGeneratorCmd->SetParameterName("generator",false);
+  fGeneratorCmd->SetCandidates("gps analytic phsp");
+  fGeneratorCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPhspFileCmd = new G4UIcmdWithAString("/B1/source/phspFile",this);
+  fPhspFileCmd->SetGuidance("Replay primaries from a phase-space file written");
+  fPhspFileCmd->SetGuidance("with /B1/phsp/record. Switches to generator phsp.");
+  fPhspFileCmd->SetParameterName("fileName",false);
+  fPhspFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPhspRecycleCmd = new G4UIcmdWithAnInteger("/B1/source/phspRecycle",this);
+  fPhspRecycleCmd->SetGuidance("Use each phase-space history N times,");
+  fPhspRecycleCmd->SetGuidance("see /B1/source/phspRotate.");
+  fPhspRecycleCmd->SetGuidance("Set before /B1/source/phspFile.");
+  fPhspRecycleCmd->SetParameterName("N",false);
+  fPhspRecycleCmd->SetRange("N>=1");
+  fPhspRecycleCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPhspRotateCmd = new G4UIcmdWithABool("/B1/source/phspRotate",this);
+  fPhspRotateCmd->SetGuidance("Rotate each use of a recycled phase-space");
+  fPhspRotateCmd->SetGuidance("history by a random angle about the z axis.");
+  fPhspRotateCmd->SetGuidance("Only for a geometry symmetric about z: refused");
+  fPhspRotateCmd->SetGuidance("for a crystal array. Off by default.");
+  fPhspRotateCmd->SetParameterName("rotate",true);
+  fPhspRotateCmd->SetDefaultValue(true);
+  fPhspRotateCmd->AvailableForStates(G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PrimaryGeneratorMessenger::~B1PrimaryGeneratorMessenger()
+{
+  delete fLineFileCmd;
+  delete fCascadeFileCmd;
+  delete fEnergyModeCmd;
+  delete fGeneratorCmd;
+  delete fPhspFileCmd;
+  delete fPhspRecycleCmd;
+  delete fPhspRotateCmd;
+  delete fSourceDir;
+  delete fB1Dir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command,
+                                              G4String newValue)
+{
+  if (command == fLineFileCmd) {
+    fAction->LoadLineFile(newValue);
+  }
+  else if (command == fCascadeFileCmd) {
+    fAction->LoadCascadeFile(newValue);
+  }
+  else if (command == fEnergyModeCmd) {
+    fAction->SetEnergyMode(newValue);
+  }
+  else if (command == fGeneratorCmd) {
+    fAction->SetGenerator(newValue);
+  }
+  else if (command == fPhspFileCmd) {
+    fAction->OpenPhaseSpace(newValue);
+  }
+  else if (command == fPhspRecycleCmd) {
+    fAction->SetPhaseSpaceRecycle(fPhspRecycleCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fPhspRotateCmd) {
+    fAction->SetPhaseSpaceRotation(fPhspRotateCmd->GetNewBoolValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
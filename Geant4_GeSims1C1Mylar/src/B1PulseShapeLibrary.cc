@@ -0,0 +1,277 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PulseShapeLibrary.cc
+/// \brief Implementation of the B1PulseShapeLibrary class
+
+#include "B1PulseShapeLibrary.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+  // drift steps per sample
+  const G4int kSubSteps = 8;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PulseShapeLibrary::B1PulseShapeLibrary()
+: fPotential(),
+  fVelocity(),
+  fNofSamples(0),
+  fSamplingPeriod(0.),
+  fSignals()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PulseShapeLibrary::~B1PulseShapeLibrary()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PulseShapeLibrary::ReadGrid(const G4String& fileName,
+                                     G4int nofValues, Grid& grid) const
+{
+  std::ifstream file(fileName);
+  if (!file) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open pulse shape grid " << fileName << ".";
+    G4Exception("B1PulseShapeLibrary::ReadGrid()",
+                "MyCode0013", JustWarning, msg);
+    return false;
+  }
+
+  // all numbers of the file, comments stripped
+  std::vector<G4double> numbers;
+  std::string line;
+  while (std::getline(file, line)) {
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) line.erase(comment);
+    std::istringstream input(line);
+    G4double value;
+    while (input >> value) numbers.push_back(value);
+  }
+
+  G4int nofR = numbers.size() >= 6 ? G4int(numbers[0]) : 0;
+  G4int nofZ = numbers.size() >= 6 ? G4int(numbers[3]) : 0;
+  if (nofR < 2 || nofZ < 2
+      || numbers.size() != 6 + size_t(nofR*nofZ*nofValues)
+      || numbers[2] <= numbers[1] || numbers[5] <= numbers[4]) {
+    G4ExceptionDescription msg;
+    msg << "Bad pulse shape grid " << fileName
+        << ": expected nr rmin rmax nz zmin zmax and " << nofValues
+        << " value(s) per node with nr, nz >= 2.";
+    G4Exception("B1PulseShapeLibrary::ReadGrid()",
+                "MyCode0013", JustWarning, msg);
+    return false;
+  }
+
+  grid.nofR = nofR;
+  grid.nofZ = nofZ;
+  grid.rMin = numbers[1]*mm;
+  grid.rMax = numbers[2]*mm;
+  grid.zMin = numbers[4]*mm;
+  grid.zMax = numbers[5]*mm;
+  grid.invDR = (nofR-1)/(grid.rMax - grid.rMin);
+  grid.invDZ = (nofZ-1)/(grid.zMax - grid.zMin);
+  grid.values.assign(numbers.begin()+6, numbers.end());
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PulseShapeLibrary::LoadWeightingPotential(const G4String& fileName)
+{
+  if (!ReadGrid(fileName, 1, fPotential)) return false;
+  fSignals.clear();
+  G4cout << "Loaded " << fPotential.nofR << " x " << fPotential.nofZ
+         << " (r, z) weighting potential from " << fileName << G4endl;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PulseShapeLibrary::LoadDriftVelocity(const G4String& fileName)
+{
+  if (!ReadGrid(fileName, 4, fVelocity)) return false;
+  // velocities are given in mm/ns
+  for (auto& value : fVelocity.values) value *= mm/ns;
+  fSignals.clear();
+  G4cout << "Loaded " << fVelocity.nofR << " x " << fVelocity.nofZ
+         << " (r, z) drift velocities from " << fileName << G4endl;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeLibrary::Locate(const Grid& grid, G4double r, G4double z,
+                                 G4int& ir, G4int& iz,
+                                 G4double& u, G4double& v) const
+{
+  u = (r - grid.rMin)*grid.invDR;
+  v = (z - grid.zMin)*grid.invDZ;
+  u = std::min(std::max(u, 0.), G4double(grid.nofR-1));
+  v = std::min(std::max(v, 0.), G4double(grid.nofZ-1));
+
+  ir = std::min(G4int(u), grid.nofR-2);
+  iz = std::min(G4int(v), grid.nofZ-2);
+  u -= ir;
+  v -= iz;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1PulseShapeLibrary::Interpolate(const Grid& grid, G4int nofValues,
+                                          G4int k, G4double r,
+                                          G4double z) const
+{
+  G4int ir, iz;
+  G4double u, v;
+  Locate(grid, r, z, ir, iz, u, v);
+
+  const G4double* cell = &grid.values[(ir*grid.nofZ + iz)*nofValues + k];
+  const G4int dz = nofValues;
+  const G4int dr = grid.nofZ*nofValues;
+  G4double low  = cell[0] + v*(cell[dz] - cell[0]);
+  G4double high = cell[dr] + v*(cell[dr+dz] - cell[dr]);
+  return low + u*(high - low);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PulseShapeLibrary::IsInside(G4double r, G4double z) const
+{
+  return r <= fPotential.rMax
+      && z >= fPotential.zMin && z <= fPotential.zMax;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PulseShapeLibrary::Build(G4int nofSamples, G4double samplingPeriod)
+{
+  if (fPotential.values.empty() || fVelocity.values.empty()) {
+    G4Exception("B1PulseShapeLibrary::Build()", "MyCode0013", JustWarning,
+                "Weighting potential or drift velocities not loaded.");
+    return false;
+  }
+  if (IsBuilt() && fNofSamples == nofSamples
+      && fSamplingPeriod == samplingPeriod) return true;
+
+  const G4double dt = samplingPeriod/kSubSteps;
+  const G4int nofNodes = fPotential.nofR*fPotential.nofZ;
+  const G4double dR = 1./fPotential.invDR;
+  const G4double dZ = 1./fPotential.invDZ;
+
+  fNofSamples = nofSamples;
+  fSamplingPeriod = samplingPeriod;
+  fSignals.assign(size_t(nofNodes)*nofSamples, 0.f);
+
+  for (G4int node = 0; node < nofNodes; ++node) {
+    const G4double r0 = fPotential.rMin + (node/fPotential.nofZ)*dR;
+    const G4double z0 = fPotential.zMin + (node%fPotential.nofZ)*dZ;
+
+    // carrier positions; k = 0, 1 for electrons, 2, 3 for holes in
+    // the velocity grid. A carrier leaving the grid has reached a
+    // contact and stops there.
+    G4double r[2] = { r0, r0 }, z[2] = { z0, z0 };
+    G4bool drifting[2] = { true, true };
+    G4double wp[2];
+    for (G4int c = 0; c < 2; ++c) {
+      wp[c] = Interpolate(fPotential, 1, 0, r[c], z[c]);
+    }
+
+    float* signal = &fSignals[size_t(node)*nofSamples];
+    for (G4int s = 0; s < nofSamples; ++s) {
+      // induced charge: holes moving up and electrons moving down the
+      // weighting potential both add to the signal
+      signal[s] = float(wp[1] - wp[0]);
+      if (!drifting[0] && !drifting[1]) continue;
+
+      for (G4int c = 0; c < 2; ++c) {
+        if (!drifting[c]) continue;
+        for (G4int step = 0; step < kSubSteps; ++step) {
+          G4double vr = Interpolate(fVelocity, 4, 2*c,   r[c], z[c]);
+          G4double vz = Interpolate(fVelocity, 4, 2*c+1, r[c], z[c]);
+          G4double rNew = std::abs(r[c] + vr*dt);   // axis is a mirror
+          G4double zNew = z[c] + vz*dt;
+          if (vr == 0. && vz == 0.) {
+            drifting[c] = false;
+            break;
+          }
+          if (!IsInside(rNew, zNew)) {
+            r[c] = std::min(rNew, fPotential.rMax);
+            z[c] = std::min(std::max(zNew, fPotential.zMin), fPotential.zMax);
+            drifting[c] = false;
+            break;
+          }
+          r[c] = rNew;
+          z[c] = zNew;
+        }
+        wp[c] = Interpolate(fPotential, 1, 0, r[c], z[c]);
+      }
+    }
+  }
+
+  G4cout << "Built pulse shape library: " << nofNodes << " nodes x "
+         << nofSamples << " samples of " << samplingPeriod/ns << " ns, "
+         << fSignals.size()*sizeof(float)/1024 << " kB" << G4endl;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeLibrary::Accumulate(G4double r, G4double z, G4double weight,
+                                     float* waveform) const
+{
+  G4int ir, iz;
+  G4double u, v;
+  Locate(fPotential, r, z, ir, iz, u, v);
+
+  const size_t n = fNofSamples;
+  const size_t node = size_t(ir)*fPotential.nofZ + iz;
+  const float* s00 = &fSignals[node*n];
+  const float* s01 = s00 + n;
+  const float* s10 = s00 + fPotential.nofZ*n;
+  const float* s11 = s10 + n;
+  const float w00 = float(weight*(1.-u)*(1.-v));
+  const float w01 = float(weight*(1.-u)*v);
+  const float w10 = float(weight*u*(1.-v));
+  const float w11 = float(weight*u*v);
+
+  // branch-free loop over samples, vectorised in optimised builds
+  for (size_t i = 0; i < n; ++i) {
+    waveform[i] += w00*s00[i] + w01*s01[i] + w10*s10[i] + w11*s11[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
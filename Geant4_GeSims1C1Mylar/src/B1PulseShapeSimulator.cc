@@ -0,0 +1,283 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PulseShapeSimulator.cc
+/// \brief Implementation of the B1PulseShapeSimulator class
+
+#include "B1PulseShapeSimulator.hh"
+#include "B1PulseShapeSimulatorMessenger.hh"
+#include "B1WaveformFile.hh"
+
+#include "G4Step.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+  // events waiting for synthesis before the event loop has to wait
+  const size_t kMaxQueued = 4096;
+}
+
+B1PulseShapeSimulator* B1PulseShapeSimulator::fInstance = 0;
+G4ThreadLocal std::vector<B1PulseShapeSimulator::Hit>*
+  B1PulseShapeSimulator::fEventHits = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PulseShapeSimulator* B1PulseShapeSimulator::Instance()
+{
+  // first created by the master run action, before any worker starts
+  if (!fInstance) fInstance = new B1PulseShapeSimulator();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PulseShapeSimulator::B1PulseShapeSimulator()
+: fActive(false),
+  fNofSamples(400),
+  fSamplingPeriod(10.*ns),
+  fGain(10.),
+  fNofThreads(2),
+  fFileName("GeWaveforms"),
+  fLibrary(),
+  fRunning(false),
+  fNofWaits(0),
+  fNofWaveforms(0),
+  fMessenger(0)
+{
+  fMessenger = new B1PulseShapeSimulatorMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PulseShapeSimulator::~B1PulseShapeSimulator()
+{
+  EndOfRun();
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PulseShapeSimulator::LoadWeightingPotential(const G4String& fileName)
+{
+  return fLibrary.LoadWeightingPotential(fileName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PulseShapeSimulator::LoadDriftVelocity(const G4String& fileName)
+{
+  return fLibrary.LoadDriftVelocity(fileName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeSimulator::BeginOfRun()
+{
+  if (!fActive) return;
+
+  if (!fLibrary.Build(fNofSamples, fSamplingPeriod)) {
+    G4Exception("B1PulseShapeSimulator::BeginOfRun()", "MyCode0013",
+                JustWarning, "No pulse shape library, waveforms disabled.");
+    fActive = false;
+    return;
+  }
+
+  G4String name = fFileName + ".wave";
+  fFile.open(name, std::ios::binary | std::ios::trunc);
+  if (!fFile) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open waveform file " << name << ", waveforms disabled.";
+    G4Exception("B1PulseShapeSimulator::BeginOfRun()", "MyCode0013",
+                JustWarning, msg);
+    fActive = false;
+    return;
+  }
+  // the header is rewritten with the final count at the end of run
+  B1WaveformFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  fFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  fNofWaveforms = 0;
+  fNofWaits = 0;
+  fRunning = true;
+  for (G4int i = 0; i < std::max(fNofThreads, 1); ++i) {
+    fThreads.push_back(std::thread(&B1PulseShapeSimulator::Synthesize, this));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeSimulator::AddHit(const G4Step* step, G4double edep)
+{
+  if (!fRunning || edep <= 0.) return;
+  if (!fEventHits) fEventHits = new std::vector<Hit>();
+
+  const G4StepPoint* preStep = step->GetPreStepPoint();
+  G4ThreeVector midPoint
+    = 0.5*(preStep->GetPosition() + step->GetPostStepPoint()->GetPosition());
+  G4ThreeVector local = preStep->GetTouchableHandle()->GetHistory()
+                        ->GetTopTransform().TransformPoint(midPoint);
+
+  Hit hit;
+  hit.crystal = preStep->GetTouchableHandle()->GetCopyNumber();
+  hit.r = local.perp();
+  hit.z = local.z();
+  hit.energy = edep/keV;
+  fEventHits->push_back(hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeSimulator::EndOfEvent(G4int eventID)
+{
+  if (!fEventHits || fEventHits->empty()) return;
+
+  Job job;
+  job.eventID = eventID;
+  job.hits.swap(*fEventHits);
+
+  std::unique_lock<std::mutex> lock(fQueueMutex);
+  if (fQueue.size() >= kMaxQueued) {
+    ++fNofWaits;
+    fNotFull.wait(lock, [this] { return fQueue.size() < kMaxQueued; });
+  }
+  fQueue.push_back(std::move(job));
+  lock.unlock();
+  fNotEmpty.notify_one();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeSimulator::Synthesize()
+{
+  std::vector<float> waveform(fLibrary.GetNofSamples());
+
+  while (true) {
+    std::unique_lock<std::mutex> lock(fQueueMutex);
+    fNotEmpty.wait(lock, [this] { return !fQueue.empty() || !fRunning; });
+    if (fQueue.empty()) return;   // stopped and drained
+    Job job = std::move(fQueue.front());
+    fQueue.pop_front();
+    lock.unlock();
+    fNotFull.notify_one();
+
+    // one waveform per hit crystal, hits grouped by stable sort
+    std::stable_sort(job.hits.begin(), job.hits.end(),
+      [](const Hit& a, const Hit& b) { return a.crystal < b.crystal; });
+    size_t first = 0;
+    while (first < job.hits.size()) {
+      G4int crystal = job.hits[first].crystal;
+      G4double energy = 0.;
+      std::fill(waveform.begin(), waveform.end(), 0.f);
+      size_t i = first;
+      for (; i < job.hits.size() && job.hits[i].crystal == crystal; ++i) {
+        const Hit& hit = job.hits[i];
+        fLibrary.Accumulate(hit.r*mm, hit.z*mm, hit.energy, &waveform[0]);
+        energy += hit.energy;
+      }
+      Write(job.eventID, crystal, energy, waveform);
+      first = i;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeSimulator::Write(G4int eventID, G4int crystal,
+                                  G4double energy,
+                                  const std::vector<float>& waveform)
+{
+  B1WaveformHeader header;
+  header.eventID = eventID;
+  header.crystal = crystal;
+  header.energy = energy;
+
+  // samples in keV of induced charge, converted to ADC units
+  std::vector<int16_t> samples(waveform.size());
+  for (size_t i = 0; i < waveform.size(); ++i) {
+    G4double adc = std::round(waveform[i]*fGain);
+    samples[i] = int16_t(std::min(std::max(adc, -32768.), 32767.));
+  }
+
+  std::lock_guard<std::mutex> lock(fFileMutex);
+  fFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  fFile.write(reinterpret_cast<const char*>(&samples[0]),
+              samples.size()*sizeof(int16_t));
+  ++fNofWaveforms;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeSimulator::EndOfThreadRun()
+{
+  delete fEventHits;
+  fEventHits = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeSimulator::EndOfRun()
+{
+  if (!fRunning) return;
+
+  {
+    std::lock_guard<std::mutex> lock(fQueueMutex);
+    fRunning = false;
+  }
+  fNotEmpty.notify_all();
+  for (auto& thread : fThreads) thread.join();
+  fThreads.clear();
+
+  B1WaveformFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kB1WaveformMagic, sizeof(header.magic));
+  header.nofWaveforms = fNofWaveforms;
+  header.samplingPeriod = fSamplingPeriod/ns;
+  header.gain = fGain;
+  header.nofSamples = fLibrary.GetNofSamples();
+  fFile.seekp(0);
+  fFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  fFile.close();
+
+  G4cout << " Ge waveforms: " << fNofWaveforms << " of "
+         << header.nofSamples << " samples written to " << fFileName
+         << ".wave";
+  if (fNofWaits > 0) {
+    G4cout << "; the event loop waited " << fNofWaits
+           << " times for the synthesis, consider more /B1/pulse/threads";
+  }
+  G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,147 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PulseShapeSimulatorMessenger.cc
+/// \brief Implementation of the B1PulseShapeSimulatorMessenger class
+
+#include "B1PulseShapeSimulatorMessenger.hh"
+#include "B1PulseShapeSimulator.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PulseShapeSimulatorMessenger::B1PulseShapeSimulatorMessenger(
+                                  B1PulseShapeSimulator* simulator)
+: G4UImessenger(),
+  fSimulator(simulator)
+{
+  // the simulator is shared by all threads: not broadcast to workers
+  fPulseDir = new G4UIdirectory("/B1/pulse/", false);
+  fPulseDir->SetGuidance("Ge pulse shape simulation");
+
+  fActiveCmd = new G4UIcmdWithABool("/B1/pulse/active",this);
+  fActiveCmd->SetGuidance("Write the waveforms of the Ge events.");
+  fActiveCmd->SetParameterName("active",true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPotentialCmd = new G4UIcmdWithAString("/B1/pulse/weightingPotential",this);
+  fPotentialCmd->SetGuidance("Read the (r, z) weighting potential grid.");
+  fPotentialCmd->SetParameterName("fileName",false);
+  fPotentialCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fVelocityCmd = new G4UIcmdWithAString("/B1/pulse/driftVelocity",this);
+  fVelocityCmd->SetGuidance("Read the (r, z) electron and hole drift");
+  fVelocityCmd->SetGuidance("velocity grid.");
+  fVelocityCmd->SetParameterName("fileName",false);
+  fVelocityCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fNofSamplesCmd = new G4UIcmdWithAnInteger("/B1/pulse/nofSamples",this);
+  fNofSamplesCmd->SetGuidance("Number of samples per waveform.");
+  fNofSamplesCmd->SetParameterName("nofSamples",false);
+  fNofSamplesCmd->SetRange("nofSamples>0");
+  fNofSamplesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSamplingPeriodCmd
+    = new G4UIcmdWithADoubleAndUnit("/B1/pulse/samplingPeriod",this);
+  fSamplingPeriodCmd->SetGuidance("Time between samples.");
+  fSamplingPeriodCmd->SetParameterName("period",false);
+  fSamplingPeriodCmd->SetRange("period>0.");
+  fSamplingPeriodCmd->SetUnitCategory("Time");
+  fSamplingPeriodCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fGainCmd = new G4UIcmdWithADouble("/B1/pulse/gain",this);
+  fGainCmd->SetGuidance("ADC units per keV of collected charge.");
+  fGainCmd->SetParameterName("gain",false);
+  fGainCmd->SetRange("gain>0.");
+  fGainCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fNofThreadsCmd = new G4UIcmdWithAnInteger("/B1/pulse/threads",this);
+  fNofThreadsCmd->SetGuidance("Synthesis threads, besides the event loop.");
+  fNofThreadsCmd->SetParameterName("nofThreads",false);
+  fNofThreadsCmd->SetRange("nofThreads>0");
+  fNofThreadsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileNameCmd = new G4UIcmdWithAString("/B1/pulse/fileName",this);
+  fFileNameCmd->SetGuidance("Waveform file name, without the .wave");
+  fFileNameCmd->SetParameterName("fileName",false);
+  fFileNameCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PulseShapeSimulatorMessenger::~B1PulseShapeSimulatorMessenger()
+{
+  delete fActiveCmd;
+  delete fPotentialCmd;
+  delete fVelocityCmd;
+  delete fNofSamplesCmd;
+  delete fSamplingPeriodCmd;
+  delete fGainCmd;
+  delete fNofThreadsCmd;
+  delete fFileNameCmd;
+  delete fPulseDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PulseShapeSimulatorMessenger::SetNewValue(G4UIcommand* command,
+                                                 G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fSimulator->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fPotentialCmd) {
+    fSimulator->LoadWeightingPotential(newValue);
+  }
+  else if (command == fVelocityCmd) {
+    fSimulator->LoadDriftVelocity(newValue);
+  }
+  else if (command == fNofSamplesCmd) {
+    fSimulator->SetNofSamples(fNofSamplesCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fSamplingPeriodCmd) {
+    fSimulator->SetSamplingPeriod(
+      fSamplingPeriodCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fGainCmd) {
+    fSimulator->SetGain(fGainCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fNofThreadsCmd) {
+    fSimulator->SetNofThreads(fNofThreadsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fFileNameCmd) {
+    fSimulator->SetFileName(newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
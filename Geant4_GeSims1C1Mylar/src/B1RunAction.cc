@@ -31,6 +31,23 @@
 #include "B1PrimaryGeneratorAction.hh"
 #include "B1DetectorConstruction.hh"
 #include "B1Analysis.hh"
+#include "B1PhaseSpaceWriter.hh"
+#include "B1HitRecorder.hh"
+#include "B1ChargeCollectionMap.hh"
+#include "B1Segmentation.hh"
+#include "B1Benchmark.hh"
+#include "B1PileupDigitizer.hh"
+#include "B1PulseShapeSimulator.hh"
+#include "B1PrecisionMonitor.hh"
+#include "B1TrackKiller.hh"
+#include "B1ImportanceSampler.hh"
+#include "B1EfficiencyEngine.hh"
+#include "B1SelfAbsorption.hh"
+#include "B1CorrelatedSampler.hh"
+#include "B1SlowEventDetector.hh"
+#include "B1EventWatchdog.hh"
+#include "B1AnalyticSource.hh"
+#include "B1PhaseSpaceSource.hh"
 // #include "B1Run.hh"
 
 #include "G4RunManager.hh"
@@ -41,17 +58,41 @@
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
 
+#include <sstream>
+
+namespace {
+  // scoring volumes: accumulable name, monitor name, printout label
+  const char* kVolumeNames[] = { "EdepCWindow", "EdepGe", "EdepSourceWindow" };
+  const char* kVolumeKeys[] = { "CWindow", "Ge", "SourceWindow" };
+  const char* kVolumeLabels[] = { "C Window", "Ge Detector", "Source Window" };
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1RunAction::B1RunAction()
 : G4UserRunAction(),
-  fEdep(0.),
-  fEdep1(0.),
-  fEdep2(0.),
-  fEdep3(0.),
-  fEdep4(0.),
-  fEdep5(0.)
+  fVolumeEdep(),
+  fMonitoredVolume(-1),
+  fFullEnergy(0.),
+  fGeEvents(0.),
+  fLineEmitted("LineEmitted"),
+  fLinePeak("LinePeak"),
+  fLineEnergy("LineEnergy"),
+  fLineSumOut("LineSumOut"),
+  fLineSumIn("LineSumIn"),
+  fCrystalCounts("CrystalCounts"),
+  fCrystalEdep("CrystalEdep"),
+  fMultiplicity("Multiplicity"),
+  fFirstCrystalH1(-1),
+  fSegmentMultiplicity("SegmentMultiplicity"),
+  fClusterMultiplicity("ClusterMultiplicity"),
+  fSegmentH1(-1),
+  fSegmentNtuple(-1),
+  fSegmentIds(),
+  fSegmentEnergies()
 { 
+  for (G4int i = 0; i < kNofVolumes; ++i) fAnalogFOM[i] = 0.;
+
   // add new units for dose
   // 
   const G4double milligray = 1.e-3*gray;
@@ -66,9 +107,22 @@ B1RunAction::B1RunAction()
 
   // Register accumulable to the accumulable manager
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
-  accumulableManager->RegisterAccumulable(fEdep);
-  accumulableManager->RegisterAccumulable(fEdep2); 
-  accumulableManager->RegisterAccumulable(fEdep4); 
+  for (G4int i = 0; i < kNofVolumes; ++i) {
+    fVolumeEdep.push_back(new B1StatAccumulable(kVolumeNames[i]));
+    accumulableManager->RegisterAccumulable(fVolumeEdep[i]);
+  }
+  accumulableManager->RegisterAccumulable(fFullEnergy);
+  accumulableManager->RegisterAccumulable(fGeEvents);
+  accumulableManager->RegisterAccumulable(&fLineEmitted);
+  accumulableManager->RegisterAccumulable(&fLinePeak);
+  accumulableManager->RegisterAccumulable(&fLineEnergy);
+  accumulableManager->RegisterAccumulable(&fLineSumOut);
+  accumulableManager->RegisterAccumulable(&fLineSumIn);
+  accumulableManager->RegisterAccumulable(&fCrystalCounts);
+  accumulableManager->RegisterAccumulable(&fCrystalEdep);
+  accumulableManager->RegisterAccumulable(&fMultiplicity);
+  accumulableManager->RegisterAccumulable(&fSegmentMultiplicity);
+  accumulableManager->RegisterAccumulable(&fClusterMultiplicity);
   
   // Analysis Manager creating histogram
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
@@ -88,12 +142,49 @@ B1RunAction::B1RunAction()
   analysisManager->CreateNtupleDColumn("Edep4");
   
   analysisManager->FinishNtuple();
+
+  // Create the phase-space writer, hit recorder, charge collection map,
+  // segmentation, pile-up digitizer, track killer, importance sampler,
+  // self-absorption tables, slow event detector and event watchdog (and
+  // their commands) for this thread
+  B1PhaseSpaceWriter::Instance();
+  B1HitRecorder::Instance();
+  B1ChargeCollectionMap::Instance();
+  B1Segmentation::Instance();
+  B1PileupDigitizer::Instance();
+  B1TrackKiller::Instance();
+  B1ImportanceSampler::Instance();
+  B1SelfAbsorption::Instance();
+  B1SlowEventDetector::Instance();
+  B1EventWatchdog::Instance();
+  // one pulse shape simulator, precision monitor, efficiency engine and
+  // correlated sampler per process, shared with the workers
+  B1PulseShapeSimulator::Instance();
+  B1PrecisionMonitor::Instance();
+  B1EfficiencyEngine::Instance();
+  B1CorrelatedSampler::Instance();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1RunAction::~B1RunAction()
-{}
+{
+  delete B1PhaseSpaceWriter::Instance();
+  delete B1HitRecorder::Instance();
+  delete B1ChargeCollectionMap::Instance();
+  delete B1Segmentation::Instance();
+  delete B1PileupDigitizer::Instance();
+  delete B1TrackKiller::Instance();
+  delete B1ImportanceSampler::Instance();
+  delete B1SelfAbsorption::Instance();
+  delete B1SlowEventDetector::Instance();
+  delete B1EventWatchdog::Instance();
+  if (IsMaster()) delete B1PulseShapeSimulator::Instance();
+  if (IsMaster()) delete B1PrecisionMonitor::Instance();
+  if (IsMaster()) delete B1EfficiencyEngine::Instance();
+  if (IsMaster()) delete B1CorrelatedSampler::Instance();
+  for (auto stat : fVolumeEdep) delete stat;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -105,6 +196,61 @@ void B1RunAction::BeginOfRunAction(const G4Run*)
   // reset accumulables to their initial values
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Reset();
+
+  // batches of the statistics, and the volume watched for early stopping
+  B1PrecisionMonitor* monitor = B1PrecisionMonitor::Instance();
+  if (IsMaster()) monitor->BeginOfRun();
+  fMonitoredVolume = -1;
+  for (G4int i = 0; i < kNofVolumes; ++i) {
+    fVolumeEdep[i]->SetBatchSize(monitor->GetBatchSize());
+    if (monitor->IsActive() && monitor->GetVolume() == kVolumeKeys[i]) {
+      fMonitoredVolume = i;
+    }
+  }
+
+  // branched event histories only fill the weighted scores
+  const B1DetectorConstruction* detectorConstruction
+   = static_cast<const B1DetectorConstruction*>
+     (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  if (IsMaster() && detectorConstruction->IsForcingCollisions()) {
+    G4ExceptionDescription msg;
+    msg << "With forced collision only the Edep histograms, the run"
+        << " statistics and the full-energy-peak counts are weighted per"
+        << " history; the line, crystal, segment, pile-up, hit, pulse and"
+        << " correlated-sampling scores are disabled.";
+    G4Exception("B1RunAction::BeginOfRunAction()",
+                "MyCode0015", JustWarning, msg);
+  }
+  else if (IsMaster() && B1ImportanceSampler::Instance()->IsActive()) {
+    G4ExceptionDescription msg;
+    msg << "With importance sampling only the Edep histograms, the run"
+        << " statistics and the full-energy-peak counts are weighted per"
+        << " history; the line, crystal, segment, pile-up, hit, pulse and"
+        << " correlated-sampling scores are disabled.";
+    G4Exception("B1RunAction::BeginOfRunAction()",
+                "MyCode0016", JustWarning, msg);
+  }
+
+  // timing for the physics list comparison
+  if (IsMaster()) B1Benchmark::BeginOfRun();
+  // reference outcomes or paired counts of the geometry variants
+  if (IsMaster()) B1CorrelatedSampler::Instance()->BeginOfRun();
+  // the aborted events of all threads
+  if (IsMaster()) B1EventWatchdog::Instance()->BeginOfRun();
+
+  // the number of crystals is only known once the geometry is built
+  BookCrystalHistograms();
+  B1Segmentation::Instance()->BeginOfRun();
+  BookSegmentation();
+  B1PileupDigitizer::Instance()->BeginOfRun();
+  B1TrackKiller::Instance()->BeginOfRun();
+  B1ImportanceSampler::Instance()->BeginOfRun();
+  B1SelfAbsorption::Instance()->BeginOfRun();
+
+  B1PhaseSpaceWriter::Instance()->BeginOfRun();
+  B1HitRecorder::Instance()->BeginOfRun();
+  // started before the workers run their events
+  if (IsMaster()) B1PulseShapeSimulator::Instance()->BeginOfRun();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -112,6 +258,16 @@ void B1RunAction::BeginOfRunAction(const G4Run*)
 void B1RunAction::EndOfRunAction(const G4Run* run)
 {
   G4int nofEvents = run->GetNumberOfEvent();
+
+  // close (workers) or merge (master) the phase-space and hit files
+  B1PhaseSpaceWriter::Instance()->EndOfRun(nofEvents);
+  B1HitRecorder::Instance()->EndOfRun(nofEvents);
+  // pulses still in the digitizer buffer, before the merging
+  B1PileupDigitizer::Instance()->EndOfRun();
+  // all events queued by now: waits for the last waveforms
+  if (IsMaster()) B1PulseShapeSimulator::Instance()->EndOfRun();
+  B1PulseShapeSimulator::Instance()->EndOfThreadRun();
+
   if (nofEvents == 0) return;
 
   // Merge accumulables 
@@ -121,39 +277,7 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
   analysisManager->OpenFile();
 
-  // Compute dose = total energy deposit in a run and its variance
-  //
-  G4double edep  = fEdep.GetValue();
-  G4double edep1 = fEdep1.GetValue();
-  G4double edep2 = fEdep2.GetValue();
-  G4double edep3 = fEdep3.GetValue();
-  G4double edep4 = fEdep4.GetValue();
-  G4double edep5 = fEdep5.GetValue();
-  
-  G4double rms = edep2 - edep*edep/nofEvents;
-  if (rms > 0.) rms = std::sqrt(rms); else rms = 0.;
-  
-  G4double rms1 = edep3 - edep1*edep1/nofEvents;
-  if (rms1 > 0.) rms1 = std::sqrt(rms1); else rms1 = 0.; 
-  
-  G4double rms2 = edep5 - edep4*edep4/nofEvents;
-  if (rms1 > 0.) rms2 = std::sqrt(rms2); else rms2 = 0.;
-
-  const B1DetectorConstruction* detectorConstruction
-   = static_cast<const B1DetectorConstruction*>
-     (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
-     
-  G4double mass = detectorConstruction->GetScoringVolume()->GetMass();
-  G4double dose = edep/mass;
-  G4double rmsDose = rms/mass;
-  
-  G4double mass1 = detectorConstruction->GetScoringVolume1()->GetMass();
-  G4double dose1 = edep1/mass1;
-  G4double rmsDose1 = rms1/mass1;
-  
-  G4double mass2 = detectorConstruction->GetScoringVolume2()->GetMass();
-  G4double dose2 = edep4/mass2;
-  G4double rmsDose2 = rms2/mass2;
+  if (IsMaster()) B1Benchmark::EndOfRun(nofEvents, fFullEnergy.GetValue());
 
   // Run conditions
   //  note: There is no primary generator action object for "master"
@@ -172,11 +296,21 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
     runCondition += G4BestUnit(particleEnergy,"Energy");
     */
     
-    const G4GeneralParticleSource* particleSource = generatorAction->GetParticleSource();
-    runCondition += particleSource->GetParticleDefinition()->GetParticleName();
-    runCondition += " of ";
-    G4double particleEnergy = particleSource->GetParticleEnergy();
-    runCondition += G4BestUnit(particleEnergy,"Energy");
+    if (generatorAction->GetGenerator() == B1PrimaryGeneratorAction::kPhaseSpace) {
+      runCondition += "phase-space particles from ";
+      runCondition += generatorAction->GetPhaseSpaceSource()->GetFileName();
+    }
+    else if (generatorAction->UseLines()) {
+      runCondition += generatorAction->GetParticleDefinition()->GetParticleName();
+      runCondition += " lines from ";
+      runCondition += generatorAction->GetLineFile();
+    }
+    else {
+      runCondition += generatorAction->GetParticleDefinition()->GetParticleName();
+      runCondition += " of ";
+      G4double particleEnergy = generatorAction->GetParticleEnergy();
+      runCondition += G4BestUnit(particleEnergy,"Energy");
+    }
     
   }
         
@@ -193,64 +327,334 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
      << "--------------------End of Local Run------------------------";
   }
   
+  PrintVolumes(nofEvents, runCondition);
+
+  if (fLineEmitted.GetSize() > 0) PrintLineEfficiencies();
+  if (fMultiplicity.GetSize() > 0) PrintCrystals();
+  if (fSegmentMultiplicity.GetSize() > 0) PrintSegmentation();
+  B1PileupDigitizer::Instance()->Print();
+  B1TrackKiller::Instance()->Print();
+  B1ImportanceSampler::Instance()->Print();
+  B1SlowEventDetector::Instance()->Print();
+  B1EventWatchdog::Instance()->Print();
+  if (IsMaster()) PrintFigureOfMerit();
+  if (IsMaster()) B1SelfAbsorption::Instance()->Print();
+  if (IsMaster()) B1CorrelatedSampler::Instance()->Print();
+  if (IsMaster() && generatorAction
+      && generatorAction->GetGenerator() == B1PrimaryGeneratorAction::kAnalytic
+      && !generatorAction->UseLines()) {
+    B1EfficiencyEngine::Instance()->CrossCheck(
+      generatorAction->GetAnalyticSource()->GetEnergy(), nofEvents,
+      fGeEvents.GetValue(), fFullEnergy.GetValue());
+  }
+     
+     // save histograms & ntuple
+     //
+     analysisManager->Write();
+     analysisManager->CloseFile();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::AddEdep(G4int volume, G4double edep)
+{
+  G4bool batchDone = fVolumeEdep[volume]->Fill(edep);
+  if (batchDone && volume == fMonitoredVolume) {
+    B1PrecisionMonitor::Instance()
+      ->AddBatch(fVolumeEdep[volume]->GetLastBatchMean());
+  }
+}
+
+void B1RunAction::AddLineEvent(G4int line, G4double energy,
+                               G4bool fullAbsorbed, G4bool summedOut)
+{
+  fLineEmitted.Add(line, 1.);
+  fLineEnergy.Add(line, energy);
+  if (fullAbsorbed) fLinePeak.Add(line, 1.);
+  if (summedOut) fLineSumOut.Add(line, 1.);
+}
+
+void B1RunAction::AddLineSumIn(G4int line)
+{
+  fLineSumIn.Add(line, 1.);
+}
+
+void B1RunAction::AddCrystalEdep(G4int copyNo, G4double edep)
+{
+  fCrystalCounts.Add(copyNo, 1.);
+  fCrystalEdep.Add(copyNo, edep);
+}
+
+void B1RunAction::AddMultiplicity(G4int multiplicity)
+{
+  fMultiplicity.Add(multiplicity, 1.);
+}
+
+void B1RunAction::AddSegmentEvent(const std::vector<G4int>& segments,
+                                  const std::vector<G4double>& energies,
+                                  G4int nofClusters)
+{
+  G4int multiplicity = segments.size();
+  fSegmentMultiplicity.Add(multiplicity, 1.);
+  fClusterMultiplicity.Add(nofClusters, 1.);
+  if (fSegmentNtuple < 0) return;
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  analysisManager->FillH1(fSegmentH1, multiplicity);
+  analysisManager->FillH1(fSegmentH1+1, nofClusters);
+
+  // the vector columns are bound to these members
+  fSegmentIds = segments;
+  fSegmentEnergies = energies;
+  analysisManager->FillNtupleIColumn(fSegmentNtuple, 0, multiplicity);
+  analysisManager->FillNtupleIColumn(fSegmentNtuple, 1, nofClusters);
+  analysisManager->AddNtupleRow(fSegmentNtuple);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::BookCrystalHistograms()
+{
+  if (fFirstCrystalH1 >= 0) return;
+
+  const B1DetectorConstruction* detectorConstruction
+   = static_cast<const B1DetectorConstruction*>
+     (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  G4int nofCrystals = detectorConstruction->GetNumberOfCrystals();
+  if (nofCrystals <= 1) return;
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  for (G4int i = 0; i < nofCrystals; ++i) {
+    std::ostringstream name, title;
+    name << "Edep1_" << i;
+    title << "Energy deposited in Ge crystal " << i;
+    G4int id = analysisManager->CreateH1(name.str(), title.str(),
+                                20001, -0.0005*MeV, 20.0005*MeV);
+    if (i == 0) fFirstCrystalH1 = id;
+  }
+  analysisManager->CreateH1("Multiplicity", "Number of Ge crystals hit",
+                            nofCrystals+1, -0.5, nofCrystals+0.5);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::BookSegmentation()
+{
+  const B1Segmentation* segmentation = B1Segmentation::Instance();
+  if (fSegmentNtuple >= 0 || !segmentation->IsActive()) return;
+
+  G4int nofSegments = segmentation->GetNumberOfSegments();
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  fSegmentH1 = analysisManager->CreateH1("SegmentMultiplicity",
+                 "Number of Ge segments fired", nofSegments+1,
+                 -0.5, nofSegments+0.5);
+  analysisManager->CreateH1("ClusterMultiplicity",
+                 "Number of clusters of neighbouring Ge segments",
+                 nofSegments+1, -0.5, nofSegments+0.5);
+
+  fSegmentNtuple = analysisManager->CreateNtuple("Segments",
+                     "Fired Ge segments per event");
+  analysisManager->CreateNtupleIColumn("multiplicity");
+  analysisManager->CreateNtupleIColumn("clusters");
+  analysisManager->CreateNtupleIColumn("segment", fSegmentIds);
+  analysisManager->CreateNtupleDColumn("edep", fSegmentEnergies);
+  analysisManager->FinishNtuple();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::PrintSegmentation() const
+{
+  const B1Segmentation* segmentation = B1Segmentation::Instance();
   G4cout
+     << " Ge segmentation " << segmentation->GetNumberOfPhi() << " (phi) x "
+     << segmentation->GetNumberOfZ() << " (z), events per number of"
      << G4endl
-     << " C Window: The run consists of " << nofEvents << " "<< runCondition
-     << G4endl
-     << " Energy deposited in C Window: " << edep
-     << G4endl
-     << " Cumulated dose per run, in scoring volume : " 
-     << G4BestUnit(dose,"Dose") << " rms = " << G4BestUnit(rmsDose,"Dose")
+     << "  segments fired :";
+  for (size_t m = 0; m < fSegmentMultiplicity.GetSize(); ++m) {
+    if (fSegmentMultiplicity.GetValue(m) > 0.)
+      G4cout << " " << m << ":" << fSegmentMultiplicity.GetValue(m);
+  }
+  G4cout << G4endl << "  clusters       :";
+  for (size_t m = 0; m < fClusterMultiplicity.GetSize(); ++m) {
+    if (fClusterMultiplicity.GetValue(m) > 0.)
+      G4cout << " " << m << ":" << fClusterMultiplicity.GetValue(m);
+  }
+  G4cout
      << G4endl
      << "------------------------------------------------------------"
      << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::PrintVolumes(G4int nofEvents,
+                               const G4String& runCondition) const
+{
+  const B1DetectorConstruction* detectorConstruction
+   = static_cast<const B1DetectorConstruction*>
+     (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  G4LogicalVolume* volumes[kNofVolumes] = {
+    detectorConstruction->GetScoringVolume(),
+    detectorConstruction->GetScoringVolume1(),
+    detectorConstruction->GetScoringVolume2() };
+
+  // the uncertainty of the cumulated deposit is nofEvents times the
+  // standard error of the mean deposit per event
+  for (G4int i = 0; i < kNofVolumes; ++i) {
+    const B1StatAccumulable* stat = fVolumeEdep[i];
+    G4double edep = stat->GetSum();
+    G4double rms = nofEvents*stat->GetError();
+    G4double mass = volumes[i]->GetMass();
+    G4double relError = (edep > 0.) ? rms/edep : 0.;
+
+    G4cout
      << G4endl
-     << " Ge Detector: The run consists of " << nofEvents << " "<< runCondition
+     << " " << kVolumeLabels[i] << ": The run consists of " << nofEvents
+     << " "<< runCondition
      << G4endl
-     << " Energy deposited in Ge Detector: " << edep1
+     << " Energy deposited in " << kVolumeLabels[i] << ": "
+     << G4BestUnit(edep,"Energy") << " rms = " << G4BestUnit(rms,"Energy")
+     << " (" << relError*100. << " %)"
      << G4endl
      << " Cumulated dose per run, in scoring volume : " 
-     << G4BestUnit(dose1,"Dose") << " rms = " << G4BestUnit(rmsDose1,"Dose")
-     << G4endl
-     << "------------------------------------------------------------"
-     << G4endl
-     << G4endl
-     << " Source Window: The run consists of " << nofEvents << " "<< runCondition
+     << G4BestUnit(edep/mass,"Dose") << " rms = "
+     << G4BestUnit(rms/mass,"Dose")
      << G4endl
-     << " Energy deposited in Source Window: " << edep1
-     << G4endl
-     << " Cumulated dose per run, in scoring volume : " 
-     << G4BestUnit(dose1,"Dose") << " rms = " << G4BestUnit(rmsDose1,"Dose")
+     << " Mean deposit per event: " << G4BestUnit(stat->GetMean(),"Energy")
+     << " +- " << G4BestUnit(stat->GetError(),"Energy");
+    if (stat->GetNofBatches() > 1.) {
+      G4cout
+       << " (batch means: +- " << G4BestUnit(stat->GetBatchError(),"Energy")
+       << ", " << stat->GetNofBatches() << " batches)";
+    }
+    G4cout
      << G4endl
      << "------------------------------------------------------------"
-     << G4endl
      << G4endl;
-     
-     // save histograms & ntuple
-     //
-     analysisManager->Write();
-     analysisManager->CloseFile();
+  }
+  G4cout << G4endl;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1RunAction::AddEdep(G4double edep)
+void B1RunAction::PrintCrystals() const
 {
-  fEdep  += edep;
-  fEdep2 += edep*edep;
+  G4cout
+     << " Ge crystal array: events with a deposit and mean deposit per crystal"
+     << G4endl;
+  for (size_t i = 0; i < fCrystalCounts.GetSize(); ++i) {
+    G4double counts = fCrystalCounts.GetValue(i);
+    if (counts <= 0.) continue;
+    G4cout
+     << "  crystal " << i << " : " << counts << " events, mean "
+     << G4BestUnit(fCrystalEdep.GetValue(i)/counts,"Energy")
+     << G4endl;
+  }
+  G4cout << " Events per crystal multiplicity :";
+  for (size_t m = 0; m < fMultiplicity.GetSize(); ++m) {
+    G4cout << " " << m << ":" << fMultiplicity.GetValue(m);
+  }
+  G4cout
+     << G4endl
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
 }
 
-void B1RunAction::AddEdep1(G4double edep1)
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::PrintLineEfficiencies() const
 {
-  fEdep1  += edep1;
-  fEdep3 += edep1*edep1;
+  // The master has no line table of its own, so the line energy is
+  // recovered from the merged sum of emitted energies.
+  //
+  // eff      : full-energy-peak efficiency without summing (gamma alone)
+  // apparent : what the peak in the Edep1 spectrum shows,
+  //            (peak - summed out + summed in)/emitted
+  // TCS      : correction factor eff/apparent to apply to measured areas
+  //
+  // The cascade gammas are emitted without angular correlation, so the
+  // summing factors hold for W(theta) = 1 only.
+  G4bool summing = false;
+  G4cout
+     << " Full-energy-peak efficiency in Ge Detector per gamma line"
+     << (B1ChargeCollectionMap::Instance()->IsActive()
+         ? " (collected-charge peak)" : "")
+     << G4endl;
+  for (size_t i = 0; i < fLineEmitted.GetSize(); ++i) {
+    G4double emitted = fLineEmitted.GetValue(i);
+    if (emitted <= 0.) continue;
+    G4double peak = fLinePeak.GetValue(i);
+    G4double sumOut = fLineSumOut.GetValue(i);
+    G4double sumIn = fLineSumIn.GetValue(i);
+    G4double eff = peak/emitted;
+    G4double effErr = std::sqrt(eff*(1.-eff)/emitted);
+    G4cout
+     << "  line " << i << " : " << G4BestUnit(fLineEnergy.GetValue(i)/emitted,"Energy")
+     << " emitted " << emitted << " in peak " << peak
+     << " efficiency = " << eff << " +- " << effErr
+     << G4endl;
+
+    if (sumOut <= 0. && sumIn <= 0.) continue;
+    summing = true;
+    G4double observed = peak - sumOut + sumIn;
+    G4cout
+     << "          summed out " << sumOut << " summed in " << sumIn
+     << " apparent efficiency = " << observed/emitted;
+    if (peak > 0.)
+      G4cout << " summing-out factor = " << (peak - sumOut)/peak;
+    if (peak > sumOut)
+      G4cout << " summing-in factor = " << observed/(peak - sumOut);
+    if (observed > 0.)
+      G4cout << " TCS correction = " << peak/observed;
+    G4cout << G4endl;
+  }
+  if (summing) {
+    G4cout
+     << " Summing factors for isotropic cascade gammas: the angular"
+     << " correlation W(theta) is not sampled." << G4endl;
+  }
+  G4cout
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
 }
 
-void B1RunAction::AddEdep4(G4double edep4)
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RunAction::PrintFigureOfMerit()
 {
-  fEdep4  += edep4;
-  fEdep5 += edep4*edep4;
+  G4double runTime = B1Benchmark::GetRunTime();
+  G4bool analog = !B1ImportanceSampler::Instance()->IsActive();
+  for (G4int i = 0; i < kNofVolumes; ++i) {
+    const B1StatAccumulable* stat = fVolumeEdep[i];
+    G4double relError
+      = (stat->GetMean() > 0.) ? stat->GetError()/stat->GetMean() : 0.;
+    G4double fom
+      = (relError > 0. && runTime > 0.) ? 1./(relError*relError*runTime) : 0.;
+    if (analog) {
+      fAnalogFOM[i] = fom;
+      continue;
+    }
+    if (i == 0) {
+      G4cout
+       << " Figure of merit 1/(R^2 T) of the mean deposit per event, T = "
+       << runTime << " s" << G4endl;
+    }
+    G4cout << "  " << kVolumeLabels[i] << ": R = " << relError*100. << " %";
+    if (fom > 0.) G4cout << ", FOM = " << fom << " /s";
+    if (fom > 0. && fAnalogFOM[i] > 0.) {
+      G4cout << ", " << fom/fAnalogFOM[i] << " times the analog run";
+    }
+    G4cout << G4endl;
+  }
+  if (analog) return;
+  G4cout
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
-
@@ -0,0 +1,167 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1Segmentation.cc
+/// \brief Implementation of the B1Segmentation class
+
+#include "B1Segmentation.hh"
+#include "B1SegmentationMessenger.hh"
+#include "B1DetectorConstruction.hh"
+
+#include "G4RunManager.hh"
+#include "G4Step.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Tubs.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+
+G4ThreadLocal B1Segmentation* B1Segmentation::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1Segmentation* B1Segmentation::Instance()
+{
+  if (!fInstance) fInstance = new B1Segmentation();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1Segmentation::B1Segmentation()
+: fActive(false),
+  fNofPhi(6),
+  fNofZ(3),
+  fThreshold(0.),
+  fNofCrystals(1),
+  fHalfZ(0.),
+  fPhiScale(0.),
+  fZScale(0.),
+  fClusterOf(),
+  fMessenger(0)
+{
+  fMessenger = new B1SegmentationMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1Segmentation::~B1Segmentation()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Segmentation::BeginOfRun()
+{
+  if (!fActive) return;
+
+  const B1DetectorConstruction* detectorConstruction
+    = static_cast<const B1DetectorConstruction*>
+      (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  fNofCrystals = detectorConstruction->GetNumberOfCrystals();
+
+  G4LogicalVolume* crystalLV
+    = G4LogicalVolumeStore::GetInstance()->GetVolume("Shape1");
+  G4Tubs* crystal = crystalLV ? dynamic_cast<G4Tubs*>(crystalLV->GetSolid()) : 0;
+  if (!crystal) {
+    G4Exception("B1Segmentation::BeginOfRun()", "MyCode0011", JustWarning,
+                "Ge crystal Shape1 of tube shape not found, segmentation off.");
+    fActive = false;
+    return;
+  }
+  fHalfZ = crystal->GetZHalfLength();
+  fPhiScale = fNofPhi/twopi;
+  fZScale = 0.5*fNofZ/fHalfZ;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1Segmentation::GetSegment(const G4Step* step) const
+{
+  const G4StepPoint* preStep = step->GetPreStepPoint();
+  const G4TouchableHandle& touchable = preStep->GetTouchableHandle();
+  G4ThreeVector midPoint
+    = 0.5*(preStep->GetPosition() + step->GetPostStepPoint()->GetPosition());
+  G4ThreeVector local
+    = touchable->GetHistory()->GetTopTransform().TransformPoint(midPoint);
+
+  G4double phi = std::atan2(local.y(), local.x());
+  if (phi < 0.) phi += twopi;
+  G4int iPhi = std::min(G4int(phi*fPhiScale), fNofPhi-1);
+  G4int iZ = G4int((local.z() + fHalfZ)*fZScale);
+  iZ = std::max(0, std::min(iZ, fNofZ-1));
+
+  return (touchable->GetCopyNumber()*fNofPhi + iPhi)*fNofZ + iZ;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1Segmentation::AreNeighbours(G4int first, G4int second) const
+{
+  G4int perCrystal = fNofPhi*fNofZ;
+  if (first/perCrystal != second/perCrystal) return false;
+  first %= perCrystal;
+  second %= perCrystal;
+
+  G4int dPhi = std::abs(first/fNofZ - second/fNofZ);
+  G4int dZ = std::abs(first%fNofZ - second%fNofZ);
+  if (dPhi == fNofPhi-1 && fNofPhi > 2) dPhi = 1;
+  return dPhi + dZ == 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1Segmentation::CountClusters(const std::vector<G4int>& fired) const
+{
+  // few segments fire per event, so a quadratic flood fill is enough
+  const G4int nofFired = fired.size();
+  fClusterOf.assign(nofFired, -1);
+  G4int nofClusters = 0;
+  for (G4int seed = 0; seed < nofFired; ++seed) {
+    if (fClusterOf[seed] >= 0) continue;
+    fClusterOf[seed] = nofClusters;
+    std::vector<G4int> stack(1, seed);
+    while (!stack.empty()) {
+      G4int current = stack.back();
+      stack.pop_back();
+      for (G4int other = 0; other < nofFired; ++other) {
+        if (fClusterOf[other] >= 0) continue;
+        if (!AreNeighbours(fired[current], fired[other])) continue;
+        fClusterOf[other] = nofClusters;
+        stack.push_back(other);
+      }
+    }
+    ++nofClusters;
+  }
+  return nofClusters;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,105 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1SegmentationMessenger.cc
+/// \brief Implementation of the B1SegmentationMessenger class
+
+#include "B1SegmentationMessenger.hh"
+#include "B1Segmentation.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SegmentationMessenger::B1SegmentationMessenger(B1Segmentation* segmentation)
+: G4UImessenger(),
+  fSegmentation(segmentation)
+{
+  fSegDir = new G4UIdirectory("/B1/seg/");
+  fSegDir->SetGuidance("Virtual segmentation of the Ge crystal");
+
+  fActiveCmd = new G4UIcmdWithABool("/B1/seg/active",this);
+  fActiveCmd->SetGuidance("Score the Ge deposits per virtual segment.");
+  fActiveCmd->SetParameterName("active",true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fNofPhiCmd = new G4UIcmdWithAnInteger("/B1/seg/nofPhi",this);
+  fNofPhiCmd->SetGuidance("Number of segments in azimuth.");
+  fNofPhiCmd->SetGuidance("The histograms are booked once: PreInit only.");
+  fNofPhiCmd->SetParameterName("nofPhi",false);
+  fNofPhiCmd->SetRange("nofPhi>=1");
+  fNofPhiCmd->AvailableForStates(G4State_PreInit);
+
+  fNofZCmd = new G4UIcmdWithAnInteger("/B1/seg/nofZ",this);
+  fNofZCmd->SetGuidance("Number of segments along the crystal axis.");
+  fNofZCmd->SetGuidance("The histograms are booked once: PreInit only.");
+  fNofZCmd->SetParameterName("nofZ",false);
+  fNofZCmd->SetRange("nofZ>=1");
+  fNofZCmd->AvailableForStates(G4State_PreInit);
+
+  fThresholdCmd = new G4UIcmdWithADoubleAndUnit("/B1/seg/threshold",this);
+  fThresholdCmd->SetGuidance("Energy above which a segment counts as fired.");
+  fThresholdCmd->SetParameterName("threshold",false);
+  fThresholdCmd->SetRange("threshold>=0.");
+  fThresholdCmd->SetUnitCategory("Energy");
+  fThresholdCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SegmentationMessenger::~B1SegmentationMessenger()
+{
+  delete fActiveCmd;
+  delete fNofPhiCmd;
+  delete fNofZCmd;
+  delete fThresholdCmd;
+  delete fSegDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SegmentationMessenger::SetNewValue(G4UIcommand* command,
+                                          G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fSegmentation->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fNofPhiCmd) {
+    fSegmentation->SetNumberOfPhi(fNofPhiCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fNofZCmd) {
+    fSegmentation->SetNumberOfZ(fNofZCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fThresholdCmd) {
+    fSegmentation->SetThreshold(fThresholdCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,254 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1SelfAbsorption.cc
+/// \brief Implementation of the B1SelfAbsorption class
+
+#include "B1SelfAbsorption.hh"
+#include "B1SelfAbsorptionMessenger.hh"
+#include "B1PrimaryGeneratorAction.hh"
+#include "B1AnalyticSource.hh"
+
+#include "G4RunManager.hh"
+#include "G4AccumulableManager.hh"
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4Material.hh"
+#include "G4NistManager.hh"
+#include "G4EmCalculator.hh"
+#include "G4Gamma.hh"
+#include "G4Threading.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+  // path length bins per line
+  const G4int kNofBins = 4000;
+  // gamma processes of the attenuation coefficient
+  const char* kGammaProcesses[] = { "phot", "compt", "Rayl", "conv" };
+}
+
+G4ThreadLocal B1SelfAbsorption* B1SelfAbsorption::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SelfAbsorption* B1SelfAbsorption::Instance()
+{
+  if (!fInstance) fInstance = new B1SelfAbsorption();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SelfAbsorption::B1SelfAbsorption()
+: fActive(false),
+  fMaterials(),
+  fDensities(),
+  fFileName(),
+  fSource(0),
+  fBinWidth(0.1*mm),
+  fPaths(),
+  fPathCounts("SelfAbsPathCounts"),
+  fEnergySum("SelfAbsEnergySum"),
+  fNofFull("SelfAbsNofFull"),
+  fMessenger(0)
+{
+  fMessenger = new B1SelfAbsorptionMessenger(this);
+
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(&fPathCounts);
+  accumulableManager->RegisterAccumulable(&fEnergySum);
+  accumulableManager->RegisterAccumulable(&fNofFull);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SelfAbsorption::~B1SelfAbsorption()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SelfAbsorption::BeginOfRun()
+{
+  fSource = 0;
+  if (!fActive) return;
+
+  // no primary generator on the master of a multithreaded run
+  const B1PrimaryGeneratorAction* generatorAction
+    = static_cast<const B1PrimaryGeneratorAction*>
+      (G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction());
+  if (!generatorAction) return;
+
+  if (generatorAction->GetGenerator() != B1PrimaryGeneratorAction::kAnalytic) {
+    if (G4Threading::G4GetThreadId() <= 0) {
+      G4Exception("B1SelfAbsorption::BeginOfRun()", "MyCode0018", JustWarning,
+                  "The sample is the volume of the analytic source"
+                  " (/B1/source/generator analytic), no path lengths.");
+    }
+    return;
+  }
+  fSource = generatorAction->GetAnalyticSource();
+  if (fSource->GetMaxPathLength() > kNofBins*fBinWidth
+      && G4Threading::G4GetThreadId() <= 0) {
+    G4ExceptionDescription msg;
+    msg << "Source paths up to "
+        << G4BestUnit(fSource->GetMaxPathLength(),"Length")
+        << ", beyond the last path bin; consider a larger"
+        << " /B1/selfabs/binWidth.";
+    G4Exception("B1SelfAbsorption::BeginOfRun()", "MyCode0018",
+                JustWarning, msg);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SelfAbsorption::BeginOfEvent(const G4Event* event)
+{
+  // the primaries in vertex order, as in B1EventInformation
+  fPaths.clear();
+  for (G4int i = 0; i < event->GetNumberOfPrimaryVertex(); ++i) {
+    const G4PrimaryVertex* vertex = event->GetPrimaryVertex(i);
+    for (G4int j = 0; j < vertex->GetNumberOfParticle(); ++j) {
+      fPaths.push_back(fSource->DistanceToOut(vertex->GetPosition(),
+                         vertex->GetPrimary(j)->GetMomentumDirection()));
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SelfAbsorption::AddFullEnergy(G4int line, G4double energy,
+                                     G4int primary)
+{
+  if (primary >= G4int(fPaths.size())) return;
+
+  G4int bin = G4int(fPaths[primary]/fBinWidth);
+  if (bin >= kNofBins) bin = kNofBins - 1;
+  fPathCounts.Add(line*kNofBins + bin, 1.);
+  fEnergySum.Add(line, energy);
+  fNofFull.Add(line, 1.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SelfAbsorption::Print() const
+{
+  if (!fActive || fNofFull.GetSize() == 0) return;
+
+  // matrices at their nominal or at the given densities
+  struct Matrix
+  {
+    const G4Material* material;
+    G4double density;
+  };
+  std::vector<Matrix> matrices;
+  G4NistManager* nist = G4NistManager::Instance();
+  for (const G4String& name : fMaterials) {
+    const G4Material* material = nist->FindOrBuildMaterial(name);
+    if (!material) material = G4Material::GetMaterial(name, false);
+    if (!material) {
+      G4ExceptionDescription msg;
+      msg << "Unknown sample material " << name << ", skipped.";
+      G4Exception("B1SelfAbsorption::Print()", "MyCode0018",
+                  JustWarning, msg);
+      continue;
+    }
+    if (fDensities.empty()) {
+      Matrix matrix = { material, material->GetDensity() };
+      matrices.push_back(matrix);
+    }
+    for (G4double density : fDensities) {
+      Matrix matrix = { material, density };
+      matrices.push_back(matrix);
+    }
+  }
+  if (matrices.empty()) return;
+
+  std::ofstream file;
+  if (!fFileName.empty()) {
+    file.open(fFileName, std::ios::trunc);
+    file << "# energy(keV) material density(g/cm3) correction error"
+         << std::endl;
+  }
+
+  G4cout
+     << " Self-absorption corrections, FEP efficiency with the matrix"
+     << " over the empty sample" << G4endl;
+  G4EmCalculator calculator;
+  for (size_t line = 0; line < fNofFull.GetSize(); ++line) {
+    G4double nofFull = fNofFull.GetValue(line);
+    if (nofFull <= 0.) continue;
+    G4double energy = fEnergySum.GetValue(line)/nofFull;
+    G4cout << "  " << std::setw(12) << G4BestUnit(energy,"Energy")
+           << " (" << nofFull << " FEP gammas)" << G4endl;
+
+    for (const Matrix& matrix : matrices) {
+      // attenuation per unit density
+      G4double mu = 0.;
+      for (const char* process : kGammaProcesses) {
+        mu += calculator.ComputeCrossSectionPerVolume(
+                energy, G4Gamma::Gamma(), process, matrix.material);
+      }
+      mu *= matrix.density/matrix.material->GetDensity();
+
+      G4double sum = 0., sum2 = 0.;
+      for (G4int bin = 0; bin < kNofBins; ++bin) {
+        G4double count = fPathCounts.GetValue(line*kNofBins + bin);
+        if (count <= 0.) continue;
+        G4double weight = std::exp(-mu*(bin + 0.5)*fBinWidth);
+        sum += count*weight;
+        sum2 += count*weight*weight;
+      }
+      G4double correction = sum/nofFull;
+      G4double error = std::sqrt(std::max(0.,
+                         sum2/nofFull - correction*correction)/nofFull);
+
+      G4cout
+         << "    " << matrix.material->GetName() << " at "
+         << matrix.density/(g/cm3) << " g/cm3 : "
+         << correction << " +- " << error << G4endl;
+      if (file.is_open()) {
+        file << energy/keV << " " << matrix.material->GetName() << " "
+             << matrix.density/(g/cm3) << " " << correction << " " << error
+             << std::endl;
+      }
+    }
+  }
+  G4cout
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
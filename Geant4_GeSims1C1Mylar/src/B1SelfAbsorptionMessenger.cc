@@ -0,0 +1,144 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1SelfAbsorptionMessenger.cc
+/// \brief Implementation of the B1SelfAbsorptionMessenger class
+
+#include "B1SelfAbsorptionMessenger.hh"
+#include "B1SelfAbsorption.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SelfAbsorptionMessenger::B1SelfAbsorptionMessenger(
+                             B1SelfAbsorption* selfAbsorption)
+: G4UImessenger(),
+  fSelfAbsorption(selfAbsorption)
+{
+  fSelfAbsDir = new G4UIdirectory("/B1/selfabs/");
+  fSelfAbsDir->SetGuidance("Self-absorption corrections of sample matrices");
+
+  fActiveCmd = new G4UIcmdWithABool("/B1/selfabs/active",this);
+  fActiveCmd->SetGuidance("Score the path lengths in the analytic source.");
+  fActiveCmd->SetParameterName("active",true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMaterialCmd = new G4UIcmdWithAString("/B1/selfabs/material",this);
+  fMaterialCmd->SetGuidance("Add a sample matrix, a NIST or defined material.");
+  fMaterialCmd->SetParameterName("material",false);
+  fMaterialCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearMaterialsCmd
+    = new G4UIcmdWithoutParameter("/B1/selfabs/clearMaterials",this);
+  fClearMaterialsCmd->SetGuidance("Remove all the matrices.");
+  fClearMaterialsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fDensityCmd = new G4UIcmdWithADoubleAndUnit("/B1/selfabs/density",this);
+  fDensityCmd->SetGuidance("Add a matrix density;");
+  fDensityCmd->SetGuidance("without any, the nominal ones.");
+  fDensityCmd->SetParameterName("density",false);
+  fDensityCmd->SetRange("density>0.");
+  fDensityCmd->SetUnitCategory("Volumic Mass");
+  fDensityCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearDensitiesCmd
+    = new G4UIcmdWithoutParameter("/B1/selfabs/clearDensities",this);
+  fClearDensitiesCmd->SetGuidance("Remove all the densities.");
+  fClearDensitiesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBinWidthCmd = new G4UIcmdWithADoubleAndUnit("/B1/selfabs/binWidth",this);
+  fBinWidthCmd->SetGuidance("Bin width of the path length histograms,");
+  fBinWidthCmd->SetGuidance("4000 bins per line.");
+  fBinWidthCmd->SetParameterName("width",false);
+  fBinWidthCmd->SetRange("width>0.");
+  fBinWidthCmd->SetUnitCategory("Length");
+  fBinWidthCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileCmd = new G4UIcmdWithAString("/B1/selfabs/file",this);
+  fFileCmd->SetGuidance("Text file of the correction tables.");
+  fFileCmd->SetParameterName("fileName",false);
+  fFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  // the merged histograms are on the master only
+  fPrintCmd = new G4UIcmdWithoutParameter("/B1/selfabs/print",this);
+  fPrintCmd->SetGuidance("Recompute the tables from the last run.");
+  fPrintCmd->SetToBeBroadcasted(false);
+  fPrintCmd->AvailableForStates(G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SelfAbsorptionMessenger::~B1SelfAbsorptionMessenger()
+{
+  delete fActiveCmd;
+  delete fMaterialCmd;
+  delete fClearMaterialsCmd;
+  delete fDensityCmd;
+  delete fClearDensitiesCmd;
+  delete fBinWidthCmd;
+  delete fFileCmd;
+  delete fPrintCmd;
+  delete fSelfAbsDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SelfAbsorptionMessenger::SetNewValue(G4UIcommand* command,
+                                            G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fSelfAbsorption->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fMaterialCmd) {
+    fSelfAbsorption->AddMaterial(newValue);
+  }
+  else if (command == fClearMaterialsCmd) {
+    fSelfAbsorption->ClearMaterials();
+  }
+  else if (command == fDensityCmd) {
+    fSelfAbsorption->AddDensity(fDensityCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fClearDensitiesCmd) {
+    fSelfAbsorption->ClearDensities();
+  }
+  else if (command == fBinWidthCmd) {
+    fSelfAbsorption->SetBinWidth(fBinWidthCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fFileCmd) {
+    fSelfAbsorption->SetFileName(newValue);
+  }
+  else if (command == fPrintCmd) {
+    fSelfAbsorption->Print();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,329 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1SlowEventDetector.cc
+/// \brief Implementation of the B1SlowEventDetector class
+
+#include "B1SlowEventDetector.hh"
+#include "B1SlowEventDetectorMessenger.hh"
+#include "B1PhaseSpaceWriter.hh"
+#include "B1HitRecorder.hh"
+#include "B1PulseShapeSimulator.hh"
+#include "B1SelfAbsorption.hh"
+#include "B1Benchmark.hh"
+#include "B1Analysis.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4UImanager.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <fstream>
+#include <sstream>
+
+namespace {
+  // name of an output file of the replay run, before its extension
+  G4String ReplayName(const G4String& name)
+  {
+    size_t dot = name.rfind('.');
+    size_t slash = name.rfind('/');
+    if (dot == std::string::npos
+        || (slash != std::string::npos && dot < slash)) {
+      return name + "_replay";
+    }
+    return name.substr(0, dot) + "_replay" + name.substr(dot);
+  }
+
+  // sends an output to its replay file, the command restoring it is kept
+  void Redirect(const G4String& command, const G4String& name,
+                std::vector<G4String>& restore)
+  {
+    G4UImanager::GetUIpointer()->ApplyCommand(
+      command + " " + ReplayName(name));
+    restore.push_back(command + " " + name);
+  }
+}
+
+G4ThreadLocal B1SlowEventDetector* B1SlowEventDetector::fInstance = 0;
+std::vector<unsigned long> B1SlowEventDetector::fReplayStatus;
+std::atomic<bool> B1SlowEventDetector::fReplayPending(false);
+std::mutex B1SlowEventDetector::fFileMutex;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SlowEventDetector* B1SlowEventDetector::Instance()
+{
+  if (!fInstance) fInstance = new B1SlowEventDetector();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SlowEventDetector::B1SlowEventDetector()
+: fActive(false),
+  fTimeThreshold(10.*s),
+  fStepThreshold(0),
+  fFileName("slowEvents.txt"),
+  fReplayVerbose(1),
+  fTimer(),
+  fNofSteps(0),
+  fEngineStatus(),
+  fReplaying(false),
+  fNofEvents(0.),
+  fEventTime(0.),
+  fNofSlow(0.),
+  fMessenger(0)
+{
+  fMessenger = new B1SlowEventDetectorMessenger(this);
+
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fNofEvents);
+  accumulableManager->RegisterAccumulable(fEventTime);
+  accumulableManager->RegisterAccumulable(fNofSlow);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SlowEventDetector::~B1SlowEventDetector()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SlowEventDetector::StartEvent()
+{
+  // the replay overrides the engine status given by the run manager
+  fReplaying = fReplayPending && fReplayPending.exchange(false);
+  if (fReplaying && !G4Random::getTheEngine()->get(fReplayStatus)) {
+    G4Exception("B1SlowEventDetector::StartEvent()", "MyCode0020",
+                JustWarning,
+                "Engine status of another random engine, not replayed.");
+  }
+  if (!IsTiming()) return;
+
+  fEngineStatus = G4Random::getTheEngine()->put();
+  fNofSteps = 0;
+  fTimer.Start();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SlowEventDetector::EndOfEvent(const G4Event* event)
+{
+  fTimer.Stop();
+  G4double time = fTimer.GetRealElapsed()*s;
+
+  if (fReplaying) {
+    fReplaying = false;
+    G4cout << "--> Replayed event took " << G4BestUnit(time,"Time")
+           << " and " << fNofSteps << " steps" << G4endl;
+    return;
+  }
+
+  fNofEvents += 1.;
+  fEventTime += time;
+  if (time < fTimeThreshold
+      && (fStepThreshold <= 0 || fNofSteps < fStepThreshold)) return;
+
+  fNofSlow += 1.;
+  Write(event, time);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SlowEventDetector::Write(const G4Event* event, G4double time) const
+{
+  std::lock_guard<std::mutex> lock(fFileMutex);
+  std::ofstream file(fFileName, std::ios::app);
+  if (!file) {
+    G4ExceptionDescription msg;
+    msg << "Cannot write the slow event file " << fFileName;
+    G4Exception("B1SlowEventDetector::Write()", "MyCode0020",
+                JustWarning, msg);
+    return;
+  }
+
+  // event run eventID time(s) steps
+  file << "event " << G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID()
+       << " " << event->GetEventID() << " " << time/s << " " << fNofSteps
+       << std::endl;
+  file << "rng " << fEngineStatus.size();
+  for (unsigned long word : fEngineStatus) file << " " << word;
+  file << std::endl;
+  // vertex x y z (mm) t (ns), primary name energy (keV) direction
+  for (G4int i = 0; i < event->GetNumberOfPrimaryVertex(); ++i) {
+    const G4PrimaryVertex* vertex = event->GetPrimaryVertex(i);
+    file << "vertex " << vertex->GetX0()/mm << " " << vertex->GetY0()/mm
+         << " " << vertex->GetZ0()/mm << " " << vertex->GetT0()/ns
+         << std::endl;
+    for (G4int j = 0; j < vertex->GetNumberOfParticle(); ++j) {
+      const G4PrimaryParticle* primary = vertex->GetPrimary(j);
+      G4ThreeVector direction = primary->GetMomentumDirection();
+      file << "primary " << primary->GetParticleDefinition()->GetParticleName()
+           << " " << primary->GetKineticEnergy()/keV << " " << direction.x()
+           << " " << direction.y() << " " << direction.z() << std::endl;
+    }
+  }
+  file << "end" << std::endl;
+
+  G4cout << "--> Slow event " << event->GetEventID() << ": "
+         << G4BestUnit(time,"Time") << ", " << fNofSteps
+         << " steps, saved to " << fFileName << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1SlowEventDetector::Read(G4int eventID,
+                                 std::vector<unsigned long>& status) const
+{
+  std::ifstream file(fFileName);
+  if (!file) return false;
+
+  G4bool found = false;
+  G4bool inBlock = false;
+  std::vector<G4String> block;
+  std::vector<G4String> lastBlock;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream input(line);
+    std::string key;
+    input >> key;
+    if (key == "event") {
+      G4int run = -1, id = -1;
+      input >> run >> id;
+      inBlock = (id == eventID);
+      block.clear();
+    }
+    if (!inBlock) continue;
+    block.push_back(line);
+    if (key == "rng") {
+      size_t size = 0;
+      input >> size;
+      status.assign(size, 0);
+      for (size_t i = 0; i < size; ++i) input >> status[i];
+      found = bool(input);
+    }
+    else if (key == "end") {
+      lastBlock = block;
+      inBlock = false;
+    }
+  }
+  if (!found) return false;
+
+  G4cout << "--> Replaying from " << fFileName << ":" << G4endl;
+  for (const G4String& saved : lastBlock) {
+    if (saved.compare(0, 3, "rng") != 0) G4cout << "    " << saved << G4endl;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SlowEventDetector::Replay(G4int eventID)
+{
+  std::vector<unsigned long> status;
+  {
+    std::lock_guard<std::mutex> lock(fFileMutex);
+    if (!Read(eventID, status)) {
+      G4ExceptionDescription msg;
+      msg << "No event " << eventID << " in " << fFileName
+          << ", nothing replayed.";
+      G4Exception("B1SlowEventDetector::Replay()", "MyCode0020",
+                  JustWarning, msg);
+      return;
+    }
+  }
+
+  // taken by the thread that gets the event
+  fReplayStatus = status;
+  fReplayPending = true;
+
+  // the replay is a run of its own: the outputs of the production runs
+  // are kept, the ones of the replay go to <name>_replay files (the
+  // writers stay on, the phase-space one may kill the tracks it records)
+  std::vector<G4String> restore;
+  Redirect("/analysis/setFileName",
+           G4AnalysisManager::Instance()->GetFileName(), restore);
+  B1PhaseSpaceWriter* phaseSpaceWriter = B1PhaseSpaceWriter::Instance();
+  if (phaseSpaceWriter->IsActive())
+    Redirect("/B1/phsp/fileName", phaseSpaceWriter->GetFileName(), restore);
+  B1HitRecorder* hitRecorder = B1HitRecorder::Instance();
+  if (hitRecorder->IsActive())
+    Redirect("/B1/hits/fileName", hitRecorder->GetFileName(), restore);
+  B1PulseShapeSimulator* pulseShapeSimulator = B1PulseShapeSimulator::Instance();
+  if (pulseShapeSimulator->IsActive()) {
+    Redirect("/B1/pulse/fileName", pulseShapeSimulator->GetFileName(),
+             restore);
+  }
+  const G4String& selfAbsorptionFile
+    = B1SelfAbsorption::Instance()->GetFileName();
+  if (!selfAbsorptionFile.empty())
+    Redirect("/B1/selfabs/file", selfAbsorptionFile, restore);
+  G4String reportFile = B1Benchmark::GetReportFile();
+  if (!reportFile.empty()) B1Benchmark::SetReportFile(ReplayName(reportFile));
+
+  std::ostringstream verbose;
+  verbose << "/tracking/verbose " << fReplayVerbose;
+  G4UImanager* uiManager = G4UImanager::GetUIpointer();
+  uiManager->ApplyCommand(verbose.str());
+  G4RunManager::GetRunManager()->BeamOn(1);
+  uiManager->ApplyCommand("/tracking/verbose 0");
+  fReplayPending = false;
+
+  for (const G4String& command : restore) uiManager->ApplyCommand(command);
+  B1Benchmark::SetReportFile(reportFile);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SlowEventDetector::Print() const
+{
+  if (!fActive || fNofEvents.GetValue() <= 0.) return;
+
+  G4double nofEvents = fNofEvents.GetValue();
+  G4cout
+     << " Slow events: " << fNofSlow.GetValue() << " of " << nofEvents
+     << " over " << G4BestUnit(fTimeThreshold,"Time");
+  if (fStepThreshold > 0) G4cout << " or " << fStepThreshold << " steps";
+  G4cout
+     << ", saved to " << fFileName << G4endl
+     << "  mean event time "
+     << G4BestUnit(fEventTime.GetValue()/nofEvents,"Time") << G4endl
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,128 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1SlowEventDetectorMessenger.cc
+/// \brief Implementation of the B1SlowEventDetectorMessenger class
+
+#include "B1SlowEventDetectorMessenger.hh"
+#include "B1SlowEventDetector.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SlowEventDetectorMessenger::B1SlowEventDetectorMessenger(
+                                B1SlowEventDetector* detector)
+: G4UImessenger(),
+  fDetector(detector)
+{
+  fSlowDir = new G4UIdirectory("/B1/slow/");
+  fSlowDir->SetGuidance("Slow event detection and replay");
+
+  fActiveCmd = new G4UIcmdWithABool("/B1/slow/active",this);
+  fActiveCmd->SetGuidance("Time the events and save the slow ones.");
+  fActiveCmd->SetParameterName("active",true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fTimeCmd = new G4UIcmdWithADoubleAndUnit("/B1/slow/time",this);
+  fTimeCmd->SetGuidance("Wall time over which an event is slow.");
+  fTimeCmd->SetParameterName("time",false);
+  fTimeCmd->SetRange("time>0.");
+  fTimeCmd->SetUnitCategory("Time");
+  fTimeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fStepsCmd = new G4UIcmdWithAnInteger("/B1/slow/steps",this);
+  fStepsCmd->SetGuidance("Steps over which an event is slow (0: none).");
+  fStepsCmd->SetParameterName("steps",false);
+  fStepsCmd->SetRange("steps>=0");
+  fStepsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileCmd = new G4UIcmdWithAString("/B1/slow/file",this);
+  fFileCmd->SetGuidance("Side file of the slow events, appended to.");
+  fFileCmd->SetParameterName("fileName",false);
+  fFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fVerboseCmd = new G4UIcmdWithAnInteger("/B1/slow/replayVerbose",this);
+  fVerboseCmd->SetGuidance("Tracking verbose level of the replays.");
+  fVerboseCmd->SetParameterName("level",false);
+  fVerboseCmd->SetRange("level>=0");
+  fVerboseCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  // one event for the whole process
+  fReplayCmd = new G4UIcmdWithAnInteger("/B1/slow/replay",this);
+  fReplayCmd->SetGuidance("Run again the last saved event of this number,");
+  fReplayCmd->SetGuidance("with the settings of the run that saved it.");
+  fReplayCmd->SetGuidance("Its output files are named <name>_replay.");
+  fReplayCmd->SetParameterName("eventID",false);
+  fReplayCmd->SetRange("eventID>=0");
+  fReplayCmd->SetToBeBroadcasted(false);
+  fReplayCmd->AvailableForStates(G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1SlowEventDetectorMessenger::~B1SlowEventDetectorMessenger()
+{
+  delete fActiveCmd;
+  delete fTimeCmd;
+  delete fStepsCmd;
+  delete fFileCmd;
+  delete fVerboseCmd;
+  delete fReplayCmd;
+  delete fSlowDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SlowEventDetectorMessenger::SetNewValue(G4UIcommand* command,
+                                               G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fDetector->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fTimeCmd) {
+    fDetector->SetTimeThreshold(fTimeCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fStepsCmd) {
+    fDetector->SetStepThreshold(fStepsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fFileCmd) {
+    fDetector->SetFileName(newValue);
+  }
+  else if (command == fVerboseCmd) {
+    fDetector->SetReplayVerbose(fVerboseCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fReplayCmd) {
+    fDetector->Replay(fReplayCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
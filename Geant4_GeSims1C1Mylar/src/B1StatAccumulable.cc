@@ -0,0 +1,157 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StatAccumulable.cc
+/// \brief Implementation of the B1StatAccumulable class
+
+#include "B1StatAccumulable.hh"
+
+#include "G4Threading.hh"
+
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StatAccumulable::Moments::Add(G4double value)
+{
+  n += 1.;
+  G4double delta = value - mean;
+  mean += delta/n;
+  m2 += delta*(value - mean);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StatAccumulable::Moments::Add(const Moments& other)
+{
+  if (other.n == 0.) return;
+  G4double total = n + other.n;
+  G4double delta = other.mean - mean;
+  mean += delta*other.n/total;
+  m2 += other.m2 + delta*delta*n*other.n/total;
+  n = total;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StatAccumulable::B1StatAccumulable(const G4String& name)
+: G4VAccumulable(name),
+  fThreadId(G4Threading::G4GetThreadId()),
+  fBatchSize(1000),
+  fLocal(),
+  fBatchSum(0.),
+  fBatchCount(0),
+  fLastBatchMean(0.),
+  fWorkers(),
+  fTotal()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StatAccumulable::~B1StatAccumulable()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1StatAccumulable::Fill(G4double value)
+{
+  fLocal.events.Add(value);
+
+  fBatchSum += value;
+  if (++fBatchCount < fBatchSize) return false;
+
+  // the incomplete last batch only counts in the event moments
+  fLastBatchMean = fBatchSum/fBatchCount;
+  fLocal.batches.Add(fLastBatchMean);
+  fBatchSum = 0.;
+  fBatchCount = 0;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StatAccumulable::Merge(const G4VAccumulable& other)
+{
+  const B1StatAccumulable& otherStat
+    = static_cast<const B1StatAccumulable&>(other);
+
+  State& state = fWorkers[otherStat.fThreadId];
+  state.events.Add(otherStat.fLocal.events);
+  state.batches.Add(otherStat.fLocal.batches);
+  Combine();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StatAccumulable::Combine()
+{
+  fTotal = fLocal;
+  for (const auto& worker : fWorkers) {
+    fTotal.events.Add(worker.second.events);
+    fTotal.batches.Add(worker.second.batches);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StatAccumulable::Reset()
+{
+  fLocal = State();
+  fTotal = State();
+  fWorkers.clear();
+  fBatchSum = 0.;
+  fBatchCount = 0;
+  fLastBatchMean = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1StatAccumulable::GetStdDev() const
+{
+  const Moments& events = GetTotal().events;
+  if (events.n < 2.) return 0.;
+  return std::sqrt(events.m2/(events.n - 1.));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1StatAccumulable::GetError() const
+{
+  const Moments& events = GetTotal().events;
+  if (events.n < 2.) return 0.;
+  return GetStdDev()/std::sqrt(events.n);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1StatAccumulable::GetBatchError() const
+{
+  const Moments& batches = GetTotal().batches;
+  if (batches.n < 2.) return 0.;
+  return std::sqrt(batches.m2/(batches.n - 1.)/batches.n);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -29,18 +29,40 @@
 
 #include "B1SteppingAction.hh"
 #include "B1EventAction.hh"
+#include "B1RunAction.hh"
 #include "B1DetectorConstruction.hh"
+#include "B1PhaseSpaceWriter.hh"
+#include "B1HitRecorder.hh"
+#include "B1ChargeCollectionMap.hh"
+#include "B1Segmentation.hh"
+#include "B1PulseShapeSimulator.hh"
+#include "B1TrackKiller.hh"
+#include "B1ImportanceSampler.hh"
+#include "B1SlowEventDetector.hh"
+#include "B1EventWatchdog.hh"
 
 #include "G4Step.hh"
+#include "G4SteppingManager.hh"
+#include "G4Track.hh"
 #include "G4Event.hh"
 #include "G4RunManager.hh"
 #include "G4LogicalVolume.hh"
+#include "G4BiasingProcessInterface.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1SteppingAction::B1SteppingAction(B1EventAction* eventAction)
 : G4UserSteppingAction(),
   fEventAction(eventAction),
+  fPhaseSpaceWriter(B1PhaseSpaceWriter::Instance()),
+  fHitRecorder(B1HitRecorder::Instance()),
+  fChargeCollectionMap(B1ChargeCollectionMap::Instance()),
+  fSegmentation(B1Segmentation::Instance()),
+  fPulseShapeSimulator(B1PulseShapeSimulator::Instance()),
+  fTrackKiller(B1TrackKiller::Instance()),
+  fImportanceSampler(B1ImportanceSampler::Instance()),
+  fSlowEventDetector(B1SlowEventDetector::Instance()),
+  fEventWatchdog(B1EventWatchdog::Instance()),
   fScoringVolume(0),
   fScoringVolume1(0),
   fScoringVolume2(0)
@@ -78,6 +100,56 @@ void B1SteppingAction::UserSteppingAction(const G4Step* step)
     fScoringVolume2 = detectorConstruction->GetScoringVolume2();   
   }
 
+  // steps of the event, for the slow event detection
+  fSlowEventDetector->AddStep();
+
+  // per-event limits: the event is aborted once over one
+  if (fEventWatchdog->IsActive()) fEventWatchdog->ProcessStep();
+
+  // phase-space recording (may kill the track once recorded)
+  if (fPhaseSpaceWriter->IsActive()) fPhaseSpaceWriter->ProcessStep(step);
+
+  // photons heading away from the scoring volumes (killed after this step)
+  if (fTrackKiller->IsKillingEscapingPhotons()) fTrackKiller->ProcessStep(step);
+
+  // the deposit of this step goes to the branch it was made in
+  ScoreStep(step);
+
+  // splitting and roulette of the gammas owning a branch of the event
+  // history; this step keeps its pre-step weight
+  G4double weight = step->GetPreStepPoint()->GetWeight();
+  if (fEventAction->IsSampling()
+      && fEventAction->OwnsBranch(step->GetTrack()->GetTrackID())) {
+    G4TrackVector* secondaries = fpSteppingManager->GetfSecondary();
+    size_t nofSecondaries = secondaries->size();
+    fImportanceSampler->ProcessStep(step, secondaries);
+    if (secondaries->size() > nofSecondaries)
+      fEventAction->SplitBranch(step->GetTrack(), weight,
+                                secondaries, nofSecondaries);
+  }
+
+  // a gamma entering a forced-collision volume is cloned in a step of
+  // its own: the clone and the gamma are the two outcomes of a split
+  if (fEventAction->IsForcingCollisions()) {
+    const std::vector<const G4Track*>* clones
+      = step->GetSecondaryInCurrentStep();
+    if (clones->empty()) return;
+    for (size_t i = 0; i < clones->size(); ++i) {
+      const G4BiasingProcessInterface* creator
+        = dynamic_cast<const G4BiasingProcessInterface*>
+          ((*clones)[i]->GetCreatorProcess());
+      if (!creator || creator->GetWrappedProcess()) return;
+    }
+    G4TrackVector* secondaries = fpSteppingManager->GetfSecondary();
+    fEventAction->SplitBranch(step->GetTrack(), weight,
+                              secondaries, secondaries->size() - clones->size());
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1SteppingAction::ScoreStep(const G4Step* step)
+{
   // get volume of the current step
   G4LogicalVolume* volume 
     = step->GetPreStepPoint()->GetTouchableHandle()
@@ -93,9 +165,18 @@ void B1SteppingAction::UserSteppingAction(const G4Step* step)
   
   if ((volume != fScoringVolume) && (volume != fScoringVolume1) && (volume != fScoringVolume2)) return;
 
+  // biased tracks carry a weight: in a branched event history every
+  // deposit goes to the branch of the track, weighted per history
+  G4bool branching = fEventAction->IsBranching();
+  G4int trackID = step->GetTrack()->GetTrackID();
+
   if ((volume != fScoringVolume1) && (volume != fScoringVolume2)){
   // collect energy deposited in this step
   G4double edepStep = step->GetTotalEnergyDeposit();
+  if (branching) {
+    fEventAction->AddBranchEdep(B1RunAction::kCWindow, trackID, edepStep);
+    return;
+  }
   fEventAction->AddEdep(edepStep);
   return;
   }
@@ -103,11 +184,37 @@ void B1SteppingAction::UserSteppingAction(const G4Step* step)
   if ((volume != fScoringVolume) && (volume != fScoringVolume2)){
   // collect energy deposited in this step
   G4double edepStep = step->GetTotalEnergyDeposit();
+  if (edepStep <= 0.) return;
+  // weighted deposits only reach the Edep1 histogram
+  if (branching) {
+    if (fChargeCollectionMap->IsActive())
+      edepStep *= fChargeCollectionMap->GetEfficiency(step);
+    fEventAction->AddBranchEdep(B1RunAction::kGe, trackID, edepStep);
+    return;
+  }
+  // hits are recorded before charge collection, re-applied off line
+  if (fHitRecorder->IsActive()) fHitRecorder->AddHit(step, edepStep);
+  if (fPulseShapeSimulator->IsActive())
+    fPulseShapeSimulator->AddHit(step, edepStep);
+  if (fChargeCollectionMap->IsActive())
+    edepStep *= fChargeCollectionMap->GetEfficiency(step);
   fEventAction->AddEdep1(edepStep);
+  if (fTrackKiller->IsValidating())
+    fTrackKiller->AddEdep1(step->GetTrack(), edepStep);
+  fEventAction->AddCrystalEdep(
+    step->GetPreStepPoint()->GetTouchableHandle()->GetCopyNumber(), edepStep);
+  if (fSegmentation->IsActive())
+    fEventAction->AddSegmentEdep(fSegmentation->GetSegment(step), edepStep);
+  if (fEventAction->IsSplittingByPrimary())
+    fEventAction->AddPrimaryEdep1(step->GetTrack()->GetTrackID(), edepStep);
   return;
   }
   
   G4double edepStep = step->GetTotalEnergyDeposit();
+  if (branching) {
+    fEventAction->AddBranchEdep(B1RunAction::kSourceWindow, trackID, edepStep);
+    return;
+  }
   fEventAction->AddEdep4(edepStep);
   
 }
@@ -0,0 +1,548 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackKiller.cc
+/// \brief Implementation of the B1TrackKiller class
+
+#include "B1TrackKiller.hh"
+#include "B1TrackKillerMessenger.hh"
+#include "B1WorkerFile.hh"
+#include "B1DetectorConstruction.hh"
+#include "B1Analysis.hh"
+
+#include "G4RunManager.hh"
+#include "G4AccumulableManager.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Tubs.hh"
+#include "G4AffineTransform.hh"
+#include "G4Material.hh"
+#include "G4Electron.hh"
+#include "G4Gamma.hh"
+#include "G4Track.hh"
+#include "G4Step.hh"
+#include "G4EmCalculator.hh"
+#include "G4Threading.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+  // electron range table, log-spaced
+  const G4double kRangeEMin = 1.*keV;
+  const G4int kBinsPerDecade = 20;
+  const G4int kNofDecades = 5;
+
+  // added around the bounding cylinder of the scoring volumes
+  const G4double kCylinderMargin = 1.*mm;
+  // non-scoring matter denser than this may scatter photons back
+  const G4double kMaxOtherDensity = 0.01*g/cm3;
+}
+
+G4ThreadLocal B1TrackKiller* B1TrackKiller::fInstance = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKiller* B1TrackKiller::Instance()
+{
+  if (!fInstance) fInstance = new B1TrackKiller();
+  return fInstance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKiller::B1TrackKiller()
+: fKillElectrons(false),
+  fPhotonCut(0.),
+  fEscapingPhotons(false),
+  fValidate(false),
+  fScoringVolumes(),
+  fScoringBoxes(),
+  fRangeMaterial(0),
+  fRanges(),
+  fCylinderX(0.), fCylinderY(0.), fCylinderRadius(0.),
+  fCylinderZMin(0.), fCylinderZMax(0.),
+  fTagged(),
+  fTaggedEdep1(0.),
+  fH1(-1),
+  fNofElectrons(0.),
+  fElectronEnergy(0.),
+  fNofKilledElectrons(0.),
+  fKilledElectronEnergy(0.),
+  fNofKilledPhotons(0.),
+  fKilledPhotonEnergy(0.),
+  fNofEscaping(0.),
+  fEscapingEnergy(0.),
+  fNofChangedEvents(0.),
+  fTaggedEdep1Sum(0.),
+  fMessenger(0)
+{
+  fMessenger = new B1TrackKillerMessenger(this);
+
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fNofElectrons);
+  accumulableManager->RegisterAccumulable(fElectronEnergy);
+  accumulableManager->RegisterAccumulable(fNofKilledElectrons);
+  accumulableManager->RegisterAccumulable(fKilledElectronEnergy);
+  accumulableManager->RegisterAccumulable(fNofKilledPhotons);
+  accumulableManager->RegisterAccumulable(fKilledPhotonEnergy);
+  accumulableManager->RegisterAccumulable(fNofEscaping);
+  accumulableManager->RegisterAccumulable(fEscapingEnergy);
+  accumulableManager->RegisterAccumulable(fNofChangedEvents);
+  accumulableManager->RegisterAccumulable(fTaggedEdep1Sum);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKiller::~B1TrackKiller()
+{
+  delete fMessenger;
+  fInstance = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::BeginOfRun()
+{
+  if (IsValidating() && fH1 < 0) {
+    G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+    fH1 = analysisManager->CreateH1("Edep1_terminated",
+            "Energy deposited in Ge detector with escaping photons killed",
+            20001, -0.0005*MeV, 20.0005*MeV);
+  }
+
+  // the master of workers only prints the merged counters
+  if (!IsActive() || B1WorkerFile::IsMasterOfWorkers()) return;
+
+  const B1DetectorConstruction* detectorConstruction
+   = static_cast<const B1DetectorConstruction*>
+     (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  fScoringVolumes.clear();
+  fScoringVolumes.push_back(detectorConstruction->GetScoringVolume());
+  fScoringVolumes.push_back(detectorConstruction->GetScoringVolume1());
+  fScoringVolumes.push_back(detectorConstruction->GetScoringVolume2());
+
+  fScoringBoxes.clear();
+  const G4LogicalVolume* world
+    = G4LogicalVolumeStore::GetInstance()->GetVolume("World");
+  if (world) FindScoringBoxes(world, G4AffineTransform());
+
+  BuildRangeTable();
+  BuildBoundingCylinder();
+
+  if (G4Threading::G4GetThreadId() > 0) return;
+  if (fKillElectrons) {
+    G4cout << "Electron range rejection with the ranges in "
+           << (fRangeMaterial ? fRangeMaterial->GetName() : G4String("none"))
+           << " and " << fScoringBoxes.size() << " scoring volume boxes"
+           << G4endl;
+  }
+  if (fEscapingPhotons) {
+    G4cout << "Photons killed when missing the cylinder of radius "
+           << G4BestUnit(fCylinderRadius,"Length") << " around ("
+           << G4BestUnit(fCylinderX,"Length") << ", "
+           << G4BestUnit(fCylinderY,"Length") << "), z from "
+           << G4BestUnit(fCylinderZMin,"Length") << " to "
+           << G4BestUnit(fCylinderZMax,"Length")
+           << (fValidate ? " (validation only)" : "") << G4endl;
+    CheckOtherMaterials();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::BeginOfEvent()
+{
+  fTagged.clear();
+  fTaggedEdep1 = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1TrackKiller::IsScoring(const G4LogicalVolume* volume) const
+{
+  return std::find(fScoringVolumes.begin(), fScoringVolumes.end(), volume)
+         != fScoringVolumes.end();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1TrackKiller::ContainsScoring(const G4LogicalVolume* volume) const
+{
+  if (IsScoring(volume)) return true;
+  for (size_t i = 0; i < volume->GetNoDaughters(); ++i) {
+    if (ContainsScoring(volume->GetDaughter(i)->GetLogicalVolume()))
+      return true;
+  }
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::FindScoringBoxes(const G4LogicalVolume* volume,
+                                     const G4AffineTransform& toWorld)
+{
+  for (size_t i = 0; i < volume->GetNoDaughters(); ++i) {
+    const G4VPhysicalVolume* daughter = volume->GetDaughter(i);
+    const G4LogicalVolume* daughterLV = daughter->GetLogicalVolume();
+
+    // replicas and parameterised copies may lie anywhere in the mother
+    if (daughter->IsReplicated() || daughter->IsParameterised()) {
+      if (ContainsScoring(daughterLV)) AddBox(volume->GetSolid(), toWorld);
+      continue;
+    }
+
+    G4AffineTransform daughterToWorld
+      = G4AffineTransform(daughter->GetRotation(), daughter->GetTranslation())
+        * toWorld;
+    if (IsScoring(daughterLV)) {
+      AddBox(daughterLV->GetSolid(), daughterToWorld);
+    }
+    else {
+      FindScoringBoxes(daughterLV, daughterToWorld);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::AddBox(const G4VSolid* solid,
+                           const G4AffineTransform& toWorld)
+{
+  G4ThreeVector min, max;
+  solid->BoundingLimits(min, max);
+
+  // world-frame box around the eight corners
+  Box box = { G4ThreeVector(DBL_MAX, DBL_MAX, DBL_MAX),
+              G4ThreeVector(-DBL_MAX, -DBL_MAX, -DBL_MAX),
+              G4ThreeVector(), 0. };
+  for (G4int corner = 0; corner < 8; ++corner) {
+    G4ThreeVector point((corner & 1) ? max.x() : min.x(),
+                        (corner & 2) ? max.y() : min.y(),
+                        (corner & 4) ? max.z() : min.z());
+    point = toWorld.TransformPoint(point);
+    box.min.set(std::min(box.min.x(), point.x()),
+                std::min(box.min.y(), point.y()),
+                std::min(box.min.z(), point.z()));
+    box.max.set(std::max(box.max.x(), point.x()),
+                std::max(box.max.y(), point.y()),
+                std::max(box.max.z(), point.z()));
+  }
+
+  // a tube along z reaches its radius from its axis, other solids the
+  // corners of their box
+  box.centre = 0.5*(box.min + box.max);
+  const G4Tubs* tube = dynamic_cast<const G4Tubs*>(solid);
+  G4ThreeVector axis = toWorld.TransformAxis(G4ThreeVector(0., 0., 1.));
+  if (tube && std::abs(std::abs(axis.z()) - 1.) < 1.e-9) {
+    box.centre = toWorld.TransformPoint(G4ThreeVector());
+    box.radius = tube->GetOuterRadius();
+  }
+  else {
+    box.radius = 0.5*std::hypot(box.max.x() - box.min.x(),
+                                box.max.y() - box.min.y());
+  }
+  fScoringBoxes.push_back(box);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::BuildBoundingCylinder()
+{
+  if (fScoringBoxes.empty()) return;
+
+  G4ThreeVector min = fScoringBoxes[0].min, max = fScoringBoxes[0].max;
+  for (const Box& box : fScoringBoxes) {
+    min.set(std::min(min.x(), box.min.x()), std::min(min.y(), box.min.y()),
+            std::min(min.z(), box.min.z()));
+    max.set(std::max(max.x(), box.max.x()), std::max(max.y(), box.max.y()),
+            std::max(max.z(), box.max.z()));
+  }
+  fCylinderX = 0.5*(min.x() + max.x());
+  fCylinderY = 0.5*(min.y() + max.y());
+  fCylinderRadius = 0.;
+  for (const Box& box : fScoringBoxes) {
+    G4double offset = std::hypot(box.centre.x() - fCylinderX,
+                                 box.centre.y() - fCylinderY);
+    fCylinderRadius = std::max(fCylinderRadius, offset + box.radius);
+  }
+  fCylinderRadius += kCylinderMargin;
+  fCylinderZMin = min.z() - kCylinderMargin;
+  fCylinderZMax = max.z() + kCylinderMargin;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::CheckOtherMaterials() const
+{
+  for (const G4LogicalVolume* volume : *G4LogicalVolumeStore::GetInstance()) {
+    if (IsScoring(volume) || !volume->GetMaterial()) continue;
+    if (volume->GetMaterial()->GetDensity() <= kMaxOtherDensity) continue;
+    G4ExceptionDescription msg;
+    msg << "Volume " << volume->GetName() << " of "
+        << volume->GetMaterial()->GetName() << " may scatter photons back"
+        << " to the detector: killing escaping photons is biased,"
+        << " check with /B1/kill/validate.";
+    G4Exception("B1TrackKiller::CheckOtherMaterials()",
+                "MyCode0014", JustWarning, msg);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1TrackKiller::CanReachScoring(const G4ThreeVector& point,
+                                      const G4ThreeVector& direction) const
+{
+  // parameter interval [tMin, tMax] of the line inside the z slab ...
+  G4double tMin = 0., tMax = DBL_MAX;
+  if (direction.z() != 0.) {
+    G4double t1 = (fCylinderZMin - point.z())/direction.z();
+    G4double t2 = (fCylinderZMax - point.z())/direction.z();
+    tMin = std::max(tMin, std::min(t1, t2));
+    tMax = std::min(tMax, std::max(t1, t2));
+  }
+  else if (point.z() < fCylinderZMin || point.z() > fCylinderZMax) {
+    return false;
+  }
+
+  // ... and inside the infinite cylinder
+  G4double x = point.x() - fCylinderX, y = point.y() - fCylinderY;
+  G4double a = direction.x()*direction.x() + direction.y()*direction.y();
+  G4double b = x*direction.x() + y*direction.y();
+  G4double c = x*x + y*y - fCylinderRadius*fCylinderRadius;
+  if (a > 0.) {
+    G4double discriminant = b*b - a*c;
+    if (discriminant < 0.) return false;
+    G4double root = std::sqrt(discriminant);
+    tMin = std::max(tMin, (-b - root)/a);
+    tMax = std::min(tMax, (-b + root)/a);
+  }
+  else if (c > 0.) {
+    return false;
+  }
+  return tMin <= tMax;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1TrackKiller::TerminatePhoton(const G4Track* track,
+                                      const G4ThreeVector& point,
+                                      const G4ThreeVector& direction)
+{
+  if (fScoringBoxes.empty() || CanReachScoring(point, direction)) return false;
+
+  fNofEscaping += 1.;
+  fEscapingEnergy += track->GetKineticEnergy();
+  if (!fValidate) return true;
+  fTagged.insert(track->GetTrackID());
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::BuildRangeTable()
+{
+  // an electron crossing other materials only stops sooner
+  fRangeMaterial = 0;
+  for (const G4LogicalVolume* volume : *G4LogicalVolumeStore::GetInstance()) {
+    if (IsScoring(volume) || !volume->GetMaterial()) continue;
+    if (!fRangeMaterial
+        || volume->GetMaterial()->GetDensity() < fRangeMaterial->GetDensity()) {
+      fRangeMaterial = volume->GetMaterial();
+    }
+  }
+
+  fRanges.clear();
+  if (!fRangeMaterial) return;
+
+  G4EmCalculator calculator;
+  const G4ParticleDefinition* electron = G4Electron::Definition();
+  for (G4int i = 0; i <= kBinsPerDecade*kNofDecades; ++i) {
+    G4double energy = kRangeEMin*std::pow(10., G4double(i)/kBinsPerDecade);
+    fRanges.push_back(
+      calculator.GetRangeFromRestricteDEDX(energy, electron, fRangeMaterial));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1TrackKiller::GetMaxRange(G4double energy) const
+{
+  // the range grows with energy: take the upper edge of the bin
+  G4double bin = std::log10(energy/kRangeEMin)*kBinsPerDecade;
+  G4int i = std::max(G4int(std::ceil(bin)), 0);
+  if (i >= G4int(fRanges.size())) return DBL_MAX;
+  return fRanges[i];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1TrackKiller::GetDistanceToScoring(const G4ThreeVector& point) const
+{
+  G4double distance2 = DBL_MAX;
+  for (const Box& box : fScoringBoxes) {
+    G4double dx = std::max(std::max(box.min.x() - point.x(), 0.),
+                           point.x() - box.max.x());
+    G4double dy = std::max(std::max(box.min.y() - point.y(), 0.),
+                           point.y() - box.max.y());
+    G4double dz = std::max(std::max(box.min.z() - point.z(), 0.),
+                           point.z() - box.max.z());
+    distance2 = std::min(distance2, dx*dx + dy*dy + dz*dz);
+  }
+  return std::sqrt(distance2);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1TrackKiller::KillNewTrack(const G4Track* track)
+{
+  const G4ParticleDefinition* particle = track->GetDefinition();
+  G4double energy = track->GetKineticEnergy();
+
+  // descendants of tagged tracks are tagged too
+  if (IsValidating() && fTagged.count(track->GetParentID())) {
+    fTagged.insert(track->GetTrackID());
+    return false;
+  }
+  if (fEscapingPhotons && particle == G4Gamma::Definition()
+      && TerminatePhoton(track, track->GetPosition(),
+                         track->GetMomentumDirection())) {
+    return true;
+  }
+
+  if (track->GetParentID() == 0) return false;
+  const G4VPhysicalVolume* volume = track->GetVolume();
+  if (!volume || IsScoring(volume->GetLogicalVolume())) return false;
+
+  if (particle == G4Electron::Definition()) {
+    fNofElectrons += 1.;
+    fElectronEnergy += energy;
+    if (!fKillElectrons || fRanges.empty()) return false;
+    if (GetMaxRange(energy) >= GetDistanceToScoring(track->GetPosition()))
+      return false;
+    fNofKilledElectrons += 1.;
+    fKilledElectronEnergy += energy;
+    return true;
+  }
+
+  if (particle == G4Gamma::Definition() && energy < fPhotonCut) {
+    fNofKilledPhotons += 1.;
+    fKilledPhotonEnergy += energy;
+    return true;
+  }
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::ProcessStep(const G4Step* step)
+{
+  G4Track* track = step->GetTrack();
+  if (track->GetDefinition() != G4Gamma::Definition()
+      || track->GetTrackStatus() != fAlive) return;
+  if (IsValidating() && fTagged.count(track->GetTrackID())) return;
+
+  const G4StepPoint* postStep = step->GetPostStepPoint();
+  if (TerminatePhoton(track, postStep->GetPosition(),
+                      postStep->GetMomentumDirection())) {
+    track->SetTrackStatus(fStopAndKill);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::AddEdep1(const G4Track* track, G4double edep)
+{
+  if (fTagged.count(track->GetTrackID())) fTaggedEdep1 += edep;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::EndOfEvent(G4double edep1)
+{
+  if (fTaggedEdep1 > 0.) {
+    fNofChangedEvents += 1.;
+    fTaggedEdep1Sum += fTaggedEdep1;
+  }
+  G4double kept = edep1 - fTaggedEdep1;
+  if (kept > 0.) G4AnalysisManager::Instance()->FillH1(fH1, kept);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::Print() const
+{
+  if (!IsActive()) return;
+
+  G4double electrons = fNofElectrons.GetValue();
+  G4double electronEnergy = fElectronEnergy.GetValue();
+  G4cout
+     << " Secondaries killed outside the scoring volumes"
+     << G4endl
+     << "  electrons: " << fNofKilledElectrons.GetValue()
+     << " of " << electrons << " ("
+     << (electrons > 0. ? 100.*fNofKilledElectrons.GetValue()/electrons : 0.)
+     << " %), energy " << G4BestUnit(fKilledElectronEnergy.GetValue(),"Energy")
+     << " of " << G4BestUnit(electronEnergy,"Energy") << " ("
+     << (electronEnergy > 0.
+         ? 100.*fKilledElectronEnergy.GetValue()/electronEnergy : 0.)
+     << " %)"
+     << G4endl;
+  if (fPhotonCut > 0.) {
+    G4cout
+     << "  photons below " << G4BestUnit(fPhotonCut,"Energy") << ": "
+     << fNofKilledPhotons.GetValue() << ", energy "
+     << G4BestUnit(fKilledPhotonEnergy.GetValue(),"Energy")
+     << G4endl;
+  }
+  if (fEscapingPhotons) {
+    G4cout
+     << "  photons heading away from the scoring volumes"
+     << (fValidate ? " (tagged, not killed): " : ": ")
+     << fNofEscaping.GetValue() << ", energy "
+     << G4BestUnit(fEscapingEnergy.GetValue(),"Energy")
+     << G4endl;
+  }
+  if (IsValidating()) {
+    G4cout
+     << "  events whose Ge deposit killing would change: "
+     << fNofChangedEvents.GetValue() << ", Ge energy lost "
+     << G4BestUnit(fTaggedEdep1Sum.GetValue(),"Energy")
+     << "; compare Edep1_terminated with Edep1"
+     << G4endl;
+  }
+  G4cout
+     << "------------------------------------------------------------"
+     << G4endl
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
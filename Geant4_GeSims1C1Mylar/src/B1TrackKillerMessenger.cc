@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackKillerMessenger.cc
+/// \brief Implementation of the B1TrackKillerMessenger class
+
+#include "B1TrackKillerMessenger.hh"
+#include "B1TrackKiller.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKillerMessenger::B1TrackKillerMessenger(B1TrackKiller* killer)
+: G4UImessenger(),
+  fKiller(killer)
+{
+  fKillDir = new G4UIdirectory("/B1/kill/");
+  fKillDir->SetGuidance("Killing of tracks that cannot reach the scores");
+
+  fElectronsCmd = new G4UIcmdWithABool("/B1/kill/electrons",this);
+  fElectronsCmd->SetGuidance("Kill secondary electrons whose range is");
+  fElectronsCmd->SetGuidance("shorter than the distance to the scoring");
+  fElectronsCmd->SetGuidance("volumes.");
+  fElectronsCmd->SetParameterName("kill",true);
+  fElectronsCmd->SetDefaultValue(true);
+  fElectronsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPhotonCutCmd = new G4UIcmdWithADoubleAndUnit("/B1/kill/photonCut",this);
+  fPhotonCutCmd->SetGuidance("Kill secondary photons below this energy");
+  fPhotonCutCmd->SetGuidance("outside the scoring volumes (0: never).");
+  fPhotonCutCmd->SetParameterName("photonCut",false);
+  fPhotonCutCmd->SetRange("photonCut>=0.");
+  fPhotonCutCmd->SetUnitCategory("Energy");
+  fPhotonCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fEscapingCmd = new G4UIcmdWithABool("/B1/kill/escapingPhotons",this);
+  fEscapingCmd->SetGuidance("Kill photons, primaries included, whose");
+  fEscapingCmd->SetGuidance("straight line misses the cylinder around the");
+  fEscapingCmd->SetGuidance("scoring volumes.");
+  fEscapingCmd->SetParameterName("kill",true);
+  fEscapingCmd->SetDefaultValue(true);
+  fEscapingCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fValidateCmd = new G4UIcmdWithABool("/B1/kill/validate",this);
+  fValidateCmd->SetGuidance("Tag the escaping photons instead of killing");
+  fValidateCmd->SetGuidance("them and fill Edep1_terminated without them.");
+  fValidateCmd->SetParameterName("validate",true);
+  fValidateCmd->SetDefaultValue(true);
+  fValidateCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKillerMessenger::~B1TrackKillerMessenger()
+{
+  delete fElectronsCmd;
+  delete fPhotonCutCmd;
+  delete fEscapingCmd;
+  delete fValidateCmd;
+  delete fKillDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKillerMessenger::SetNewValue(G4UIcommand* command,
+                                         G4String newValue)
+{
+  if (command == fElectronsCmd) {
+    fKiller->SetKillElectrons(fElectronsCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fPhotonCutCmd) {
+    fKiller->SetPhotonCut(fPhotonCutCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fEscapingCmd) {
+    fKiller->SetKillEscapingPhotons(fEscapingCmd->GetNewBoolValue(newValue));
+  }
+  else if (command == fValidateCmd) {
+    fKiller->SetValidate(fValidateCmd->GetNewBoolValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,157 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1WorkerFile.cc
+/// \brief Implementation of the B1WorkerFile class
+
+#include "B1WorkerFile.hh"
+
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+namespace {
+  // bytes copied at once when merging
+  const size_t kChunkSize = 1 << 20;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1WorkerFile::B1WorkerFile(const G4String& kind, const G4String& extension,
+                           const G4String& code)
+: fKind(kind),
+  fExtension(extension),
+  fCode(code),
+  fFile()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1WorkerFile::~B1WorkerFile()
+{
+  if (fFile.is_open()) fFile.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1WorkerFile::IsMasterOfWorkers()
+{
+  return G4RunManager::GetRunManager()->GetRunManagerType()
+         == G4RunManager::masterRM;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1WorkerFile::OpenFile(const G4String& name)
+{
+  G4String fileName = G4Threading::IsWorkerThread()
+                    ? GetThreadFileName(name, G4Threading::G4GetThreadId())
+                    : name + fExtension;
+  fFile.open(fileName, std::ios::binary | std::ios::trunc);
+  if (!fFile) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open " << fKind << " file " << fileName
+        << ", recording disabled.";
+    G4Exception("B1WorkerFile::OpenFile()", fCode.c_str(), JustWarning, msg);
+    return false;
+  }
+  WriteHeader(fFile, 0, 0);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1WorkerFile::WriteToFile(const void* data, size_t size)
+{
+  fFile.write(static_cast<const char*>(data), size);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1WorkerFile::CloseFile(uint64_t nofEntries, uint64_t nofHistories)
+{
+  fFile.seekp(0);
+  WriteHeader(fFile, nofEntries, nofHistories);
+  fFile.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1WorkerFile::MergeFiles(const G4String& name, uint64_t& nofEntries,
+                              uint64_t& nofHistories) const
+{
+  std::ofstream out(name + fExtension, std::ios::binary | std::ios::trunc);
+  WriteHeader(out, 0, 0);
+
+  nofEntries = 0;
+  nofHistories = 0;
+  std::vector<char> chunk(kChunkSize);
+
+  G4int nofThreads = G4RunManager::GetRunManager()->GetNumberOfThreads();
+  for (G4int i = 0; i < nofThreads; ++i) {
+    G4String partName = GetThreadFileName(name, i);
+    std::ifstream in(partName, std::ios::binary);
+    if (!in) continue;
+
+    uint64_t partEntries = 0;
+    uint64_t partHistories = 0;
+    if (!ReadHeader(in, partEntries, partHistories)) {
+      G4ExceptionDescription msg;
+      msg << "Bad " << fKind << " file " << partName << ", skipped.";
+      G4Exception("B1WorkerFile::MergeFiles()", fCode.c_str(), JustWarning,
+                  msg);
+      continue;
+    }
+    while (in) {
+      in.read(&chunk[0], chunk.size());
+      out.write(&chunk[0], in.gcount());
+    }
+    in.close();
+    std::remove(partName.c_str());
+
+    nofEntries += partEntries;
+    nofHistories += partHistories;
+  }
+
+  out.seekp(0);
+  WriteHeader(out, nofEntries, nofHistories);
+  out.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1WorkerFile::GetThreadFileName(const G4String& name,
+                                         G4int threadID) const
+{
+  std::ostringstream fileName;
+  fileName << name << "_t" << threadID << fExtension;
+  return fileName.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
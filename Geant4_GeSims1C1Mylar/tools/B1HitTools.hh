@@ -0,0 +1,124 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HitTools.hh
+/// \brief Helpers shared by the stand-alone hit file tools
+
+#ifndef B1HitTools_h
+#define B1HitTools_h 1
+
+#include "B1HitFile.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// Surfaces of the crystal from which the depth of a deposit is measured.
+
+struct B1CrystalSurfaces
+{
+  bool front = true;
+  bool back = false;
+  bool side = true;
+
+  // parses a comma-separated subset of front,back,side
+  bool Parse(const std::string& list)
+  {
+    front = back = side = false;
+    std::istringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+      if (item == "front") front = true;
+      else if (item == "back") back = true;
+      else if (item == "side") side = true;
+      else if (!item.empty()) return false;
+    }
+    return true;
+  }
+
+  // distance of a hit below the nearest selected surface, in mm
+  double Depth(const B1HitRecord& hit, double radius, double halfZ) const
+  {
+    double depth = HUGE_VAL;
+    if (front) depth = std::min(depth, halfZ - hit.z);
+    if (back) depth = std::min(depth, halfZ + hit.z);
+    if (side)
+      depth = std::min(depth, radius - std::sqrt(hit.x*hit.x + hit.y*hit.y));
+    return depth;
+  }
+};
+
+/// Opens a hit file and reads its header; prints why and returns false
+/// if it is not a valid hit file.
+
+inline bool B1OpenHitFile(const std::string& fileName, std::ifstream& in,
+                          B1HitFileHeader& header, const char* tool)
+{
+  in.open(fileName, std::ios::binary);
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!in || std::memcmp(header.magic, kB1HitFileMagic, 8) != 0
+      || header.recordSize != sizeof(B1HitRecord)) {
+    std::cerr << tool << ": " << fileName
+              << " is not a hit file, skipped" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/// Reads the next event block into hits; false at end of file.
+
+inline bool B1ReadHitEvent(std::ifstream& in, B1HitEventHeader& event,
+                           std::vector<B1HitRecord>& hits)
+{
+  in.read(reinterpret_cast<char*>(&event), sizeof(event));
+  if (!in) return false;
+  hits.resize(event.nofHits);
+  if (event.nofHits > 0) {
+    in.read(reinterpret_cast<char*>(&hits[0]),
+            event.nofHits*sizeof(B1HitRecord));
+  }
+  return bool(in);
+}
+
+/// End of the hits of the crystal of first, the hits of an event being
+/// grouped by crystal.
+
+inline const B1HitRecord* B1CrystalEnd(const B1HitRecord* first,
+                                       const B1HitRecord* end)
+{
+  const B1HitRecord* hit = first;
+  while (hit != end && hit->copyNo == first->copyNo) ++hit;
+  return hit;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,229 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file deadLayerScan.cc
+/// \brief Re-scores a Ge hit file for a list of dead-layer thicknesses
+///
+/// Usage:
+///   deadLayerScan [options] file.hits [file.hits ...]
+///
+///   -t t1,t2,...     dead-layer thicknesses in mm (default 0)
+///   -r min:max:step  thickness range in mm, instead of -t
+///   -s surfaces      comma-separated subset of front,back,side
+///                    (default front,side)
+///   -b width         spectrum bin width in keV (default 1)
+///   -e emax          spectrum upper edge in keV (default 3000)
+///   -p energy        report the full-energy-peak efficiency of a line
+///                    in keV for every thickness; may be repeated
+///   -o file          write the spectra as a text table, one column per
+///                    thickness (default: no spectra written)
+///
+/// The dead layer is taken as fully inactive: a deposit counts only if
+/// its depth below the nearest selected surface is at least the
+/// thickness. With a crystal array, each crystal hit in an event gives
+/// an entry of its own, the spectra being the sums of the crystal ones.
+/// The files are those written with /B1/hits/record true. No Geant4 is
+/// needed.
+
+#include "B1HitTools.hh"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+struct Options
+{
+  std::vector<double> thicknesses;
+  B1CrystalSurfaces surfaces;
+  double binWidth = 1.;   // keV
+  double emax = 3000.;    // keV
+  std::vector<double> peaks;
+  std::string output;
+  std::vector<std::string> files;
+};
+
+void Usage()
+{
+  std::cerr << "usage: deadLayerScan [-t t1,t2,...|-r min:max:step]"
+            << " [-s front,back,side] [-b keV] [-e keV] [-p keV]..."
+            << " [-o spectra.dat] file.hits..." << std::endl;
+}
+
+std::vector<std::string> Split(const std::string& text, char separator)
+{
+  std::vector<std::string> items;
+  std::istringstream in(text);
+  std::string item;
+  while (std::getline(in, item, separator)) {
+    if (!item.empty()) items.push_back(item);
+  }
+  return items;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg.size() == 2 && arg[0] == '-') {
+      if (i+1 >= argc) return false;
+      std::string value = argv[++i];
+      switch (arg[1]) {
+        case 't':
+          options.thicknesses.clear();
+          for (const std::string& item : Split(value, ','))
+            options.thicknesses.push_back(std::atof(item.c_str()));
+          break;
+        case 'r': {
+          std::vector<std::string> range = Split(value, ':');
+          if (range.size() != 3) return false;
+          double min = std::atof(range[0].c_str());
+          double max = std::atof(range[1].c_str());
+          double step = std::atof(range[2].c_str());
+          if (step <= 0.) return false;
+          options.thicknesses.clear();
+          for (int k = 0; min + k*step <= max + 1e-9*step; ++k)
+            options.thicknesses.push_back(min + k*step);
+          break;
+        }
+        case 's':
+          if (!options.surfaces.Parse(value)) return false;
+          break;
+        case 'b': options.binWidth = std::atof(value.c_str()); break;
+        case 'e': options.emax = std::atof(value.c_str()); break;
+        case 'p': options.peaks.push_back(std::atof(value.c_str())); break;
+        case 'o': options.output = value; break;
+        default: return false;
+      }
+    }
+    else {
+      options.files.push_back(arg);
+    }
+  }
+  if (options.thicknesses.empty()) options.thicknesses.push_back(0.);
+  return !options.files.empty() && options.binWidth > 0. && options.emax > 0.;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    Usage();
+    return 1;
+  }
+  const size_t nofThicknesses = options.thicknesses.size();
+  const size_t nofBins = size_t(std::ceil(options.emax/options.binWidth));
+
+  // one spectrum per thickness, in counts per bin
+  std::vector<std::vector<double> >
+    spectra(nofThicknesses, std::vector<double>(nofBins, 0.));
+  std::vector<double> live(nofThicknesses);
+  std::vector<B1HitRecord> hits;
+  uint64_t nofHistories = 0;
+
+  for (const std::string& fileName : options.files) {
+    std::ifstream in;
+    B1HitFileHeader header;
+    if (!B1OpenHitFile(fileName, in, header, "deadLayerScan")) continue;
+    nofHistories += header.nofHistories;
+
+    B1HitEventHeader event;
+    for (uint64_t n = 0; n < header.nofEvents; ++n) {
+      if (!B1ReadHitEvent(in, event, hits)) {
+        std::cerr << "deadLayerScan: " << fileName
+                  << " is truncated after " << n << " events" << std::endl;
+        break;
+      }
+
+      // energy collected in each crystal for every thickness
+      const B1HitRecord* end = hits.data() + hits.size();
+      for (const B1HitRecord* first = hits.data(); first != end; ) {
+        const B1HitRecord* last = B1CrystalEnd(first, end);
+        std::fill(live.begin(), live.end(), 0.);
+        for (const B1HitRecord* hit = first; hit != last; ++hit) {
+          double depth
+            = options.surfaces.Depth(*hit, header.radius, header.halfZ);
+          for (size_t k = 0; k < nofThicknesses; ++k) {
+            if (depth >= options.thicknesses[k]) live[k] += hit->edep;
+          }
+        }
+        first = last;
+
+        for (size_t k = 0; k < nofThicknesses; ++k) {
+          if (live[k] <= 0.) continue;
+          size_t bin = size_t(live[k]*1000./options.binWidth);
+          if (bin < nofBins) spectra[k][bin] += 1.;
+        }
+      }
+    }
+  }
+
+  if (nofHistories == 0) {
+    std::cerr << "deadLayerScan: no events read" << std::endl;
+    return 1;
+  }
+
+  // full-energy-peak efficiencies: the bin holding the line
+  if (!options.peaks.empty()) {
+    std::printf("# %llu histories\n# dead layer [mm]",
+                (unsigned long long)nofHistories);
+    for (double peak : options.peaks) std::printf("   FEP %8.2f keV", peak);
+    std::printf("\n");
+    for (size_t k = 0; k < nofThicknesses; ++k) {
+      std::printf("%18.4f", options.thicknesses[k]);
+      for (double peak : options.peaks) {
+        size_t bin = size_t(peak/options.binWidth);
+        double counts = bin < nofBins ? spectra[k][bin] : 0.;
+        double efficiency = counts/nofHistories;
+        std::printf("   %.4e +- %.1e", efficiency,
+                    std::sqrt(counts)/nofHistories);
+      }
+      std::printf("\n");
+    }
+  }
+
+  if (!options.output.empty()) {
+    std::ofstream out(options.output);
+    out << "# deadLayerScan spectra, " << nofHistories << " histories\n"
+        << "# E_low[keV]";
+    for (double thickness : options.thicknesses) out << "  t=" << thickness << "mm";
+    out << "\n";
+    for (size_t bin = 0; bin < nofBins; ++bin) {
+      out << bin*options.binWidth;
+      for (size_t k = 0; k < nofThicknesses; ++k) out << " " << spectra[k][bin];
+      out << "\n";
+    }
+    std::cout << "Spectra written to " << options.output << std::endl;
+  }
+
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,412 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file hitDigitizer.cc
+/// \brief Multithreaded replay of Ge hit files through a digitizer
+///
+/// Usage:
+///   hitDigitizer [options] file.hits [file.hits ...]
+///
+///   -j threads       worker threads (default: hardware concurrency)
+///   -T threshold     energy threshold in keV, on the smeared energy
+///                    of the crystal and of each segment (default 0)
+///   -f n,f,c         resolution, FWHM^2 = n^2 + f*E + c^2*E^2 with E and
+///                    FWHM in keV (default 0,0,0: no smearing)
+///   -d dead          dead-layer thickness in mm (default 0)
+///   -w width         width in mm of the transition layer below the dead
+///                    layer, over which the charge collection efficiency
+///                    rises linearly from 0 to 1 (default 0)
+///   -s surfaces      surfaces carrying the dead layer, comma-separated
+///                    subset of front,back,side (default front,side)
+///   -g nphi,nz       segmentation in azimuth and height (default 1,1)
+///   -b width         spectrum bin width in keV (default 1)
+///   -e emax          spectrum upper edge in keV (default 3000)
+///   -S seed          random seed (default 1)
+///   -o file          spectra output as a text table (default digi.dat)
+///
+/// The reader thread cuts the input into chunks of whole events that the
+/// workers digitize into private histograms. Each chunk has its own
+/// random stream seeded from the seed and the chunk number, and the
+/// histograms are summed in thread order, so the output does not depend
+/// on the number of threads. With a crystal array, each crystal hit in
+/// an event is digitized on its own and gives an entry of its own, the
+/// spectra and segment multiplicities being the sums of the crystal
+/// ones. No Geant4 is needed.
+
+#include "B1HitTools.hh"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace {
+
+// events handed to a worker at a time
+const size_t kChunkEvents = 16384;
+
+struct Config
+{
+  unsigned threads = 0;
+  double threshold = 0.;                 // keV
+  double noise = 0., fano = 0., slope = 0.;
+  double dead = 0.;                      // mm
+  double transition = 0.;                // mm
+  B1CrystalSurfaces surfaces;
+  int nofPhi = 1;
+  int nofZ = 1;
+  double binWidth = 1.;                  // keV
+  double emax = 3000.;                   // keV
+  unsigned long seed = 1;
+  std::string output = "digi.dat";
+  std::vector<std::string> files;
+
+  int NofSegments() const { return nofPhi*nofZ; }
+};
+
+struct Chunk
+{
+  uint64_t index;
+  double radius;
+  double halfZ;
+  std::vector<B1HitEventHeader> events;
+  std::vector<B1HitRecord> hits;
+};
+
+/// Per-thread histograms
+struct Result
+{
+  std::vector<double> ideal;       // crystals, summed deposits
+  std::vector<double> digitized;   // crystals, after the digitizer
+  std::vector<std::vector<double> > segments;
+  std::vector<double> multiplicity;
+  uint64_t nofEvents = 0;
+  uint64_t nofCrystalHits = 0;
+
+  Result(const Config& config, size_t nofBins)
+  : ideal(nofBins, 0.), digitized(nofBins, 0.),
+    segments(config.NofSegments(), std::vector<double>(nofBins, 0.)),
+    multiplicity(config.NofSegments()+1, 0.)
+  {}
+
+  void Add(const Result& other)
+  {
+    for (size_t i = 0; i < ideal.size(); ++i) {
+      ideal[i] += other.ideal[i];
+      digitized[i] += other.digitized[i];
+      for (size_t s = 0; s < segments.size(); ++s)
+        segments[s][i] += other.segments[s][i];
+    }
+    for (size_t m = 0; m < multiplicity.size(); ++m)
+      multiplicity[m] += other.multiplicity[m];
+    nofEvents += other.nofEvents;
+    nofCrystalHits += other.nofCrystalHits;
+  }
+};
+
+/// Bounded queue between the reader and the workers
+class ChunkQueue
+{
+  public:
+    explicit ChunkQueue(size_t capacity) : fCapacity(capacity), fClosed(false) {}
+
+    void Push(Chunk&& chunk)
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fNotFull.wait(lock, [this]{ return fChunks.size() < fCapacity; });
+      fChunks.push_back(std::move(chunk));
+      fNotEmpty.notify_one();
+    }
+
+    bool Pop(Chunk& chunk)
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fNotEmpty.wait(lock, [this]{ return !fChunks.empty() || fClosed; });
+      if (fChunks.empty()) return false;
+      chunk = std::move(fChunks.front());
+      fChunks.pop_front();
+      fNotFull.notify_one();
+      return true;
+    }
+
+    void Close()
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fClosed = true;
+      fNotEmpty.notify_all();
+    }
+
+  private:
+    size_t fCapacity;
+    bool fClosed;
+    std::deque<Chunk> fChunks;
+    std::mutex fMutex;
+    std::condition_variable fNotEmpty;
+    std::condition_variable fNotFull;
+};
+
+void Usage()
+{
+  std::cerr << "usage: hitDigitizer [-j threads] [-T keV] [-f n,f,c]"
+            << " [-d mm] [-w mm] [-s front,back,side] [-g nphi,nz]"
+            << " [-b keV] [-e keV] [-S seed] [-o file] file.hits..."
+            << std::endl;
+}
+
+bool ParseOptions(int argc, char** argv, Config& config)
+{
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg.size() == 2 && arg[0] == '-') {
+      if (i+1 >= argc) return false;
+      std::string value = argv[++i];
+      switch (arg[1]) {
+        case 'j': config.threads = std::atoi(value.c_str()); break;
+        case 'T': config.threshold = std::atof(value.c_str()); break;
+        case 'f':
+          if (std::sscanf(value.c_str(), "%lf,%lf,%lf",
+                          &config.noise, &config.fano, &config.slope) != 3)
+            return false;
+          break;
+        case 'd': config.dead = std::atof(value.c_str()); break;
+        case 'w': config.transition = std::atof(value.c_str()); break;
+        case 's':
+          if (!config.surfaces.Parse(value)) return false;
+          break;
+        case 'g':
+          if (std::sscanf(value.c_str(), "%d,%d",
+                          &config.nofPhi, &config.nofZ) != 2)
+            return false;
+          break;
+        case 'b': config.binWidth = std::atof(value.c_str()); break;
+        case 'e': config.emax = std::atof(value.c_str()); break;
+        case 'S': config.seed = std::strtoul(value.c_str(), 0, 10); break;
+        case 'o': config.output = value; break;
+        default: return false;
+      }
+    }
+    else {
+      config.files.push_back(arg);
+    }
+  }
+  if (config.threads == 0) config.threads = std::thread::hardware_concurrency();
+  if (config.threads == 0) config.threads = 1;
+  return !config.files.empty() && config.binWidth > 0. && config.emax > 0.
+         && config.nofPhi > 0 && config.nofZ > 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Digitizes the events of one chunk into result.
+void Digitize(const Config& config, const Chunk& chunk, Result& result)
+{
+  std::seed_seq seeds{ config.seed, (unsigned long)chunk.index };
+  std::mt19937_64 engine(seeds);
+  std::normal_distribution<double> gauss;
+
+  const double twoPi = 2.*std::acos(-1.);
+  const double binsPerKeV = 1./config.binWidth;
+  const size_t nofBins = result.ideal.size();
+  const int nofSegments = config.NofSegments();
+  std::vector<double> segmentEnergy(nofSegments);
+
+  // smeared energy above threshold, or 0
+  auto smear = [&](double energy) {
+    double fwhm2 = config.noise*config.noise + config.fano*energy
+                 + config.slope*config.slope*energy*energy;
+    if (fwhm2 > 0.) energy += gauss(engine)*std::sqrt(fwhm2)/2.3548;
+    return energy > config.threshold ? energy : 0.;
+  };
+  auto fill = [&](std::vector<double>& histogram, double energy) {
+    if (energy <= 0.) return;
+    size_t bin = size_t(energy*binsPerKeV);
+    if (bin < nofBins) histogram[bin] += 1.;
+  };
+
+  const B1HitRecord* first = chunk.hits.data();
+  for (const B1HitEventHeader& event : chunk.events) {
+    // one crystal at a time
+    const B1HitRecord* end = first + event.nofHits;
+    while (first != end) {
+      const B1HitRecord* last = B1CrystalEnd(first, end);
+      double ideal = 0.;
+      double collected = 0.;
+      std::fill(segmentEnergy.begin(), segmentEnergy.end(), 0.);
+
+      for (const B1HitRecord* hit = first; hit != last; ++hit) {
+        double edep = hit->edep*1000.;   // keV
+        ideal += edep;
+
+        // charge collection efficiency from the depth below the surfaces
+        double depth = config.surfaces.Depth(*hit, chunk.radius, chunk.halfZ);
+        double cce = 1.;
+        if (depth < config.dead) cce = 0.;
+        else if (depth < config.dead + config.transition)
+          cce = (depth - config.dead)/config.transition;
+        if (cce <= 0.) continue;
+        collected += cce*edep;
+
+        if (nofSegments > 1) {
+          double phi = std::atan2(hit->y, hit->x);
+          if (phi < 0.) phi += twoPi;
+          int iPhi = std::min(int(phi/twoPi*config.nofPhi), config.nofPhi-1);
+          int iZ = int((hit->z + chunk.halfZ)/(2.*chunk.halfZ)*config.nofZ);
+          iZ = std::max(0, std::min(iZ, config.nofZ-1));
+          segmentEnergy[iPhi*config.nofZ + iZ] += cce*edep;
+        }
+      }
+
+      fill(result.ideal, ideal);
+      fill(result.digitized, smear(collected));
+
+      if (nofSegments > 1) {
+        int fired = 0;
+        for (int s = 0; s < nofSegments; ++s) {
+          double energy = segmentEnergy[s] > 0. ? smear(segmentEnergy[s]) : 0.;
+          if (energy <= 0.) continue;
+          fill(result.segments[s], energy);
+          ++fired;
+        }
+        result.multiplicity[fired] += 1.;
+      }
+      ++result.nofCrystalHits;
+      first = last;
+    }
+  }
+  result.nofEvents += chunk.events.size();
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  Config config;
+  if (!ParseOptions(argc, argv, config)) {
+    Usage();
+    return 1;
+  }
+  const size_t nofBins = size_t(std::ceil(config.emax/config.binWidth));
+
+  std::vector<Result> results(config.threads, Result(config, nofBins));
+  ChunkQueue queue(2*config.threads);
+
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < config.threads; ++t) {
+    workers.emplace_back([&config, &queue, &results, t]() {
+      Chunk chunk;
+      while (queue.Pop(chunk)) Digitize(config, chunk, results[t]);
+    });
+  }
+
+  // read all files in this thread and hand out chunks of events
+  uint64_t nofHistories = 0;
+  uint64_t chunkIndex = 0;
+  std::vector<B1HitRecord> hits;
+  for (const std::string& fileName : config.files) {
+    std::ifstream in;
+    B1HitFileHeader header;
+    if (!B1OpenHitFile(fileName, in, header, "hitDigitizer")) continue;
+    nofHistories += header.nofHistories;
+
+    Chunk chunk;
+    B1HitEventHeader event;
+    for (uint64_t n = 0; n < header.nofEvents; ++n) {
+      if (!B1ReadHitEvent(in, event, hits)) {
+        std::cerr << "hitDigitizer: " << fileName
+                  << " is truncated after " << n << " events" << std::endl;
+        break;
+      }
+      chunk.events.push_back(event);
+      chunk.hits.insert(chunk.hits.end(), hits.begin(), hits.end());
+      if (chunk.events.size() == kChunkEvents) {
+        chunk.index = chunkIndex++;
+        chunk.radius = header.radius;
+        chunk.halfZ = header.halfZ;
+        queue.Push(std::move(chunk));
+        chunk = Chunk();
+      }
+    }
+    if (!chunk.events.empty()) {
+      chunk.index = chunkIndex++;
+      chunk.radius = header.radius;
+      chunk.halfZ = header.halfZ;
+      queue.Push(std::move(chunk));
+    }
+  }
+  queue.Close();
+  for (std::thread& worker : workers) worker.join();
+
+  // sum in a fixed order
+  Result total(config, nofBins);
+  for (const Result& result : results) total.Add(result);
+
+  if (nofHistories == 0) {
+    std::cerr << "hitDigitizer: no events read" << std::endl;
+    return 1;
+  }
+
+  double counts = 0.;
+  for (double value : total.digitized) counts += value;
+  std::printf("hitDigitizer: %llu histories, %llu events with Ge hits"
+              " (%llu crystals hit), %.0f counts above threshold\n",
+              (unsigned long long)nofHistories,
+              (unsigned long long)total.nofEvents,
+              (unsigned long long)total.nofCrystalHits, counts);
+  if (config.NofSegments() > 1) {
+    std::printf(" segment multiplicity:");
+    for (size_t m = 0; m < total.multiplicity.size(); ++m) {
+      if (total.multiplicity[m] > 0.)
+        std::printf(" %zu:%.0f", m, total.multiplicity[m]);
+    }
+    std::printf("\n");
+  }
+
+  std::ofstream out(config.output);
+  out << "# hitDigitizer spectra, " << nofHistories << " histories\n"
+      << "# E_low[keV] ideal digitized";
+  for (int s = 0; s < int(total.segments.size()) && config.NofSegments() > 1; ++s)
+    out << " seg" << s;
+  out << "\n";
+  for (size_t bin = 0; bin < nofBins; ++bin) {
+    out << bin*config.binWidth << " " << total.ideal[bin]
+        << " " << total.digitized[bin];
+    if (config.NofSegments() > 1) {
+      for (const std::vector<double>& segment : total.segments)
+        out << " " << segment[bin];
+    }
+    out << "\n";
+  }
+  std::cout << "Spectra written to " << config.output << std::endl;
+
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......